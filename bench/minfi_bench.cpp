@@ -1,20 +1,26 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <random>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "minfi/interpolate.hpp"
+#include "minfi/perf_counters.hpp"
+#include "minfi/tuning.hpp"
 
 using clock_type = std::chrono::high_resolution_clock;
 
 static void usage(const char* argv0) {
   std::cout << "minfi_bench — simple interpolation throughput benchmark\n\n";
-  std::cout << "Usage: " << argv0 << " [size] [iters] [t]\n";
+  std::cout << "Usage: " << argv0 << " [size] [iters] [t] [--perf]\n";
   std::cout << "  size : elements per frame (default 1000000)\n";
   std::cout << "  iters: number of iterations (default 10)\n";
   std::cout << "  t    : interpolation factor (default 0.5)\n";
+  std::cout << "  --perf: report hardware counters per iteration (Linux perf_event_open);\n";
+  std::cout << "          runs single-threaded, since counters only see the calling thread\n";
 }
 
 int main(int argc, char** argv) {
@@ -25,9 +31,18 @@ int main(int argc, char** argv) {
     usage(argv[0]);
     return 0;
   }
-  if (argc >= 2) size = static_cast<size_t>(std::stoll(argv[1]));
-  if (argc >= 3) iters = std::stoi(argv[2]);
-  if (argc >= 4) t = std::stof(argv[3]);
+  bool perf = false;
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--perf") {
+      perf = true;
+    } else {
+      args.emplace_back(argv[i]);
+    }
+  }
+  if (args.size() >= 1) size = static_cast<size_t>(std::stoll(args[0]));
+  if (args.size() >= 2) iters = std::stoi(args[1]);
+  if (args.size() >= 3) t = std::stof(args[2]);
 
   std::mt19937 rng(123);
   std::uniform_real_distribution<float> dist(0.0f, 1.0f);
@@ -42,10 +57,35 @@ int main(int argc, char** argv) {
   volatile float sink = warm[0];
   (void) sink;
 
+  // Opened before timing so the syscalls stay out of the measured loop.
+  std::optional<minfi::PerfCounters> counters;
+  if (perf) counters.emplace();
+  minfi::PerfStats perf_stats;
+  // Counters only see this thread, so --perf runs the tuned kernel and tile size serially
+  // instead of letting interpolate() hand tiles to executor helpers.
+  std::optional<minfi::TuningEntry> serial;
+  if (perf) {
+    serial = minfi::active_tuning()->select(size);
+    if (serial->threads > 1) {
+      std::cout << "note: --perf runs serially; the active tuning uses " << serial->threads
+                << " threads for this size\n";
+    }
+    serial->threads = 1;
+  }
+
   auto t0 = clock_type::now();
   size_t checksum = 0;
   for (int i = 0; i < iters; ++i) {
-    auto out = minfi::interpolate(a, b, t);
+    std::optional<minfi::PerfZone> zone;
+    if (counters) zone.emplace(*counters, perf_stats);
+    minfi::Frame out;
+    if (serial) {
+      out.resize(size);
+      minfi::interpolate_tuned_into(std::span<const float>(a), std::span<const float>(b),
+                                    std::span<float>(out), t, *serial);
+    } else {
+      out = minfi::interpolate(a, b, t);
+    }
     // Prevent optimization by summing a few values
     checksum += static_cast<size_t>(out[i % out.size()] * 1000.0f);
   }
@@ -62,5 +102,13 @@ int main(int argc, char** argv) {
   std::cout << "time(s)=" << dt.count() << ", elems/s=" << elems_per_sec << ", approx GB/s=" << gbps
             << "\n";
   std::cout << "checksum=" << checksum << "\n";
+  if (counters) {
+    std::cout << "perf counters per iteration (bytes = read a, b + write out):\n";
+    if (!counters->any_available()) {
+      std::cout << "  no counters available (perf_event_paranoid, container or non-Linux)\n";
+    } else {
+      perf_stats.report(std::cout, static_cast<double>(size), bytes_per_elem * 3 * size);
+    }
+  }
   return 0;
 }
@@ -0,0 +1,215 @@
+// End-to-end per-frame latency: a synthetic source publishes RGB8 frames at a fixed rate and
+// the consumer turns every new pair into an RGBA8 midpoint frame. Latency runs from "pair
+// available" (the newer frame's publish time) to "output ready" and so includes queueing,
+// thread wakeups, allocation and format conversion, not just the kernel.
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minfi/async.hpp"
+#include "minfi/histogram.hpp"
+#include "minfi/interpolate.hpp"
+#include "minfi/packed.hpp"
+
+using clock_type = std::chrono::steady_clock;
+using Image = std::vector<std::uint8_t>;
+
+namespace {
+
+struct Size {
+  std::size_t width;
+  std::size_t height;
+};
+
+struct Published {
+  std::shared_ptr<const Image> frame;
+  clock_type::time_point at;
+};
+
+// Multi-pass path: RGB8 -> float frames -> interpolate -> RGBA8, allocating per frame.
+Image to_rgba_float(const minfi::Frame& f, std::size_t pixels) {
+  Image rgba(pixels * 4);
+  for (std::size_t p = 0; p < pixels; ++p) {
+    for (std::size_t c = 0; c < 3; ++c) {
+      rgba[p * 4 + c] = static_cast<std::uint8_t>(f[p * 3 + c] * 255.0f + 0.5f);
+    }
+    rgba[p * 4 + 3] = 255;
+  }
+  return rgba;
+}
+
+minfi::Frame to_float(const Image& img) {
+  minfi::Frame f(img.size());
+  for (std::size_t i = 0; i < img.size(); ++i) f[i] = img[i] / 255.0f;
+  return f;
+}
+
+void usage(const char* argv0) {
+  std::cout << "minfi_latency_bench — per-frame latency from pair available to output ready\n\n";
+  std::cout << "Usage: " << argv0 << " [--fps F] [--seconds S] [--sizes WxH,...]\n";
+  std::cout << "       [--paths float,async,packed]\n";
+  std::cout << "  defaults: --fps 60 --seconds 3 --sizes 640x360,1280x720,1920x1080\n";
+  std::cout << "  float : convert to float frames, interpolate, convert to RGBA8 (allocating)\n";
+  std::cout << "  async : as float, but interpolating through interpolate_async\n";
+  std::cout << "  packed: fused RGB8 -> RGBA8 kernel into a reused buffer\n";
+}
+
+std::vector<std::string> split(const std::string& s) {
+  std::vector<std::string> out;
+  std::stringstream ss(s);
+  for (std::string item; std::getline(ss, item, ',');) {
+    if (!item.empty()) out.push_back(item);
+  }
+  return out;
+}
+
+minfi::LatencyHistogram run(const Size& size, const std::string& path, double fps,
+                            double seconds) {
+  const std::size_t pixels = size.width * size.height;
+  // A small pool of distinct frames stands in for a decoder.
+  std::vector<std::shared_ptr<const Image>> pool;
+  for (int k = 0; k < 4; ++k) {
+    auto img = std::make_shared<Image>(pixels * 3);
+    for (std::size_t i = 0; i < img->size(); ++i) {
+      (*img)[i] = static_cast<std::uint8_t>((i * 7 + static_cast<std::size_t>(k) * 61) & 0xff);
+    }
+    pool.push_back(std::move(img));
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Published> queue;
+  bool done = false;
+  const auto period = std::chrono::duration_cast<clock_type::duration>(
+      std::chrono::duration<double>(1.0 / fps));
+  const auto frames = static_cast<std::size_t>(fps * seconds) + 1;
+
+  std::thread source([&] {
+    auto next = clock_type::now();
+    for (std::size_t f = 0; f < frames; ++f) {
+      std::this_thread::sleep_until(next);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({pool[f % pool.size()], clock_type::now()});
+      }
+      cv.notify_one();
+      next += period;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+    cv.notify_one();
+  });
+
+  minfi::LatencyHistogram hist;
+  Image reused(pixels * 4);
+  std::shared_ptr<const Image> prev;
+  std::size_t checksum = 0;
+  for (;;) {
+    Published cur;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return !queue.empty() || done; });
+      if (queue.empty()) break;
+      cur = std::move(queue.front());
+      queue.pop_front();
+    }
+    if (prev) {
+      if (path == "packed") {
+        minfi::interpolate_packed_into({prev->data(), size.width, size.height},
+                                       {cur.frame->data(), size.width, size.height},
+                                       {reused.data(), size.width, size.height,
+                                        minfi::PixelFormat::Rgba8},
+                                       0.5f);
+        checksum += reused[0];
+      } else {
+        minfi::Frame out = path == "async"
+                               ? minfi::interpolate_async(to_float(*prev), to_float(*cur.frame),
+                                                          0.5f)
+                                     .get()
+                               : minfi::interpolate(to_float(*prev), to_float(*cur.frame), 0.5f);
+        checksum += to_rgba_float(out, pixels)[0];
+      }
+      const auto latency = clock_type::now() - cur.at;
+      hist.record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+    }
+    prev = cur.frame;
+  }
+  source.join();
+  volatile std::size_t sink = checksum;
+  (void) sink;
+  return hist;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  double fps = 60.0, seconds = 3.0;
+  std::vector<std::string> sizes = {"640x360", "1280x720", "1920x1080"};
+  std::vector<std::string> paths = {"float", "async", "packed"};
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    const std::string value = argv[++i];
+    if (arg == "--fps") fps = std::stod(value);
+    else if (arg == "--seconds") seconds = std::stod(value);
+    else if (arg == "--sizes") sizes = split(value);
+    else if (arg == "--paths") paths = split(value);
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (fps <= 0 || seconds <= 0) {
+    std::cerr << "fps and seconds must be positive\n";
+    return 1;
+  }
+
+  const auto deadline_ns = static_cast<std::uint64_t>(1e9 / fps);
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "fps=" << fps << " deadline(us)=" << deadline_ns / 1e3 << " seconds=" << seconds
+            << "\n";
+  std::cout << std::left << std::setw(11) << "size" << std::setw(8) << "path" << std::right
+            << std::setw(8) << "frames" << std::setw(11) << "p50(us)" << std::setw(11)
+            << "p99(us)" << std::setw(11) << "p99.9(us)" << std::setw(11) << "max(us)"
+            << std::setw(8) << "missed\n";
+  for (const auto& s : sizes) {
+    Size size{};
+    const auto x = s.find('x');
+    if (x == std::string::npos) {
+      std::cerr << "bad size '" << s << "'\n";
+      return 1;
+    }
+    size.width = std::stoul(s.substr(0, x));
+    size.height = std::stoul(s.substr(x + 1));
+    for (const auto& path : paths) {
+      if (path != "float" && path != "async" && path != "packed") {
+        std::cerr << "unknown path '" << path << "'\n";
+        return 1;
+      }
+      const auto h = run(size, path, fps, seconds);
+      std::cout << std::left << std::setw(11) << s << std::setw(8) << path << std::right
+                << std::setw(8) << h.count() << std::setw(11) << h.value_at_percentile(50) / 1e3
+                << std::setw(11) << h.value_at_percentile(99) / 1e3 << std::setw(11)
+                << h.value_at_percentile(99.9) / 1e3 << std::setw(11) << h.max() / 1e3
+                << std::setw(7) << h.count_above(deadline_ns) << "\n";
+    }
+  }
+  return 0;
+}
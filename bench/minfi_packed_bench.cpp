@@ -0,0 +1,88 @@
+// Compares the multi-pass RGB8 -> float -> interpolate -> RGB8 -> RGBA8 pipeline against the
+// fused packed kernel that writes RGBA8 directly.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/packed.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+static void usage(const char* argv0) {
+  std::cout << "minfi_packed_bench — multi-pass vs fused RGB8 -> RGBA8 interpolation\n\n";
+  std::cout << "Usage: " << argv0 << " [width] [height] [iters]\n";
+  std::cout << "  defaults: 1920 1080 50\n";
+}
+
+int main(int argc, char** argv) {
+  size_t width = 1920, height = 1080;
+  int iters = 50;
+  if (argc == 2 && std::string(argv[1]) == "--help") {
+    usage(argv[0]);
+    return 0;
+  }
+  if (argc >= 2) width = static_cast<size_t>(std::stoll(argv[1]));
+  if (argc >= 3) height = static_cast<size_t>(std::stoll(argv[2]));
+  if (argc >= 4) iters = std::stoi(argv[3]);
+
+  const size_t pixels = width * height;
+  std::mt19937 rng(123);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<std::uint8_t> a(pixels * 3), b(pixels * 3);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<std::uint8_t>(dist(rng));
+    b[i] = static_cast<std::uint8_t>(dist(rng));
+  }
+  size_t checksum = 0;
+
+  // Multi-pass: each stage allocates and fills a full-frame buffer.
+  auto t0 = clock_type::now();
+  for (int it = 0; it < iters; ++it) {
+    const float t = static_cast<float>(it % 8 + 1) / 9.0f;
+    minfi::Frame fa(a.size()), fb(b.size());
+    for (size_t i = 0; i < a.size(); ++i) fa[i] = a[i] / 255.0f;
+    for (size_t i = 0; i < b.size(); ++i) fb[i] = b[i] / 255.0f;
+    minfi::Frame fo = minfi::interpolate(fa, fb, t);
+    std::vector<std::uint8_t> rgb(fo.size());
+    for (size_t i = 0; i < fo.size(); ++i) {
+      rgb[i] = static_cast<std::uint8_t>(fo[i] * 255.0f + 0.5f);
+    }
+    std::vector<std::uint8_t> rgba(pixels * 4);
+    for (size_t p = 0; p < pixels; ++p) {
+      rgba[p * 4 + 0] = rgb[p * 3 + 0];
+      rgba[p * 4 + 1] = rgb[p * 3 + 1];
+      rgba[p * 4 + 2] = rgb[p * 3 + 2];
+      rgba[p * 4 + 3] = 255;
+    }
+    checksum += rgba[static_cast<size_t>(it) % rgba.size()];
+  }
+  auto t1 = clock_type::now();
+
+  // Fused: one pass into a reused RGBA8 buffer.
+  std::vector<std::uint8_t> out(pixels * 4);
+  const minfi::PackedImageView va{a.data(), width, height, minfi::PixelFormat::Rgb8};
+  const minfi::PackedImageView vb{b.data(), width, height, minfi::PixelFormat::Rgb8};
+  const minfi::MutablePackedImageView vo{out.data(), width, height, minfi::PixelFormat::Rgba8};
+  for (int it = 0; it < iters; ++it) {
+    const float t = static_cast<float>(it % 8 + 1) / 9.0f;
+    minfi::interpolate_packed_into(va, vb, vo, t);
+    checksum += out[static_cast<size_t>(it) % out.size()];
+  }
+  auto t2 = clock_type::now();
+
+  const std::chrono::duration<double, std::milli> multi = t1 - t0, fused = t2 - t1;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << width << "x" << height << ", iters=" << iters << "\n";
+  std::cout << "multi-pass ms/frame=" << multi.count() / iters
+            << "  (bytes allocated/frame=" << pixels * (3 * 2 * 4 + 3 * 4 + 3 + 4) << ")\n";
+  std::cout << "fused      ms/frame=" << fused.count() / iters
+            << "  (bytes allocated/frame=0)\n";
+  std::cout << "speedup=" << multi.count() / fused.count() << "\n";
+  std::cout << "checksum=" << checksum << "\n";
+  return 0;
+}
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "minfi/cubic.hpp"
+#include "minfi/kernels.hpp"
+#include "minfi/motion.hpp"
+#include "minfi/quality.hpp"
+#include "minfi/shape.hpp"
+#include "minfi/tuning.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+
+void usage(const char* argv0) {
+  std::cout << "minfi_quality_bench — quality vs speed of every interpolation configuration\n\n";
+  std::cout << "Drops every other frame of a ground-truth sequence, reinterpolates it at t = 0.5\n";
+  std::cout << "and reports PSNR / SSIM against the dropped frame next to ms/frame.\n\n";
+  std::cout << "Usage: " << argv0 << " [options]\n";
+  std::cout << "  --input PATH W H C : raw float32 sequence in [0, 1] (default: synthetic pan)\n";
+  std::cout << "  --size W H         : synthetic frame size (default 320 180, RGB)\n";
+  std::cout << "  --frames N         : frames to use (default 25)\n";
+  std::cout << "  --iters N          : timing repetitions (default 3)\n";
+  std::cout << "  --json PATH        : also write the results as JSON ('-' for stdout)\n";
+  std::cout << "  --min-psnr DB      : report the fastest configuration reaching DB\n";
+  std::cout << "  --min-ssim S       : report the fastest configuration reaching S\n";
+}
+
+using Sequence = std::vector<minfi::Frame>;
+
+// Smooth texture panning at a fractional speed with a faster disc on top, so block motion,
+// sub-pixel sampling and occlusion edges all show up in the scores.
+Sequence synthetic(const minfi::FrameShape& shape, std::size_t frames) {
+  Sequence seq(frames, minfi::Frame(shape.elems()));
+  const float cx0 = static_cast<float>(shape.width) * 0.2f;
+  const float cy = static_cast<float>(shape.height) * 0.5f;
+  const float r = static_cast<float>(shape.height) * 0.2f;
+  for (std::size_t f = 0; f < frames; ++f) {
+    const float ff = static_cast<float>(f);
+    const float cx = cx0 + 5.0f * ff;
+    for (std::size_t y = 0; y < shape.height; ++y) {
+      for (std::size_t x = 0; x < shape.width; ++x) {
+        const float u = static_cast<float>(x) - 1.5f * ff;
+        const float v = static_cast<float>(y) - 0.75f * ff;
+        const float dx = static_cast<float>(x) - cx, dy = static_cast<float>(y) - cy;
+        const bool disc = dx * dx + dy * dy < r * r;
+        for (std::size_t c = 0; c < shape.channels; ++c) {
+          const float phase = static_cast<float>(c) * 1.3f;
+          const float bg = 0.5f + 0.25f * std::sin(u * 0.11f + phase) +
+                           0.2f * std::cos(v * 0.07f - phase) * std::sin((u + v) * 0.03f);
+          seq[f][(y * shape.width + x) * shape.channels + c] =
+              disc ? 0.9f - 0.2f * static_cast<float>(c) : bg;
+        }
+      }
+    }
+  }
+  return seq;
+}
+
+Sequence load(const std::string& path, const minfi::FrameShape& shape, std::size_t frames) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) throw std::runtime_error("cannot open " + path);
+  Sequence seq;
+  minfi::Frame frame(shape.elems());
+  while (seq.size() < frames &&
+         in.read(reinterpret_cast<char*>(frame.data()),
+                 static_cast<std::streamsize>(frame.size() * sizeof(float)))) {
+    seq.push_back(frame);
+  }
+  return seq;
+}
+
+// Interpolates the midpoint between seq[i - 1] and seq[i + 1] into `out`.
+using Method = std::function<void(const Sequence& seq, std::size_t i, minfi::Frame& out)>;
+
+struct Config {
+  std::string method;
+  std::string params;
+  Method run;
+};
+
+struct Result {
+  std::string method;
+  std::string params;
+  double ms_per_frame = 0;
+  double psnr = 0;
+  double ssim = 0;
+  bool pareto = false;
+};
+
+std::vector<Config> configs(const minfi::FrameShape& shape) {
+  std::vector<Config> out;
+  for (const auto kernel : {minfi::KernelVariant::Flat, minfi::KernelVariant::Streaming}) {
+    out.push_back({"linear", std::string("kernel=") + minfi::to_string(kernel),
+                   [kernel](const Sequence& seq, std::size_t i, minfi::Frame& f) {
+                     minfi::TuningEntry entry;
+                     entry.kernel = kernel;
+                     minfi::interpolate_tuned_into(seq[i - 1], seq[i + 1], f, 0.5f, entry);
+                   }});
+  }
+  out.push_back({"cubic", "catmull-rom", [](const Sequence& seq, std::size_t i, minfi::Frame& f) {
+                   // Outer neighbours are the surviving (even) frames, clamped at the ends.
+                   const std::size_t p0 = i >= 3 ? i - 3 : i - 1;
+                   const std::size_t p3 = i + 3 < seq.size() ? i + 3 : i + 1;
+                   minfi::interpolate_cubic_into(seq[p0], seq[i - 1], seq[i + 1], seq[p3], f,
+                                                 0.5f);
+                 }});
+  for (const std::size_t block : {std::size_t{8}, std::size_t{16}}) {
+    for (const int search : {4, 8, 16}) {
+      for (const auto sampling : {minfi::MotionSampling::Block, minfi::MotionSampling::Smooth}) {
+        const minfi::MotionOptions options{block, search};
+        const std::string params = "block=" + std::to_string(block) +
+                                   " search=" + std::to_string(search) + " sampling=" +
+                                   (sampling == minfi::MotionSampling::Block ? "block" : "smooth");
+        out.push_back({"motion", params,
+                       [shape, options, sampling](const Sequence& seq, std::size_t i,
+                                                  minfi::Frame& f) {
+                         const minfi::MotionField field =
+                             minfi::estimate_motion(seq[i - 1], seq[i + 1], shape, options);
+                         minfi::interpolate_motion_into(seq[i - 1], seq[i + 1], shape,
+                                                        field.view(), 0.5f, f, sampling);
+                       }});
+      }
+    }
+  }
+  return out;
+}
+
+// A result is on the front unless another is at least as fast and as good on both metrics,
+// and strictly better on one of the three.
+void mark_pareto(std::vector<Result>& results) {
+  for (Result& r : results) {
+    r.pareto = std::none_of(results.begin(), results.end(), [&](const Result& o) {
+      const bool no_worse =
+          o.ms_per_frame <= r.ms_per_frame && o.psnr >= r.psnr && o.ssim >= r.ssim;
+      const bool better = o.ms_per_frame < r.ms_per_frame || o.psnr > r.psnr || o.ssim > r.ssim;
+      return no_worse && better;
+    });
+  }
+}
+
+void write_json(std::ostream& os, const std::vector<Result>& results) {
+  os << std::setprecision(6) << "[\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    os << "  {\"method\": \"" << r.method << "\", \"params\": \"" << r.params
+       << "\", \"ms_per_frame\": " << r.ms_per_frame << ", \"psnr_db\": ";
+    if (std::isinf(r.psnr)) {
+      os << "null";
+    } else {
+      os << r.psnr;
+    }
+    os << ", \"ssim\": " << r.ssim << ", \"pareto\": " << (r.pareto ? "true" : "false") << "}"
+       << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "]\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string input, json;
+  minfi::FrameShape shape{320, 180, 3};
+  std::size_t frames = 25;
+  int iters = 3;
+  double min_psnr = -1, min_ssim = -2;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto need = [&](int n) {
+      if (i + n >= argc) {
+        usage(argv[0]);
+        std::exit(2);
+      }
+    };
+    if (arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    } else if (arg == "--input") {
+      need(4);
+      input = argv[++i];
+      shape.width = std::stoul(argv[++i]);
+      shape.height = std::stoul(argv[++i]);
+      shape.channels = std::stoul(argv[++i]);
+    } else if (arg == "--size") {
+      need(2);
+      shape.width = std::stoul(argv[++i]);
+      shape.height = std::stoul(argv[++i]);
+    } else if (arg == "--frames") {
+      need(1);
+      frames = std::stoul(argv[++i]);
+    } else if (arg == "--iters") {
+      need(1);
+      iters = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--json") {
+      need(1);
+      json = argv[++i];
+    } else if (arg == "--min-psnr") {
+      need(1);
+      min_psnr = std::stod(argv[++i]);
+    } else if (arg == "--min-ssim") {
+      need(1);
+      min_ssim = std::stod(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  const Sequence seq = input.empty() ? synthetic(shape, frames) : load(input, shape, frames);
+  if (seq.size() < 3) {
+    std::cerr << "need at least 3 frames, got " << seq.size() << "\n";
+    return 1;
+  }
+  // Odd frames with a surviving frame on both sides are the ones reinterpolated.
+  std::vector<std::size_t> targets;
+  for (std::size_t i = 1; i + 1 < seq.size(); i += 2) targets.push_back(i);
+
+  std::vector<Result> results;
+  minfi::Frame out(shape.elems());
+  for (const Config& config : configs(shape)) {
+    Result r{config.method, config.params};
+    for (const std::size_t i : targets) {
+      config.run(seq, i, out);
+      r.psnr += minfi::psnr(out, seq[i]);
+      r.ssim += minfi::ssim(out, seq[i], shape);
+    }
+    r.psnr /= static_cast<double>(targets.size());
+    r.ssim /= static_cast<double>(targets.size());
+    const auto t0 = clock_type::now();
+    for (int it = 0; it < iters; ++it) {
+      for (const std::size_t i : targets) config.run(seq, i, out);
+    }
+    r.ms_per_frame = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() /
+                     static_cast<double>(targets.size() * static_cast<std::size_t>(iters));
+    results.push_back(r);
+  }
+  mark_pareto(results);
+
+  std::cout << "shape=" << shape.width << "x" << shape.height << "x" << shape.channels
+            << ", frames=" << seq.size() << ", interpolated=" << targets.size()
+            << ", iters=" << iters << "  (* = Pareto front)\n";
+  std::cout << std::left << std::setw(8) << "method" << std::setw(36) << "params" << std::right
+            << std::setw(10) << "ms/frame" << std::setw(10) << "PSNR dB" << std::setw(9)
+            << "SSIM" << "\n";
+  std::cout << std::fixed;
+  for (const Result& r : results) {
+    std::cout << std::left << std::setw(8) << r.method << std::setw(36) << r.params << std::right
+              << std::setprecision(3) << std::setw(10) << r.ms_per_frame << std::setprecision(2)
+              << std::setw(10) << r.psnr << std::setprecision(4) << std::setw(9) << r.ssim
+              << (r.pareto ? " *" : "") << "\n";
+  }
+
+  if (min_psnr >= 0 || min_ssim >= -1) {
+    const Result* best = nullptr;
+    for (const Result& r : results) {
+      if (r.psnr < min_psnr || r.ssim < min_ssim) continue;
+      if (!best || r.ms_per_frame < best->ms_per_frame) best = &r;
+    }
+    if (best) {
+      std::cout << "cheapest meeting the bar: " << best->method << " " << best->params << " ("
+                << std::setprecision(3) << best->ms_per_frame << " ms/frame)\n";
+    } else {
+      std::cout << "no configuration meets the bar\n";
+    }
+  }
+
+  if (!json.empty()) {
+    std::cout.unsetf(std::ios::fixed);
+    if (json == "-") {
+      write_json(std::cout, results);
+    } else {
+      std::ofstream os(json);
+      write_json(os, results);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+// Raw frame sequence ingestion benchmark: reads a float frame file and interpolates every
+// consecutive pair, comparing a buffered std::ifstream loop against RawFrameReader on the pread
+// worker pool and on io_uring.
+//
+// The file is written by the benchmark itself, so it is usually still in the page cache; O_DIRECT
+// bypasses the cache and therefore measures the device, while the ifstream row measures memcpy
+// out of the cache. Drop caches (echo 3 > /proc/sys/vm/drop_caches) for a cold comparison.
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "minfi/frame_reader.hpp"
+#include "minfi/kernels.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+static void usage(const char* argv0) {
+  std::cout << "minfi_reader_bench — raw frame reader throughput benchmark\n\n";
+  std::cout << "Usage: " << argv0 << " [frame_elems] [frames] [readahead] [path]\n";
+  std::cout << "  frame_elems: floats per frame (default 1920*1080*3)\n";
+  std::cout << "  frames     : frames in the sequence (default 120)\n";
+  std::cout << "  readahead  : reads kept in flight (default 4)\n";
+  std::cout << "  path       : existing raw file to read instead of a generated one\n";
+}
+
+struct Row {
+  std::string name;
+  double seconds = 0;
+  std::uint64_t stalls = 0;
+  double stall_ms = 0;
+  bool direct = false;
+};
+
+static Row run_ifstream(const std::string& path, std::size_t elems, std::size_t frames,
+                        std::vector<float>& out) {
+  std::ifstream in(path, std::ios::binary);
+  std::vector<float> a(elems), b(elems);
+  const auto bytes = static_cast<std::streamsize>(elems * sizeof(float));
+  const auto t0 = clock_type::now();
+  in.read(reinterpret_cast<char*>(a.data()), bytes);
+  for (std::size_t f = 1; f < frames; ++f) {
+    in.read(reinterpret_cast<char*>(b.data()), bytes);
+    minfi::interpolate_into<float>(a, b, out, 0.5f);
+    a.swap(b);
+  }
+  return {"ifstream", std::chrono::duration<double>(clock_type::now() - t0).count(), 0, 0, false};
+}
+
+static Row run_reader(const std::string& path, std::size_t elems, minfi::ReadBackend backend,
+                      std::size_t readahead, bool direct, std::vector<float>& out) {
+  minfi::FrameReaderOptions o;
+  o.backend = backend;
+  o.readahead = readahead;
+  o.direct_io = direct;
+  const auto t0 = clock_type::now();
+  auto reader = minfi::RawFrameReader::open(path, elems * sizeof(float), o);
+  auto prev = reader.next();
+  while (auto cur = reader.next()) {
+    minfi::interpolate_into<float>(prev->floats(), cur->floats(), out, 0.5f);
+    prev = std::move(cur);
+  }
+  const double s = std::chrono::duration<double>(clock_type::now() - t0).count();
+  const auto st = reader.stats();
+  return {std::string(minfi::to_string(reader.backend())) + (reader.direct_io() ? "+direct" : ""),
+          s, st.stalls, static_cast<double>(st.stall_ns) / 1e6, reader.direct_io()};
+}
+
+int main(int argc, char** argv) {
+  if (argc == 2 && std::string(argv[1]) == "--help") {
+    usage(argv[0]);
+    return 0;
+  }
+  const std::size_t elems = argc >= 2 ? std::stoul(argv[1]) : 1920u * 1080u * 3u;
+  const std::size_t frames = argc >= 3 ? std::stoul(argv[2]) : 120;
+  const std::size_t readahead = argc >= 4 ? std::stoul(argv[3]) : 4;
+  const bool generated = argc < 5;
+  const std::string path =
+      generated ? "/tmp/minfi-reader-bench-" + std::to_string(::getpid()) + ".f32" : argv[4];
+
+  if (generated) {
+    std::ofstream f(path, std::ios::binary);
+    std::vector<float> frame(elems);
+    for (std::size_t i = 0; i < frames; ++i) {
+      std::fill(frame.begin(), frame.end(), static_cast<float>(i % 256) / 255.0f);
+      f.write(reinterpret_cast<const char*>(frame.data()),
+              static_cast<std::streamsize>(elems * sizeof(float)));
+    }
+  }
+
+  std::vector<float> out(elems);
+  std::vector<Row> rows;
+  rows.push_back(run_ifstream(path, elems, frames, out));
+  for (bool direct : {false, true}) {
+    rows.push_back(run_reader(path, elems, minfi::ReadBackend::Threads, readahead, direct, out));
+    try {
+      rows.push_back(
+          run_reader(path, elems, minfi::ReadBackend::IoUring, readahead, direct, out));
+    } catch (const std::exception& e) {
+      if (!direct) std::cout << "io_uring unavailable: " << e.what() << "\n";
+    }
+  }
+
+  const double gb = static_cast<double>(frames * elems * sizeof(float)) / 1e9;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "frames=" << frames << " frame_bytes=" << elems * sizeof(float)
+            << " readahead=" << readahead << "\n";
+  std::cout << std::left << std::setw(20) << "reader" << std::right << std::setw(10) << "ms"
+            << std::setw(10) << "GB/s" << std::setw(10) << "stalls" << std::setw(12)
+            << "stall ms" << "\n";
+  for (const Row& r : rows) {
+    std::cout << std::left << std::setw(20) << r.name << std::right << std::setw(10)
+              << r.seconds * 1e3 << std::setw(10) << gb / r.seconds << std::setw(10) << r.stalls
+              << std::setw(12) << r.stall_ms << "\n";
+  }
+  std::cout << "(checksum " << out[0] << ")\n";
+  if (generated) std::remove(path.c_str());
+  return 0;
+}
@@ -0,0 +1,100 @@
+// Cross-process shared-memory ingestion benchmark: a forked producer publishes frames into a
+// ShmFrameRing and this process interpolates consecutive pairs straight out of the ring.
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+#include "minfi/shm_ring.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+static std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch())
+      .count();
+}
+
+static void usage(const char* argv0) {
+  std::cout << "minfi_shm_bench — shared-memory frame ring latency/throughput benchmark\n\n";
+  std::cout << "Usage: " << argv0 << " [frame_elems] [frames] [fps] [slots]\n";
+  std::cout << "  frame_elems: floats per frame (default 1920*1080*3)\n";
+  std::cout << "  frames     : frames to publish (default 300)\n";
+  std::cout << "  fps        : producer rate, 0 = unthrottled (default 0)\n";
+  std::cout << "  slots      : ring capacity (default 4)\n";
+}
+
+static void produce(const std::string& name, std::size_t frames, double fps) {
+  auto ring = minfi::ShmFrameRing::open(name);
+  auto next = clock_type::now();
+  const auto period = std::chrono::duration<double>(fps > 0 ? 1.0 / fps : 0.0);
+  for (std::size_t f = 0; f < frames; ++f) {
+    auto slot = ring.acquire_write();
+    std::fill(slot.begin(), slot.end(), static_cast<float>(f % 256) / 255.0f);
+    if (fps > 0) {
+      next += std::chrono::duration_cast<clock_type::duration>(period);
+      std::this_thread::sleep_until(next);
+    }
+    ring.publish(now_ns());
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc == 2 && std::string(argv[1]) == "--help") {
+    usage(argv[0]);
+    return 0;
+  }
+  const std::size_t elems = argc >= 2 ? std::stoul(argv[1]) : 1920u * 1080u * 3u;
+  const std::size_t frames = argc >= 3 ? std::stoul(argv[2]) : 300;
+  const double fps = argc >= 4 ? std::stod(argv[3]) : 0.0;
+  const std::size_t slots = argc >= 5 ? std::stoul(argv[4]) : 4;
+  const std::string name = "minfi-shm-bench-" + std::to_string(::getpid());
+
+  auto ring = minfi::ShmFrameRing::create(name, slots, elems);
+  const pid_t child = ::fork();
+  if (child == 0) {
+    produce(name, frames, fps);
+    ::_exit(0);
+  }
+
+  std::vector<float> out(elems);
+  std::vector<double> latency_us;
+  latency_us.reserve(frames);
+  float checksum = 0.f;
+  const auto t0 = clock_type::now();
+  for (std::size_t pair = 0; pair + 1 < frames; ++pair) {
+    ring.wait_readable(2);
+    minfi::interpolate_into<float>(ring.read(0), ring.read(1), out, 0.5f);
+    // Latency from the newer frame of the pair being published to the output being ready.
+    latency_us.push_back(static_cast<double>(now_ns() - ring.meta(1).timestamp_ns) / 1e3);
+    checksum += out[pair % elems];
+    ring.release(1);
+  }
+  const std::chrono::duration<double> dt = clock_type::now() - t0;
+  ring.release(ring.readable());
+  ::waitpid(child, nullptr, 0);
+
+  std::sort(latency_us.begin(), latency_us.end());
+  const auto pct = [&](double p) {
+    if (latency_us.empty()) return 0.0;
+    return latency_us[static_cast<std::size_t>(p * static_cast<double>(latency_us.size() - 1))];
+  };
+  const double pairs = static_cast<double>(latency_us.size());
+  const double gbps = pairs * elems * sizeof(float) * 3 / dt.count() / 1e9;
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "frame_elems=" << elems << ", frames=" << frames << ", fps=" << fps
+            << ", slots=" << ring.slots() << "\n";
+  std::cout << "pairs/s=" << pairs / dt.count() << ", approx GB/s=" << gbps << "\n";
+  std::cout << "latency(us) p50=" << pct(0.50) << " p99=" << pct(0.99) << " max=" << pct(1.0)
+            << "\n";
+  std::cout << "checksum=" << checksum << "\n";
+  return 0;
+}
@@ -0,0 +1,34 @@
+# Generates a C++ header embedding WGSL sources as constexpr string views.
+#
+#   cmake -DOUTPUT=<header> -DSHADERS="<name>=<file>;..." -P embed_shaders.cmake
+#
+# Each <name> becomes `inline constexpr std::string_view <name>` in namespace minfi_shaders.
+
+if(NOT OUTPUT OR NOT SHADERS)
+  message(FATAL_ERROR "embed_shaders.cmake: OUTPUT and SHADERS are required")
+endif()
+
+set(body "")
+foreach(entry IN LISTS SHADERS)
+  string(FIND "${entry}" "=" eq)
+  string(SUBSTRING "${entry}" 0 ${eq} name)
+  math(EXPR start "${eq} + 1")
+  string(SUBSTRING "${entry}" ${start} -1 file)
+  file(READ "${file}" source)
+  if(source MATCHES "\\)WGSL\"")
+    message(FATAL_ERROR "embed_shaders.cmake: ${file} contains the raw-string delimiter")
+  endif()
+  get_filename_component(file_name "${file}" NAME)
+  string(APPEND body "\n// ${file_name}\ninline constexpr std::string_view ${name} = R\"WGSL(${source})WGSL\";\n")
+endforeach()
+
+set(content "// Generated by cmake/embed_shaders.cmake. Do not edit.\n#pragma once\n\n#include <string_view>\n\nnamespace minfi_shaders {\n${body}\n}  // namespace minfi_shaders\n")
+
+# Only touch the header when it changes, so dependents are not rebuilt needlessly.
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" previous)
+  if(previous STREQUAL content)
+    return()
+  endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "minfi/motion.hpp"
+#include "minfi/motion_cache.hpp"
+#include "minfi/shape.hpp"
+
+namespace minfi {
+
+// Interpolation methods ordered by cost and quality.
+enum class QualityTier : std::uint8_t {
+  Linear = 0,  // plain blend, minfi::interpolate_into
+  Block = 1,   // motion-compensated, one vector per block
+  Dense = 2,   // motion-compensated, per-pixel vectors blended between block centres
+};
+inline constexpr std::size_t kQualityTiers = 3;
+
+const char* to_string(QualityTier tier);
+
+struct AdaptiveOptions {
+  MotionOptions motion;
+  QualityTier max_tier = QualityTier::Dense;
+  // Fraction of the time left before the deadline that a tier's predicted cost may use.
+  double headroom = 0.8;
+  // Weight of the newest sample in the exponentially weighted cost averages.
+  double cost_alpha = 0.25;
+  // Consecutive on-time frames needed before the next tier up is tried.
+  std::size_t upgrade_after = 8;
+  // Byte budget of the internal motion-field cache (reused across t for one pair).
+  std::size_t motion_cache_bytes = 16u << 20;
+};
+
+// Real-time interpolation that picks, per output frame, the most expensive tier it can finish
+// before a deadline.
+//
+// A running cost model keeps exponentially weighted timings of each tier's warp and of motion
+// estimation; estimation is only charged when the pair's field is not cached yet. The chosen
+// tier is the highest one at or below a ceiling whose predicted cost fits into `headroom` of the
+// time left, falling back to Linear. A missed deadline lowers the ceiling by one tier right away;
+// `upgrade_after` consecutive on-time frames raise it by one so a dearer tier gets measured.
+//
+// Not thread-safe; use one instance per output stream.
+class AdaptiveInterpolator {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Result {
+    QualityTier tier = QualityTier::Linear;
+    Clock::duration elapsed{};
+    bool met_deadline = true;
+  };
+
+  struct Stats {
+    std::array<std::uint64_t, kQualityTiers> frames{};  // indexed by QualityTier
+    std::uint64_t deadline_misses = 0;
+    std::uint64_t downgrades = 0;
+    std::uint64_t upgrades = 0;
+    std::uint64_t estimations = 0;
+    QualityTier ceiling = QualityTier::Linear;
+    // Current cost model; zero until a tier or estimation has been measured.
+    std::array<Clock::duration, kQualityTiers> tier_cost{};
+    Clock::duration estimate_cost{};
+  };
+
+  // Throws std::invalid_argument for an empty shape or out-of-range options.
+  explicit AdaptiveInterpolator(FrameShape shape, AdaptiveOptions options = {});
+
+  // Interpolates a -> b at t into out, finishing by `deadline` if the cost model allows. `key`
+  // identifies the source pair so its motion field is estimated once for every t.
+  // Throws std::invalid_argument if the frames do not match the shape.
+  Result interpolate_into(const FramePairKey& key, std::span<const float> a,
+                          std::span<const float> b, float t, std::span<float> out,
+                          Clock::time_point deadline);
+
+  // Tier that interpolate_into would pick for `key` with `budget` left; does not run anything.
+  QualityTier choose(const FramePairKey& key, Clock::duration budget) const;
+
+  const Stats& stats() const { return stats_; }
+  const FrameShape& shape() const { return shape_; }
+  // Forgets the cost model and restarts from the Linear tier; counters are kept.
+  void reset_model();
+
+ private:
+  void record_(Clock::duration& average, Clock::duration sample) const;
+
+  FrameShape shape_;
+  AdaptiveOptions options_;
+  MotionCache motion_cache_;
+  Stats stats_;
+  std::size_t on_time_streak_ = 0;
+};
+
+}  // namespace minfi
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <stop_token>
+
+#include "minfi/executor.hpp"
+#include "minfi/interpolate.hpp"
+
+namespace minfi {
+
+// Thrown (through the future or awaitable) when a request observes its stop token.
+class Cancelled : public std::runtime_error {
+ public:
+  Cancelled() : std::runtime_error("interpolate: cancelled") {}
+};
+
+struct AsyncOptions {
+  // Executor that runs the work; default_executor() when null.
+  Executor* executor = nullptr;
+  // Checked before the work starts and between chunks while it runs.
+  std::stop_token stop{};
+  // Invoked on the executor thread once the work finishes, before the future becomes ready.
+  // Receives the result, or nullptr and the exception on failure or cancellation. Called exactly
+  // once; exceptions it throws are swallowed.
+  std::function<void(const Frame* result, std::exception_ptr error)> on_complete{};
+};
+
+// Submits interpolate(a, b, t) to the executor and returns immediately. Inputs are taken by
+// value so callers can move frames in and keep no references alive.
+std::future<Frame> interpolate_async(Frame a, Frame b, float t, AsyncOptions options = {});
+
+// C++20 awaitable counterpart of interpolate_async:
+//
+//   Frame out = co_await minfi::interpolate_awaitable(std::move(a), std::move(b), 0.5f);
+//
+// The awaiting coroutine is resumed on the executor thread that finished the work.
+class InterpolateAwaitable {
+ public:
+  InterpolateAwaitable(Frame a, Frame b, float t, AsyncOptions options);
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  Frame await_resume();
+
+ private:
+  Frame a_;
+  Frame b_;
+  float t_;
+  AsyncOptions options_;
+  Frame result_;
+  std::exception_ptr error_;
+};
+
+InterpolateAwaitable interpolate_awaitable(Frame a, Frame b, float t, AsyncOptions options = {});
+
+}  // namespace minfi
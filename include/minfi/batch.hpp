@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/shape.hpp"
+
+namespace minfi {
+
+// Many same-shaped small frames (thumbnails, sprites, tiles) packed back to back in a single
+// allocation: frame i occupies elements [i * frame_elems(), (i + 1) * frame_elems()). Compared
+// with a std::vector<Frame>, there is one allocation for the whole batch instead of one per
+// frame, and one size check per batch instead of one per frame. A whole batch is interpolated
+// in a single sweep.
+class FrameBatch {
+ public:
+  // Holds `frames` zero-initialized frames. Throws std::invalid_argument if shape is empty.
+  explicit FrameBatch(FrameShape shape, std::size_t frames = 0);
+
+  const FrameShape& shape() const { return shape_; }
+  std::size_t frame_elems() const { return frame_elems_; }
+  std::size_t size() const { return frames_; }
+  bool empty() const { return frames_ == 0; }
+
+  void reserve(std::size_t frames);
+  // New frames are zero-initialized.
+  void resize(std::size_t frames);
+  void clear() { resize(0); }
+
+  // Appends a copy of `frame` and returns its index.
+  // Throws std::invalid_argument unless frame.size() == frame_elems().
+  std::size_t push_back(std::span<const float> frame);
+
+  // Frame i in place (unchecked, like vector::operator[]).
+  std::span<float> frame(std::size_t i) {
+    return {data_.data() + i * frame_elems_, frame_elems_};
+  }
+  std::span<const float> frame(std::size_t i) const {
+    return {data_.data() + i * frame_elems_, frame_elems_};
+  }
+
+  // All frames as one contiguous array.
+  std::span<float> data() { return {data_.data(), frames_ * frame_elems_}; }
+  std::span<const float> data() const { return {data_.data(), frames_ * frame_elems_}; }
+
+  // Copies frame i out. Throws std::out_of_range if i >= size(), and gather_into throws
+  // std::invalid_argument unless dst.size() == frame_elems().
+  Frame gather(std::size_t i) const;
+  void gather_into(std::size_t i, std::span<float> dst) const;
+  std::vector<Frame> gather_all() const;
+
+ private:
+  FrameShape shape_;
+  std::size_t frame_elems_;
+  std::size_t frames_ = 0;
+  Frame data_;
+};
+
+// out.frame(i) = interpolate(a.frame(i), b.frame(i), t[i]) for every frame, as one sweep split
+// into groups of whole frames across threads per the active tuning (minfi/tuning.hpp). Each t
+// is clamped to [0, 1]; results are identical to per-frame interpolate(). out is resized to
+// a.size() frames and may be a or b.
+// Throws std::invalid_argument if the shapes or frame counts differ, or t.size() != a.size().
+void interpolate_batch_into(const FrameBatch& a, const FrameBatch& b, std::span<const float> t,
+                            FrameBatch& out);
+FrameBatch interpolate_batch(const FrameBatch& a, const FrameBatch& b, std::span<const float> t);
+// Same t for every frame.
+FrameBatch interpolate_batch(const FrameBatch& a, const FrameBatch& b, float t);
+
+}  // namespace minfi
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "minfi/interpolate.hpp"
+
+namespace minfi {
+
+// Catmull-Rom basis weights for samples (p0, p1, p2, p3) at t in [0, 1] between p1 and p2.
+// The weights sum to 1; t = 0 reproduces p1 and t = 1 reproduces p2 exactly.
+struct CubicWeights {
+  float w0, w1, w2, w3;
+};
+CubicWeights catmull_rom_weights(float t);
+
+// Cubic temporal interpolation between p1 and p2 using p0 and p3 as neighbours, computed in a
+// single fused pass over the four inputs. t is clamped to [0, 1]. The result may overshoot the
+// source range near sharp changes, as any Catmull-Rom spline does.
+// Throws std::invalid_argument on size mismatch.
+void interpolate_cubic_into(std::span<const float> p0, std::span<const float> p1,
+                            std::span<const float> p2, std::span<const float> p3,
+                            std::span<float> out, float t);
+Frame interpolate_cubic(const Frame& p0, const Frame& p1, const Frame& p2, const Frame& p3,
+                        float t);
+
+// Streaming cubic interpolator over a sliding window of the four most recent source frames
+// (n-1, n, n+1, n+2). Frames live in a fixed ring of buffers: pushing a frame recycles the
+// storage of the frame that falls out of the window instead of shifting or reallocating.
+//
+// To interpolate the first and last source intervals of a stream, push the first frame twice
+// and the last frame twice (boundary clamping).
+class CubicInterpolator {
+ public:
+  // Copies `frame` into the recycled slot, reusing its capacity.
+  void push(const Frame& frame);
+  // Swaps `frame` into the window. On return `frame` holds a recycled buffer with unspecified
+  // contents (possibly empty, possibly a stale frame after reset()) so callers can decode the
+  // next frame into it without allocating.
+  void push(Frame&& frame);
+
+  // Returns the recycled slot resized to `size` for in-place filling; call commit() when done.
+  Frame& next_slot(std::size_t size);
+  void commit();
+
+  // True once four frames are in the window.
+  bool ready() const { return count_ == kWindow; }
+  std::size_t size() const { return count_; }
+  void reset();
+
+  // Window frame at `offset` relative to n, in [-1, 2]. Requires ready().
+  const Frame& frame(int offset) const;
+
+  // Interpolates between frames n and n+1. Throws std::logic_error unless ready().
+  void interpolate_into(float t, std::span<float> out) const;
+  Frame interpolate(float t) const;
+
+ private:
+  static constexpr std::size_t kWindow = 4;
+
+  std::array<Frame, kWindow> slots_{};
+  std::size_t head_ = 0;  // slot holding frame n-1 once the window is full
+  std::size_t count_ = 0;
+};
+
+}  // namespace minfi
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace minfi {
+
+// Fixed-size FIFO thread pool used for minfi's background work.
+class Executor {
+ public:
+  // threads == 0 selects std::thread::hardware_concurrency() (at least one).
+  explicit Executor(std::size_t threads = 0);
+  // Runs every task already submitted, and any they submit in turn, then joins the workers.
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  // Exceptions escaping a task are discarded. Once destruction begins, only running tasks may
+  // submit (asserted).
+  void submit(std::function<void()> task);
+  std::size_t thread_count() const { return workers_.size(); }
+  // Tasks submitted but not yet started.
+  std::size_t pending() const;
+
+ private:
+  void run_();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  std::size_t running_ = 0;  // tasks currently executing
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// Process-wide executor, created on first use.
+Executor& default_executor();
+
+}  // namespace minfi
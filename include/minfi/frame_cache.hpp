@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/motion_cache.hpp"
+
+namespace minfi {
+
+// How an output frame was produced; part of the cache key.
+enum class OutputMethod : std::uint8_t {
+  Linear,
+  Cubic,
+  Motion,        // interpolate_motion_into with MotionSampling::Block
+  MotionSmooth,  // interpolate_motion_into with MotionSampling::Smooth
+};
+
+// Identity of an interpolated frame: source pair, t quantized to FrameCache::Options::t_steps,
+// and method. Build keys with FrameCache::key() so t is quantized consistently.
+struct OutputKey {
+  FramePairKey pair;
+  std::uint32_t t = 0;
+  OutputMethod method = OutputMethod::Linear;
+
+  friend constexpr bool operator==(const OutputKey&, const OutputKey&) = default;
+};
+
+struct OutputKeyHash {
+  std::size_t operator()(const OutputKey& k) const noexcept {
+    return FramePairKeyHash{}(k.pair) ^
+           (static_cast<std::size_t>(k.t) * 0x9e3779b1u + static_cast<std::size_t>(k.method));
+  }
+};
+
+// Byte-bounded cache of interpolated output frames, for playback that revisits the same
+// intermediate frames (scrubbing, looping, seeking). A hit copies the stored frame into the
+// caller's buffer and skips interpolation and motion estimation entirely.
+//
+// Eviction is CLOCK: a hit sets the entry's reference bit, and the hand sweeping for space
+// clears set bits and evicts entries whose bit is already clear. With compress_cold, an
+// unreferenced entry is first compressed losslessly (byte planes, then LZ4 when built with
+// MINFI_WITH_LZ4 or run-length coding otherwise) and only evicted on the hand's next visit;
+// a hit on a compressed entry decodes it and keeps it uncompressed again.
+//
+// Thread-safe. Frames are copied and compressed outside the lock; concurrent misses on one
+// key may both compute.
+class FrameCache {
+ public:
+  struct Options {
+    std::size_t byte_budget = 256u << 20;
+    std::uint32_t t_steps = 1u << 16;  // t is rounded to multiples of 1 / t_steps
+    bool compress_cold = false;
+  };
+
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t compressions = 0;
+    std::size_t bytes = 0;  // stored bytes, compressed entries at their compressed size
+    std::size_t entries = 0;
+    std::size_t compressed_entries = 0;
+
+    double hit_rate() const {
+      const std::uint64_t total = hits + misses;
+      return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+  };
+
+  // Throws std::invalid_argument if t_steps is 0.
+  explicit FrameCache(Options options);
+  FrameCache() : FrameCache(Options{}) {}
+
+  // t is clamped to [0, 1]; throws std::invalid_argument if it is NaN.
+  OutputKey key(const FramePairKey& pair, float t, OutputMethod method) const;
+
+  // Copies the cached frame for `key` into out and returns true, or returns false on a miss.
+  // Throws std::invalid_argument if the cached frame's size differs from out.size().
+  bool lookup(const OutputKey& key, std::span<float> out);
+  // Stores a copy of `frame` under `key`, replacing any previous entry. A frame larger than
+  // the whole budget is not retained.
+  void insert(const OutputKey& key, std::span<const float> frame);
+
+  // lookup(), falling back to compute(out) and insert() on a miss. Returns true on a hit.
+  template <typename Compute>
+  bool get_or_compute(const OutputKey& key, std::span<float> out, Compute&& compute) {
+    if (lookup(key, out)) return true;
+    compute(out);
+    insert(key, out);
+    return false;
+  }
+
+  void set_budget(std::size_t byte_budget);
+  std::size_t budget() const;
+  void clear();
+  Stats stats() const;
+
+ private:
+  using Packed = Vector<std::uint8_t, Subsystem::Frames>;
+  struct Slot {
+    OutputKey key;
+    std::size_t elems = 0;
+    std::shared_ptr<const Frame> raw;      // set unless the entry is compressed
+    std::shared_ptr<const Packed> packed;  // set while the entry is compressed
+    bool used = false;
+    bool referenced = false;
+    bool compressing = false;  // being encoded outside the lock; the hand skips it
+  };
+
+  static std::size_t slot_bytes_(const Slot& slot);
+  void release_(std::size_t index);
+  // May release `lock` while compressing an entry.
+  void evict_to_budget_(std::unique_lock<std::mutex>& lock);
+
+  Options options_;
+  mutable std::mutex mutex_;
+  std::vector<Slot> slots_;
+  std::vector<std::size_t> free_;
+  std::unordered_map<OutputKey, std::size_t, OutputKeyHash> index_;
+  std::size_t hand_ = 0;
+  Stats stats_;
+};
+
+}  // namespace minfi
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace minfi {
+
+enum class ReadBackend : std::uint8_t {
+  Auto,     // io_uring when the kernel allows it, else Threads
+  IoUring,  // Linux io_uring (raw syscalls, no liburing dependency)
+  Threads,  // pread() on a small worker pool
+};
+
+const char* to_string(ReadBackend backend);
+
+struct FrameReaderOptions {
+  // Frames kept in flight or resident ahead of the consumer.
+  std::size_t readahead = 4;
+  // Open with O_DIRECT when offsets and sizes allow it (4 KiB aligned) and the filesystem
+  // accepts it; otherwise buffered reads are used.
+  bool direct_io = true;
+  ReadBackend backend = ReadBackend::Auto;
+  // Worker count of the Threads backend.
+  std::size_t threads = 2;
+  // Single-file sequences: bytes before frame 0.
+  std::size_t header_bytes = 0;
+};
+
+// Sequential reader of uncompressed frame sequences (one large raw file, or one file per frame)
+// that keeps `readahead` reads in flight, so the next pair is resident by the time the current
+// one has been interpolated:
+//
+//   auto reader = minfi::RawFrameReader::open("clip.f32", frame_bytes);
+//   auto prev = reader.next();
+//   while (auto cur = reader.next()) {
+//     minfi::interpolate_into<float>(prev->floats(), cur->floats(), out, 0.5f);
+//     prev = std::move(cur);
+//   }
+//
+// Buffers come from a pool of readahead + 2 page-aligned slots (accounted under
+// Subsystem::Frames); a slot returns to the pool when its Buffer is destroyed. Holding more
+// than two Buffers at a time eats into the readahead. next() is not thread-safe, but Buffers
+// may be released from any thread.
+class RawFrameReader {
+ public:
+  class Buffer {
+   public:
+    Buffer() = default;
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    ~Buffer();
+
+    std::size_t index() const { return index_; }
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+    // The frame as float samples; size_ must be a multiple of sizeof(float).
+    std::span<const float> floats() const {
+      return {reinterpret_cast<const float*>(data_), size_ / sizeof(float)};
+    }
+
+   private:
+    friend class RawFrameReader;
+    struct Owner;
+
+    std::shared_ptr<Owner> owner_;
+    std::size_t slot_ = 0;
+    std::size_t index_ = 0;
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+  };
+
+  struct Stats {
+    std::uint64_t frames = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t stalls = 0;  // next() calls that had to wait for I/O
+    std::uint64_t stall_ns = 0;
+  };
+
+  // Frames of frame_bytes stored back to back in one file after options.header_bytes. Throws
+  // std::invalid_argument unless 0 < frame_bytes < 4 GiB.
+  static RawFrameReader open(const std::string& path, std::size_t frame_bytes,
+                             const FrameReaderOptions& options = {});
+  // One file per frame, in order; each file holds at least frame_bytes.
+  static RawFrameReader open(std::vector<std::string> paths, std::size_t frame_bytes,
+                             const FrameReaderOptions& options = {});
+
+  RawFrameReader(RawFrameReader&&) noexcept;
+  RawFrameReader& operator=(RawFrameReader&&) noexcept;
+  RawFrameReader(const RawFrameReader&) = delete;
+  RawFrameReader& operator=(const RawFrameReader&) = delete;
+  // Waits for reads still in flight; outstanding Buffers stay valid.
+  ~RawFrameReader();
+
+  std::size_t frame_count() const;
+  std::size_t frame_bytes() const;
+  ReadBackend backend() const;
+  bool direct_io() const;
+  Stats stats() const;
+
+  // The next frame in order, or nullopt after the last one. Throws std::runtime_error on I/O
+  // errors or truncated frames; the failure is sticky, so later calls throw it again rather
+  // than skipping the frame.
+  std::optional<Buffer> next();
+
+ private:
+  struct Impl;
+  explicit RawFrameReader(std::shared_ptr<Impl> impl);
+
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace minfi
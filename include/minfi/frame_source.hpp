@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include "minfi/memory.hpp"
+#include "minfi/packed.hpp"
+
+namespace minfi {
+
+// Pixel storage a decoder writes one frame into. Buffers are pooled and reused across frames,
+// so reshape() only reallocates when a frame is larger than anything the buffer held before.
+class DecodeTarget {
+ public:
+  // Sizes the buffer for a tightly packed width x height image and returns a view of it.
+  MutablePackedImageView reshape(std::size_t width, std::size_t height, PixelFormat format);
+  PackedImageView view() const { return {pixels_.data(), width_, height_, format_}; }
+
+ private:
+  Vector<std::uint8_t, Subsystem::Frames> pixels_;
+  std::size_t width_ = 0;
+  std::size_t height_ = 0;
+  PixelFormat format_ = PixelFormat::Rgb8;
+};
+
+struct FrameSourceOptions {
+  // Decode threads; 0 selects std::thread::hardware_concurrency() (at least one).
+  std::size_t threads = 0;
+  // Reorder window: frames [next, next + window) may be decoding or waiting for delivery at
+  // once, which bounds both memory and how far decode runs ahead of the consumer.
+  std::size_t window = 8;
+};
+
+// Decodes frame `index` into `out`. Called concurrently from the decode threads for different
+// indices, in roughly ascending order. Returns false when `index` is past the end of a stream
+// whose length is not known up front; exceptions are delivered to the consumer by next().
+using DecodeFn = std::function<bool(std::size_t index, DecodeTarget& out)>;
+
+// Parallel decode front end with ordered delivery. Decode threads work ahead of the consumer
+// within the reorder window into a pool of window + 2 pooled targets; next() hands frames out
+// strictly in index order and only waits when the next frame itself is still decoding:
+//
+//   minfi::ParallelFrameSource src(paths.size(), decode_png);
+//   auto prev = src.next();
+//   while (auto cur = src.next()) {
+//     minfi::interpolate_packed_into(prev->view(), cur->view(), out, 0.5f);
+//     prev = std::move(cur);
+//   }
+//
+// A Frame handle returns its buffer to the pool when destroyed, so holding more than two at a
+// time narrows the window. next() is not thread-safe; handles may be released from any thread.
+// OpenCV-backed decoders for image sequences and video live in minfi/opencv_source.hpp.
+class ParallelFrameSource {
+ public:
+  static constexpr std::size_t kUnknownCount = std::numeric_limits<std::size_t>::max();
+
+  class Frame {
+   public:
+    Frame() = default;
+    Frame(Frame&& other) noexcept;
+    Frame& operator=(Frame&& other) noexcept;
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+    ~Frame();
+
+    std::size_t index() const { return index_; }
+    PackedImageView view() const { return target_->view(); }
+
+   private:
+    friend class ParallelFrameSource;
+    struct Owner;
+
+    std::shared_ptr<Owner> owner_;
+    std::size_t slot_ = 0;
+    std::size_t index_ = 0;
+    const DecodeTarget* target_ = nullptr;
+  };
+
+  struct Stats {
+    std::uint64_t decoded = 0;
+    std::uint64_t stalls = 0;  // next() calls that waited for the frame being decoded
+    std::uint64_t stall_ns = 0;
+    std::size_t max_reorder = 0;  // most frames decoded ahead of the one being waited for
+  };
+
+  // count is the number of frames, or kUnknownCount for streams that end when decode returns
+  // false. Throws std::invalid_argument if window is 0 or decode is empty.
+  ParallelFrameSource(std::size_t count, DecodeFn decode, const FrameSourceOptions& options = {});
+  // Stops the decode threads after their current frame; outstanding Frames stay valid.
+  ~ParallelFrameSource();
+
+  ParallelFrameSource(const ParallelFrameSource&) = delete;
+  ParallelFrameSource& operator=(const ParallelFrameSource&) = delete;
+
+  // The next frame in order, or nullopt at the end. Rethrows a decode exception for the frame
+  // it occurred on. Throws std::logic_error if every pooled buffer is held by the caller.
+  std::optional<Frame> next();
+
+  // Frame count, or kUnknownCount until the end of an open-ended stream has been decoded.
+  std::size_t frame_count() const;
+  std::size_t thread_count() const;
+  Stats stats() const;
+
+ private:
+  struct Impl;
+
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace minfi
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace minfi {
+
+// High-dynamic-range histogram of non-negative integer samples (typically latencies in
+// nanoseconds), in the style of HdrHistogram: values below 2^precision_bits are counted
+// exactly, larger ones in log-linear buckets whose width is at most value / 2^(bits - 1),
+// i.e. a relative error below 1% at the default 8 bits. Recording is O(1) and allocation-free;
+// memory is fixed (about 30 KiB at 8 bits) regardless of the value range.
+//
+// Not thread-safe; give each recording thread its own histogram and merge() them.
+class LatencyHistogram {
+ public:
+  // precision_bits in [2, 16].
+  explicit LatencyHistogram(unsigned precision_bits = 8);
+
+  void record(std::uint64_t value, std::uint64_t count = 1);
+  void merge(const LatencyHistogram& other);
+  void reset();
+
+  std::uint64_t count() const { return total_; }
+  std::uint64_t min() const { return total_ ? min_ : 0; }
+  std::uint64_t max() const { return max_; }
+  double mean() const;
+
+  // Smallest recorded-bucket upper bound v such that at least `percentile`% of samples are
+  // <= v (clamped to max()). percentile is clamped to [0, 100]; 0 with no samples.
+  std::uint64_t value_at_percentile(double percentile) const;
+
+  // Number of samples strictly greater than `value`, to bucket precision.
+  std::uint64_t count_above(std::uint64_t value) const;
+
+ private:
+  std::size_t index_of_(std::uint64_t value) const;
+  std::uint64_t lowest_of_(std::size_t index) const;
+  std::uint64_t highest_of_(std::size_t index) const;
+
+  unsigned bits_;
+  std::uint64_t sub_count_;  // 2^bits_
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t total_ = 0;
+  std::uint64_t min_ = UINT64_MAX;
+  std::uint64_t max_ = 0;
+  long double sum_ = 0;
+};
+
+}  // namespace minfi
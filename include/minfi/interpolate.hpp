@@ -2,9 +2,12 @@
 
 #include <vector>
 
+#include "minfi/memory.hpp"
+
 namespace minfi {
 
-using Frame = std::vector<float>;
+// Frame buffers allocate through minfi's accounting allocator (Subsystem::Frames).
+using Frame = Vector<float, Subsystem::Frames>;
 
 // Linearly interpolate element-wise between two frames.
 // t is clamped to [0, 1]. Throws std::invalid_argument on size mismatch.
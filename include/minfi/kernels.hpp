@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace minfi {
+
+// Temporal easing policies. Each maps a clamped t in [0, 1] to a blend weight in [0, 1].
+// The policy is evaluated once per call, so the per-element loop never branches on it.
+namespace ease {
+
+struct Linear {
+  static constexpr float apply(float t) { return t; }
+};
+
+// 3t^2 - 2t^3: zero velocity at both source frames.
+struct Smoothstep {
+  static constexpr float apply(float t) { return t * t * (3.0f - 2.0f * t); }
+};
+
+// Cubic ease-in-out: 4t^3 on the first half, mirrored on the second.
+struct Cubic {
+  static constexpr float apply(float t) {
+    if (t < 0.5f) return 4.0f * t * t * t;
+    const float u = 2.0f - 2.0f * t;
+    return 1.0f - 0.5f * u * u * u;
+  }
+};
+
+}  // namespace ease
+
+namespace detail {
+
+constexpr float clamp01(float x) {
+  if (x < 0.0f) return 0.0f;
+  if (x > 1.0f) return 1.0f;
+  return x;
+}
+
+template <typename T>
+inline constexpr bool kSupportedElement =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::uint8_t> ||
+    std::is_same_v<T, std::uint16_t> || std::is_same_v<T, std::int16_t> ||
+    std::is_same_v<T, std::uint32_t>;
+
+// 8- and 16-bit unsigned samples blend exactly in float and in 32-bit fixed point; signed and
+// 32-bit samples need double, whose 53-bit mantissa holds any weighted sum of two of them.
+template <typename T>
+inline constexpr bool kBlendInDouble = std::is_integral_v<T> && (std::is_signed_v<T> ||
+                                                                 sizeof(T) >= 4);
+
+// floor(v + 0.5) without <cmath>, usable in constant expressions.
+constexpr std::int64_t round_half_up(double v) {
+  const double r = v + 0.5;
+  const auto i = static_cast<std::int64_t>(r);
+  return i - (static_cast<double>(i) > r ? 1 : 0);
+}
+
+// Runtime-weight blend. Integer samples are rounded to nearest; a convex combination of two
+// in-range samples stays in range, so no clamp is needed.
+template <typename T>
+constexpr T blend(T a, T b, float w) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return a * (T(1) - T(w)) + b * T(w);
+  } else if constexpr (kBlendInDouble<T>) {
+    const double wd = w;
+    return static_cast<T>(round_half_up(static_cast<double>(a) * (1.0 - wd) +
+                                        static_cast<double>(b) * wd));
+  } else {
+    return static_cast<T>(static_cast<float>(a) * (1.0f - w) + static_cast<float>(b) * w + 0.5f);
+  }
+}
+
+// Compile-time weight Num / Den. For t = 1/2 this collapses to an add + shift (integers) or an
+// add + multiply by 0.5 (floats); other ratios become an integer multiply-add whose division by a
+// constant the compiler turns into a multiply-shift.
+template <typename T, int Num, int Den>
+constexpr T blend_fixed(T a, T b) {
+  if constexpr (Num == 0) {
+    return a;
+  } else if constexpr (Num == Den) {
+    return b;
+  } else if constexpr (2 * Num == Den) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return (a + b) * T(0.5);
+    } else {
+      // Round-half-up average without widening: ceil((a + b) / 2).
+      return static_cast<T>((a | b) - ((a ^ b) >> 1));
+    }
+  } else if constexpr (std::is_floating_point_v<T>) {
+    constexpr T w = static_cast<T>(Num) / static_cast<T>(Den);
+    return a * (T(1) - w) + b * w;
+  } else if constexpr (kBlendInDouble<T> || Den > 65535) {
+    return static_cast<T>(round_half_up(
+        (static_cast<double>(a) * (Den - Num) + static_cast<double>(b) * Num) / Den));
+  } else {
+    // Samples below 2^16 weighted by Den <= 65535 sum to less than 2^32.
+    constexpr std::uint32_t wa = Den - Num;
+    constexpr std::uint32_t wb = Num;
+    constexpr std::uint32_t half = Den / 2;
+    return static_cast<T>((std::uint32_t{a} * wa + std::uint32_t{b} * wb + half) /
+                          static_cast<std::uint32_t>(Den));
+  }
+}
+
+template <int Channels>
+inline void check_sizes(std::size_t a, std::size_t b, std::size_t out) {
+  if (a != b || a != out) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if constexpr (Channels > 0) {
+    if (a % Channels != 0) {
+      throw std::invalid_argument("interpolate: frame size is not a multiple of channel count");
+    }
+  }
+}
+
+// Applies op(a[i], b[i]) -> out[i]. With a fixed channel count the per-pixel body is expanded
+// over an index_sequence so every channel is an independent, fully unrolled statement.
+template <typename T, int Channels, typename Op>
+inline void for_each_pixel(const T* a, const T* b, T* out, std::size_t n, Op op) {
+  if constexpr (Channels <= 1) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = op(a[i], b[i]);
+  } else {
+    const std::size_t pixels = n / Channels;
+    for (std::size_t p = 0; p < pixels; ++p) {
+      const T* pa = a + p * Channels;
+      const T* pb = b + p * Channels;
+      T* po = out + p * Channels;
+      [&]<std::size_t... C>(std::index_sequence<C...>) {
+        ((po[C] = op(pa[C], pb[C])), ...);
+      }(std::make_index_sequence<Channels>{});
+    }
+  }
+}
+
+}  // namespace detail
+
+// Templated interpolation kernel family.
+//
+//   T        element type: float, double, uint8_t, uint16_t, int16_t or uint32_t.
+//   Channels interleaved channel count known at compile time (3 or 4 for RGB/RGBA), or 0 when
+//            the layout is not known and the frame is treated as a flat array.
+//   Ease     easing policy from minfi::ease applied to the clamped t.
+//
+// Throws std::invalid_argument on size mismatch or when the size is not a multiple of Channels.
+template <typename T, int Channels = 0, typename Ease = ease::Linear>
+void interpolate_into(std::span<const T> a, std::span<const T> b, std::span<T> out, float t) {
+  static_assert(detail::kSupportedElement<T>, "interpolate: unsupported element type");
+  static_assert(Channels >= 0, "interpolate: channel count must be non-negative");
+  detail::check_sizes<Channels>(a.size(), b.size(), out.size());
+  const float w = Ease::apply(detail::clamp01(t));
+  detail::for_each_pixel<T, Channels>(a.data(), b.data(), out.data(), a.size(),
+                                      [w](T x, T y) { return detail::blend(x, y, w); });
+}
+
+template <typename T, int Channels = 0, typename Ease = ease::Linear>
+std::vector<T> interpolate(const std::vector<T>& a, const std::vector<T>& b, float t) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  std::vector<T> out(a.size());
+  interpolate_into<T, Channels, Ease>(std::span<const T>(a), std::span<const T>(b),
+                                      std::span<T>(out), t);
+  return out;
+}
+
+// Interpolation at a compile-time t = Num / Den, e.g. <1, 2> for 2x frame-rate conversion.
+template <typename T, int Channels, int Num, int Den>
+void interpolate_fixed_into(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+  static_assert(detail::kSupportedElement<T>, "interpolate: unsupported element type");
+  static_assert(Den > 0 && Num >= 0 && Num <= Den, "interpolate: fixed t must lie in [0, 1]");
+  detail::check_sizes<Channels>(a.size(), b.size(), out.size());
+  detail::for_each_pixel<T, Channels>(
+      a.data(), b.data(), out.data(), a.size(),
+      [](T x, T y) { return detail::blend_fixed<T, Num, Den>(x, y); });
+}
+
+template <typename T, int Channels, int Num, int Den>
+std::vector<T> interpolate_fixed(const std::vector<T>& a, const std::vector<T>& b) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  std::vector<T> out(a.size());
+  interpolate_fixed_into<T, Channels, Num, Den>(std::span<const T>(a), std::span<const T>(b),
+                                                std::span<T>(out));
+  return out;
+}
+
+// Shorthand for the common 2x case (t = 0.5).
+template <typename T, int Channels = 0>
+std::vector<T> interpolate_half(const std::vector<T>& a, const std::vector<T>& b) {
+  return interpolate_fixed<T, Channels, 1, 2>(a, b);
+}
+
+}  // namespace minfi
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/shape.hpp"
+
+namespace minfi {
+
+// Deferred interpolation of a frame that produces output only for the rows or tiles a consumer
+// asks for. Nothing is computed up front, rows that are never requested cost nothing, and the
+// only memory owned is a small ring of recently produced rows.
+//
+// The inputs are borrowed: `a` and `b` must outlive this object.
+class LazyInterpolation {
+ public:
+  // Throws std::invalid_argument unless a.size() == b.size() == shape.elems().
+  LazyInterpolation(std::span<const float> a, std::span<const float> b, FrameShape shape,
+                    float t, std::size_t cached_rows = 4);
+
+  const FrameShape& shape() const { return shape_; }
+  float t() const { return t_; }
+
+  // Row y of the interpolated frame. The view stays valid until `cached_rows` other rows have
+  // been requested through row(). Repeated requests for a cached row are free.
+  std::span<const float> row(std::size_t y);
+
+  // Writes rows [y0, y0 + count) contiguously into dst without touching the row cache.
+  void read_rows(std::size_t y0, std::size_t count, std::span<float> dst) const;
+
+  // Writes the w x h tile at (x0, y0) into dst. dst_stride is the distance in elements between
+  // consecutive tile rows in dst; 0 means tightly packed (w * channels).
+  void read_tile(std::size_t x0, std::size_t y0, std::size_t w, std::size_t h,
+                 std::span<float> dst, std::size_t dst_stride = 0) const;
+
+  // Materializes the whole frame, equivalent to interpolate(a, b, t).
+  Frame materialize() const;
+
+  // Number of (possibly partial) rows computed so far; row() cache hits are not counted.
+  std::size_t rows_computed() const { return rows_computed_; }
+
+ private:
+  void compute_(std::size_t y, std::size_t x0, std::size_t n, float* dst) const;
+
+  std::span<const float> a_;
+  std::span<const float> b_;
+  FrameShape shape_;
+  float t_;
+
+  struct CachedRow {
+    std::size_t y = static_cast<std::size_t>(-1);
+    Vector<float, Subsystem::Scratch> data;
+  };
+  std::vector<CachedRow> cache_;
+  std::size_t next_slot_ = 0;
+  mutable std::size_t rows_computed_ = 0;
+};
+
+}  // namespace minfi
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace minfi {
+
+// Buckets that minfi's allocations are accounted to.
+enum class Subsystem : std::uint8_t {
+  Frames,   // Frame buffers: interpolation outputs, cubic windows, async results
+  Motion,   // motion-field vectors
+  Scratch,  // transient working buffers (row caches, luma planes)
+  Upload,   // viewer texture upload buffers
+};
+inline constexpr std::size_t kSubsystems = 4;
+
+const char* to_string(Subsystem subsystem);
+
+struct MemoryStats {
+  std::uint64_t current_bytes = 0;
+  std::uint64_t peak_bytes = 0;
+  std::uint64_t allocations = 0;
+  std::uint64_t deallocations = 0;
+};
+
+// Counters for one subsystem (lock-free snapshot; fields are read individually).
+MemoryStats memory_stats(Subsystem subsystem);
+std::array<MemoryStats, kSubsystems> memory_stats();
+// Lowers each subsystem's peak to its current usage.
+void reset_memory_peaks();
+
+// Routes a subsystem's allocations to `resource` (e.g. a std::pmr::monotonic_buffer_resource or
+// a pool); nullptr restores std::pmr::new_delete_resource(). Returns the previous resource.
+// Blocks already allocated remember where they came from, so switching at any time is safe;
+// the caller keeps `resource` alive until those blocks are freed.
+std::pmr::memory_resource* set_memory_resource(Subsystem subsystem,
+                                               std::pmr::memory_resource* resource);
+
+// The accounting resource of a subsystem, for callers that want their own pmr containers
+// counted alongside minfi's.
+std::pmr::memory_resource* tracked_resource(Subsystem subsystem);
+
+// Stateless standard allocator that allocates through tracked_resource(S). All instances compare
+// equal, so containers using it move and swap like ones using std::allocator.
+template <typename T, Subsystem S>
+class Allocator {
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = Allocator<U, S>;
+  };
+
+  Allocator() noexcept = default;
+  template <typename U>
+  Allocator(const Allocator<U, S>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(tracked_resource(S)->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    tracked_resource(S)->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  template <typename U>
+  friend bool operator==(const Allocator&, const Allocator<U, S>&) noexcept {
+    return true;
+  }
+};
+
+template <typename T, Subsystem S>
+using Vector = std::vector<T, Allocator<T, S>>;
+
+}  // namespace minfi
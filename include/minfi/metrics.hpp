@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace minfi {
+
+class Executor;
+class FrameCache;
+
+// Opt-in metrics for long-running services, rendered in the Prometheus text exposition format
+// (see MetricsServer in minfi/metrics_server.hpp for serving it). Updates are relaxed atomic
+// operations on the caller's thread, with no locks and no allocation; registration and
+// rendering take the registry lock.
+
+// Monotonic event count (frames produced, cache misses, ...).
+class Counter {
+ public:
+  void inc(std::uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+  std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+// Value that goes up and down (queue depth, frames in flight, ...).
+class Gauge {
+ public:
+  void set(std::int64_t v) { value_.store(v, std::memory_order_relaxed); }
+  void add(std::int64_t n) { value_.fetch_add(n, std::memory_order_relaxed); }
+  std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<std::int64_t> value_{0};
+};
+
+// Fixed-bucket histogram of non-negative integer samples (typically nanoseconds). record() is
+// a short search over the bounds plus two relaxed increments. A scrape reads buckets one by
+// one, so it may miss samples recorded during the scrape, never double count them.
+class Histogram {
+ public:
+  // Ascending inclusive upper bounds; samples above the last land in the +Inf bucket.
+  // Throws std::invalid_argument if `bounds` is empty or not strictly ascending.
+  explicit Histogram(std::vector<std::uint64_t> bounds);
+
+  // start, start * factor, ... (count bounds); factor > 1.
+  static std::vector<std::uint64_t> exponential_bounds(std::uint64_t start, double factor,
+                                                       std::size_t count);
+  // 1 us .. ~8.4 s in powers of two, for latencies recorded in nanoseconds.
+  static std::vector<std::uint64_t> latency_bounds_ns();
+
+  void record(std::uint64_t value);
+
+  const std::vector<std::uint64_t>& bounds() const { return bounds_; }
+  // Per-bucket (non-cumulative) counts; the last entry is the +Inf bucket.
+  std::vector<std::uint64_t> counts() const;
+  std::uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<std::uint64_t> bounds_;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> counts_;  // bounds_.size() + 1
+  std::atomic<std::uint64_t> sum_{0};
+};
+
+// Records the time from construction to destruction, in nanoseconds, into `histogram`.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram& histogram);
+  ~ScopedTimer();
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Histogram& histogram_;
+  std::int64_t start_ns_;
+};
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Owns metrics by name and label set. Registering an existing name and label set returns the
+// same metric, so independent components can look metrics up by name. References stay valid
+// for the registry's lifetime. Thread-safe.
+class MetricsRegistry {
+ public:
+  // Throws std::invalid_argument for names or label names Prometheus rejects, or if `name`
+  // is already registered as a different type.
+  Counter& counter(const std::string& name, const std::string& help,
+                   const MetricLabels& labels = {});
+  Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+  // `scale` multiplies bounds and sum when rendering, e.g. 1e-9 to export nanosecond samples in
+  // seconds as Prometheus convention asks. Re-registering ignores `bounds` and `scale`.
+  Histogram& histogram(const std::string& name, const std::string& help,
+                       const MetricLabels& labels = {},
+                       std::vector<std::uint64_t> bounds = Histogram::latency_bounds_ns(),
+                       double scale = 1e-9);
+  // Series computed at scrape time, for state a component already tracks (pool usage, cache
+  // hits). `read` runs under the registry lock and must not call back into the registry;
+  // registering the same series again replaces it.
+  void gauge_fn(const std::string& name, const std::string& help, const MetricLabels& labels,
+                std::function<double()> read);
+  void counter_fn(const std::string& name, const std::string& help, const MetricLabels& labels,
+                  std::function<double()> read);
+
+  // Every metric in the Prometheus text format (version 0.0.4), grouped by name.
+  std::string render() const;
+
+ private:
+  enum class Type : std::uint8_t { Counter, Gauge, Histogram };
+  struct Series {
+    MetricLabels labels;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+    std::function<double()> read;
+    double scale = 1.0;
+  };
+  struct Family {
+    std::string name;
+    std::string help;
+    Type type;
+    std::deque<Series> series;
+  };
+
+  static const char* type_name_(Type type);
+  Series& series_(const std::string& name, const std::string& help, Type type,
+                  const MetricLabels& labels, bool& created);
+
+  mutable std::mutex mutex_;
+  std::deque<Family> families_;  // registration order
+};
+
+// Scrape-time series for state minfi already tracks. The caller keeps `executor` and `cache`
+// alive for as long as the registry is rendered.
+//   minfi_memory_bytes{subsystem}, minfi_memory_peak_bytes{subsystem}
+void register_memory_metrics(MetricsRegistry& registry);
+//   minfi_executor_threads{executor}, minfi_executor_queue_depth{executor}
+void register_executor_metrics(MetricsRegistry& registry, const Executor& executor,
+                               const std::string& name);
+//   minfi_frame_cache_{bytes,entries}{cache},
+//   minfi_frame_cache_{hits,misses,evictions}_total{cache}
+void register_frame_cache_metrics(MetricsRegistry& registry, const FrameCache& cache,
+                                  const std::string& name);
+
+}  // namespace minfi
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "minfi/metrics.hpp"
+
+namespace minfi {
+
+// Serves MetricsRegistry::render() over HTTP for a local Prometheus scraper or curl, on a
+// loopback TCP port or a Unix domain socket (curl --unix-socket PATH http://localhost/metrics).
+// One background thread answers GET /metrics (and GET /) one connection at a time; nothing
+// runs on the threads that update metrics. Unix only.
+class MetricsServer {
+ public:
+  struct Options {
+    // Non-empty: listen on this Unix socket path (replacing a stale socket file) instead of TCP.
+    std::string unix_path;
+    // TCP listen address and port; port 0 picks a free port (see port()).
+    std::string address = "127.0.0.1";
+    std::uint16_t port = 9464;
+  };
+
+  // Throws std::runtime_error if the socket cannot be bound; std::invalid_argument if
+  // `address` is not a numeric IPv4 address.
+  MetricsServer(const MetricsRegistry& registry, Options options);
+  // Stops serving and removes the Unix socket file.
+  ~MetricsServer();
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  // Bound TCP port (0 when serving a Unix socket).
+  std::uint16_t port() const { return port_; }
+
+ private:
+  void run_();
+  void serve_(int client);
+
+  const MetricsRegistry& registry_;
+  Options options_;
+  int listen_fd_ = -1;
+  int wake_pipe_[2] = {-1, -1};
+  std::uint16_t port_ = 0;
+  std::thread thread_;
+};
+
+}  // namespace minfi
@@ -0,0 +1,121 @@
+/* Stable C API of minfi, for hosts that embed it through FFI (C, Rust, ...).
+ *
+ * Every function works on caller-owned buffers described by minfi_image, so host frames are
+ * read and written in place with no marshalling copies. Handles are opaque; a handle may be
+ * used from one thread at a time unless noted otherwise. No function throws: failures return
+ * a minfi_status and minfi_last_error() describes the most recent failure on the calling
+ * thread.
+ *
+ * The ABI only grows: structs are never changed in place, and MINFI_ABI_VERSION is bumped when
+ * functions are added. */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(MINFI_SHARED)
+#if defined(_WIN32)
+#if defined(MINFI_BUILDING)
+#define MINFI_API __declspec(dllexport)
+#else
+#define MINFI_API __declspec(dllimport)
+#endif
+#else
+#define MINFI_API __attribute__((visibility("default")))
+#endif
+#else
+#define MINFI_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MINFI_ABI_VERSION 1
+
+typedef enum minfi_status {
+  MINFI_OK = 0,
+  MINFI_ERROR_INVALID_ARGUMENT = 1, /* null pointer, shape/stride/type mismatch, ... */
+  MINFI_ERROR_OUT_OF_MEMORY = 2,
+  MINFI_ERROR_INTERNAL = 3,
+} minfi_status;
+
+typedef enum minfi_element {
+  MINFI_ELEMENT_F32 = 0,
+  MINFI_ELEMENT_U8 = 1,
+  MINFI_ELEMENT_U16 = 2,
+} minfi_element;
+
+/* A strided, interleaved, row-major image in caller memory: height rows of width * channels
+ * elements, consecutive rows row_stride bytes apart (0 = tightly packed). Inputs are only
+ * read; an output may alias an input of the same layout (in-place interpolation), except in
+ * minfi_motion_interpolate. */
+typedef struct minfi_image {
+  void* data;
+  uint32_t width;
+  uint32_t height;
+  uint32_t channels;
+  minfi_element element;
+  size_t row_stride;
+} minfi_image;
+
+/* Fixed-size worker pool that splits frames into row bands. Thread-safe: several threads may
+ * submit work through the same pool. */
+typedef struct minfi_pool minfi_pool;
+
+/* Block motion estimation context with a byte-bounded cache of motion fields. */
+typedef struct minfi_motion minfi_motion;
+
+typedef enum minfi_motion_sampling {
+  MINFI_MOTION_BLOCK = 0,  /* vector of the enclosing block */
+  MINFI_MOTION_SMOOTH = 1, /* bilinear blend of neighbouring block vectors */
+} minfi_motion_sampling;
+
+typedef struct minfi_motion_options {
+  uint32_t block;        /* block size in pixels (default 16) */
+  uint32_t search;       /* full-search radius in pixels (default 8) */
+  size_t cache_bytes;    /* motion field cache budget (default 64 MiB) */
+} minfi_motion_options;
+
+MINFI_API uint32_t minfi_abi_version(void);
+MINFI_API const char* minfi_status_string(minfi_status status);
+/* Message of the last failure on the calling thread; empty if none. Valid until the next
+ * failing call on this thread. */
+MINFI_API const char* minfi_last_error(void);
+
+/* threads == 0 selects the hardware concurrency. Returns NULL on failure. */
+MINFI_API minfi_pool* minfi_pool_create(uint32_t threads);
+/* Waits for running work; NULL is ignored. */
+MINFI_API void minfi_pool_destroy(minfi_pool* pool);
+MINFI_API uint32_t minfi_pool_thread_count(const minfi_pool* pool);
+
+/* out = a * (1 - t) + b * t per element, t clamped to [0, 1]; integer elements are rounded to
+ * nearest. All three images must share width, height, channels and element type. With a pool,
+ * rows are processed in parallel and the call returns when all are done; pool may be NULL.
+ * A NaN t is MINFI_ERROR_INVALID_ARGUMENT here and in the cubic and motion calls. */
+MINFI_API minfi_status minfi_interpolate(const minfi_image* a, const minfi_image* b,
+                                         const minfi_image* out, float t, minfi_pool* pool);
+
+/* Catmull-Rom interpolation between p1 and p2 with neighbours p0 and p3 (F32 only). */
+MINFI_API minfi_status minfi_interpolate_cubic(const minfi_image* p0, const minfi_image* p1,
+                                               const minfi_image* p2, const minfi_image* p3,
+                                               const minfi_image* out, float t,
+                                               minfi_pool* pool);
+
+/* options may be NULL for defaults; zero fields also select defaults. Returns NULL on
+ * failure. */
+MINFI_API minfi_motion* minfi_motion_create(const minfi_motion_options* options);
+MINFI_API void minfi_motion_destroy(minfi_motion* motion);
+
+/* Motion-compensated interpolation (F32, tightly packed rows). Motion from a to b is estimated
+ * on first use and cached under (id_a, id_b); pass ids that identify the frames (e.g. stream
+ * positions), or 0 to derive them from the frame contents. out must not overlap a or b
+ * (MINFI_ERROR_INVALID_ARGUMENT): warping reads inputs at displaced positions. */
+MINFI_API minfi_status minfi_motion_interpolate(minfi_motion* motion, const minfi_image* a,
+                                                uint64_t id_a, const minfi_image* b,
+                                                uint64_t id_b, const minfi_image* out, float t,
+                                                minfi_motion_sampling sampling);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/memory.hpp"
+#include "minfi/shape.hpp"
+
+namespace minfi {
+
+// Motion vectors are stored as 16-bit fixed point in units of 1 / kMotionScale pixel.
+inline constexpr int kMotionScale = 4;
+
+struct MotionVector {
+  std::int16_t dx = 0;
+  std::int16_t dy = 0;
+
+  friend constexpr bool operator==(const MotionVector&, const MotionVector&) = default;
+};
+
+// Non-owning view of a block motion field: cols x rows vectors in row-major order, one per
+// block x block pixel block. A vector v at a block means content at p in the first frame
+// appears at p + v in the second.
+struct MotionFieldView {
+  std::size_t cols = 0;
+  std::size_t rows = 0;
+  std::size_t block = 0;
+  const MotionVector* vectors = nullptr;
+
+  const MotionVector& at(std::size_t bx, std::size_t by) const { return vectors[by * cols + bx]; }
+};
+
+struct MotionField {
+  std::size_t cols = 0;
+  std::size_t rows = 0;
+  std::size_t block = 0;
+  Vector<MotionVector, Subsystem::Motion> vectors;
+
+  MotionFieldView view() const { return {cols, rows, block, vectors.data()}; }
+  std::size_t bytes() const { return vectors.size() * sizeof(MotionVector); }
+};
+
+struct MotionOptions {
+  std::size_t block = 16;  // block size in pixels
+  int search = 8;          // full-search radius in pixels
+
+  friend constexpr bool operator==(const MotionOptions&, const MotionOptions&) = default;
+};
+
+// Block-matching motion estimation from a to b: full search minimizing the sum of absolute
+// differences over the channel mean, ties resolved towards the zero vector.
+// Throws std::invalid_argument if the frames do not match `shape` or options are invalid.
+MotionField estimate_motion(std::span<const float> a, std::span<const float> b,
+                            const FrameShape& shape, const MotionOptions& options = {});
+
+// How the block field is sampled per output pixel.
+enum class MotionSampling {
+  Block,   // the vector of the enclosing block
+  Smooth,  // bilinear blend of the four nearest block vectors (dense, no block edges)
+};
+
+// Field vector, in pixels, at pixel (x, y) of the frame the field was estimated on.
+void sample_motion(const MotionFieldView& field, std::size_t x, std::size_t y,
+                   MotionSampling sampling, float& vx, float& vy);
+
+// Motion-compensated interpolation: each output pixel q takes its vector v from the field and
+// blends a(q - t v) with b(q + (1 - t) v), sampling both frames bilinearly with edge clamping.
+// With an all-zero field this equals the plain linear blend. t is clamped to [0, 1].
+void interpolate_motion_into(std::span<const float> a, std::span<const float> b,
+                             const FrameShape& shape, const MotionFieldView& field, float t,
+                             std::span<float> out,
+                             MotionSampling sampling = MotionSampling::Block);
+Frame interpolate_motion(const Frame& a, const Frame& b, const FrameShape& shape,
+                         const MotionFieldView& field, float t,
+                         MotionSampling sampling = MotionSampling::Block);
+
+}  // namespace minfi
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+#include "minfi/motion.hpp"
+
+namespace minfi {
+
+// Identity of an ordered pair of source frames. Ids are caller-defined (e.g. frame numbers in
+// a decoded stream); frame_id() derives one from frame contents when no better id exists.
+struct FramePairKey {
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+
+  friend constexpr bool operator==(const FramePairKey&, const FramePairKey&) = default;
+};
+
+struct FramePairKeyHash {
+  std::size_t operator()(const FramePairKey& k) const noexcept {
+    return static_cast<std::size_t>(k.a * 0x9e3779b97f4a7c15ull ^ (k.b + 0x632be59bd9b4e019ull));
+  }
+};
+
+// 64-bit FNV-1a hash of the frame's bytes.
+std::uint64_t frame_id(std::span<const float> frame);
+
+// Bounded LRU cache of estimated motion fields keyed by source-frame pair, so generating several
+// intermediate frames (or re-rendering after a seek) runs motion estimation once per pair.
+//
+// Fields are handed out as shared_ptr, so eviction never invalidates a field still in use. The
+// byte budget counts vector storage; a field larger than the whole budget is returned but not
+// retained. Thread-safe; concurrent misses on the same pair may both estimate.
+class MotionCache {
+ public:
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t bytes = 0;
+    std::size_t entries = 0;
+  };
+
+  explicit MotionCache(std::size_t byte_budget = 64u << 20);
+
+  // Cached field for `key` estimated with `options`, or nullptr. Counts a hit or a miss.
+  std::shared_ptr<const MotionField> find(const FramePairKey& key,
+                                          const MotionOptions& options = {});
+  // Whether find() would hit; does not count or refresh the entry.
+  bool contains(const FramePairKey& key, const MotionOptions& options = {}) const;
+  // Inserts (or replaces) the field for `key` and returns the shared copy.
+  std::shared_ptr<const MotionField> insert(const FramePairKey& key, MotionField field,
+                                            const MotionOptions& options = {});
+  // find(), falling back to estimate_motion(a, b, shape, options) and insert() on a miss.
+  std::shared_ptr<const MotionField> get_or_estimate(const FramePairKey& key,
+                                                     std::span<const float> a,
+                                                     std::span<const float> b,
+                                                     const FrameShape& shape,
+                                                     const MotionOptions& options = {});
+
+  void set_budget(std::size_t byte_budget);
+  std::size_t budget() const;
+  void clear();
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    FramePairKey key;
+    MotionOptions options;
+    std::shared_ptr<const MotionField> field;
+  };
+  using List = std::list<Entry>;
+
+  void evict_to_budget_();
+
+  mutable std::mutex mutex_;
+  std::size_t budget_;
+  List lru_;  // front = most recently used
+  std::unordered_map<FramePairKey, List::iterator, FramePairKeyHash> index_;
+  Stats stats_;
+};
+
+}  // namespace minfi
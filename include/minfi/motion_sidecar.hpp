@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "minfi/motion.hpp"
+#include "minfi/motion_cache.hpp"
+
+namespace minfi {
+
+namespace detail {
+struct SidecarIndexEntry;
+}  // namespace detail
+
+// On-disk sidecar of precomputed motion fields, one entry per (frame pair, MotionOptions), so
+// repeated renders of the same clip skip estimation.
+//
+// Layout (little-endian, version 1):
+//   64-byte header   magic "MIFIMVSC", version, entry count, index offset
+//   payloads         MotionVector arrays (int16 quarter-pixel), each 64-byte aligned,
+//                    stored raw or LZ4-compressed
+//   index            fixed 64-byte records sorted by (a, b, block, search)
+//
+// Lookups binary-search the index; uncompressed payloads are returned as views straight into
+// the mapping.
+enum class SidecarCodec : std::uint32_t {
+  None = 0,
+  Lz4 = 1,  // requires a build with MINFI_WITH_LZ4
+};
+
+class MotionSidecarWriter {
+ public:
+  // Truncates `path`. Throws std::invalid_argument if `codec` is not available in this build
+  // and std::runtime_error if the file cannot be created.
+  explicit MotionSidecarWriter(const std::string& path, SidecarCodec codec = SidecarCodec::None);
+  MotionSidecarWriter(const MotionSidecarWriter&) = delete;
+  MotionSidecarWriter& operator=(const MotionSidecarWriter&) = delete;
+  // Calls finish() if it has not run; errors are swallowed, call finish() to see them.
+  ~MotionSidecarWriter();
+
+  // Appends one field. Entries whose LZ4 form is not smaller are stored raw.
+  void add(const FramePairKey& key, const MotionFieldView& field,
+           const MotionOptions& options = {});
+  // Writes the index and header. Throws std::invalid_argument on duplicate entries.
+  void finish();
+
+  static bool supports(SidecarCodec codec);
+
+ private:
+  std::string path_;
+  SidecarCodec codec_;
+  std::ofstream out_;
+  std::uint64_t offset_ = 0;
+  std::vector<detail::SidecarIndexEntry> index_;
+  bool finished_ = false;
+};
+
+class MotionSidecar {
+ public:
+  // Maps `path` read-only and validates header and index. Throws std::runtime_error if the
+  // file is missing, truncated or not a compatible sidecar.
+  static MotionSidecar open(const std::string& path);
+
+  MotionSidecar(MotionSidecar&& other) noexcept;
+  MotionSidecar& operator=(MotionSidecar&& other) noexcept;
+  MotionSidecar(const MotionSidecar&) = delete;
+  MotionSidecar& operator=(const MotionSidecar&) = delete;
+  ~MotionSidecar();
+
+  std::size_t size() const { return count_; }
+  bool contains(const FramePairKey& key, const MotionOptions& options = {}) const;
+
+  // Zero-copy view into the mapping, valid while this object lives. nullopt when the entry is
+  // missing or stored compressed.
+  std::optional<MotionFieldView> view(const FramePairKey& key,
+                                      const MotionOptions& options = {}) const;
+  // Decoded copy of any entry, or nullptr when missing.
+  std::shared_ptr<const MotionField> load(const FramePairKey& key,
+                                          const MotionOptions& options = {}) const;
+
+ private:
+  using IndexEntry = detail::SidecarIndexEntry;
+
+  MotionSidecar(const std::byte* base, std::size_t bytes, bool mapped);
+  const char* validate_();  // nullptr if header and index are sound
+  const IndexEntry* find_(const FramePairKey& key, const MotionOptions& options) const;
+
+  const std::byte* base_ = nullptr;
+  std::size_t bytes_ = 0;
+  bool mapped_ = false;  // mmap'ed, or a heap copy where mmap is unavailable
+  const IndexEntry* index_ = nullptr;
+  std::size_t count_ = 0;
+};
+
+}  // namespace minfi
@@ -0,0 +1,98 @@
+#pragma once
+
+// OpenCV decoders for ParallelFrameSource. Header-only so minfi_core itself does not link
+// OpenCV; include this from targets that link ${OpenCV_LIBS}.
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minfi/frame_source.hpp"
+
+namespace minfi {
+
+struct OpenCvDecodeOptions {
+  PixelFormat format = PixelFormat::Rgb8;
+  // Resize every frame to width x height (bilinear); 0 keeps the decoded size.
+  std::size_t width = 0;
+  std::size_t height = 0;
+};
+
+namespace detail {
+
+// Converts a decoded BGR Mat into `out`, resizing first when requested. Runs on a decode thread.
+inline void store_bgr(const cv::Mat& bgr, const OpenCvDecodeOptions& options, DecodeTarget& out) {
+  cv::Mat src = bgr;
+  if (options.width && options.height &&
+      (src.cols != static_cast<int>(options.width) ||
+       src.rows != static_cast<int>(options.height))) {
+    cv::resize(bgr, src,
+               cv::Size(static_cast<int>(options.width), static_cast<int>(options.height)), 0, 0,
+               cv::INTER_LINEAR);
+  }
+  const bool rgba = options.format == PixelFormat::Rgba8;
+  const MutablePackedImageView view = out.reshape(static_cast<std::size_t>(src.cols),
+                                                  static_cast<std::size_t>(src.rows),
+                                                  options.format);
+  // Convert straight into the pooled buffer rather than into a temporary Mat.
+  cv::Mat dst(src.rows, src.cols, rgba ? CV_8UC4 : CV_8UC3, view.data, view.row_bytes());
+  cv::cvtColor(src, dst, rgba ? cv::COLOR_BGR2RGBA : cv::COLOR_BGR2RGB);
+}
+
+}  // namespace detail
+
+// One still image per frame, decoded independently, so every decode thread runs cv::imread in
+// parallel. Throws std::runtime_error (through next()) for files OpenCV cannot read.
+inline DecodeFn image_sequence_decoder(std::vector<std::string> paths,
+                                       OpenCvDecodeOptions options = {}) {
+  return [paths = std::move(paths), options](std::size_t index, DecodeTarget& out) {
+    if (index >= paths.size()) return false;
+    const cv::Mat bgr = cv::imread(paths[index], cv::IMREAD_COLOR);
+    if (bgr.empty()) {
+      throw std::runtime_error("image_sequence_decoder: failed to load '" + paths[index] + "'");
+    }
+    detail::store_bgr(bgr, options, out);
+    return true;
+  };
+}
+
+// A cv::VideoCapture stream. The capture itself decodes serially, so reads take turns in index
+// order; colour conversion and resizing of earlier frames overlap with the next read. Use with
+// ParallelFrameSource::kUnknownCount, or CAP_PROP_FRAME_COUNT when the container reports it.
+inline DecodeFn video_decoder(std::shared_ptr<cv::VideoCapture> capture,
+                              OpenCvDecodeOptions options = {}) {
+  if (!capture || !capture->isOpened()) {
+    throw std::invalid_argument("video_decoder: capture is not open");
+  }
+  struct Turn {
+    std::shared_ptr<cv::VideoCapture> capture;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t next = 0;
+    bool ended = false;
+  };
+  auto turn = std::make_shared<Turn>();
+  turn->capture = std::move(capture);
+  return [turn, options](std::size_t index, DecodeTarget& out) {
+    cv::Mat bgr;
+    {
+      std::unique_lock<std::mutex> lock(turn->mutex);
+      turn->cv.wait(lock, [&] { return turn->next == index; });
+      if (!turn->ended && !turn->capture->read(bgr)) turn->ended = true;
+      ++turn->next;
+    }
+    turn->cv.notify_all();
+    if (bgr.empty()) return false;
+    detail::store_bgr(bgr, options, out);
+    return true;
+  };
+}
+
+}  // namespace minfi
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "minfi/frame_reader.hpp"
+
+namespace minfi {
+
+enum class OutOfCoreInput : std::uint8_t {
+  Reader,  // RawFrameReader: io_uring or pread, O_DIRECT when aligned
+  Mmap,    // read-only mappings, prefetched one chunk ahead and dropped behind
+};
+
+struct OutOfCoreOptions {
+  // Upper bound on the buffer memory minfi allocates (input chunks, output chunks); resident
+  // mapped pages count towards it in Mmap mode. Page-cache use by the kernel is not included.
+  std::size_t memory_limit = 256u << 20;
+  // Bytes per chunk, a multiple of 4 KiB; 0 picks the largest chunk that fits memory_limit.
+  std::size_t chunk_bytes = 0;
+  OutOfCoreInput input = OutOfCoreInput::Reader;
+  // Byte offset of the first sample in both inputs (e.g. a file header); a multiple of 4.
+  std::size_t input_offset = 0;
+  // Reader mode: readahead per input, backend and O_DIRECT. header_bytes is ignored.
+  FrameReaderOptions reader = {1, true, ReadBackend::Auto, 2, 0};
+  // Output chunks being filled or written; 2 double-buffers compute against writes.
+  std::size_t write_buffers = 2;
+};
+
+struct OutOfCoreStats {
+  std::uint64_t chunks = 0;
+  std::uint64_t bytes = 0;  // output bytes written
+  std::size_t chunk_bytes = 0;
+  std::size_t buffer_bytes = 0;  // buffer memory implied by the chunk size (<= memory_limit)
+  std::uint64_t read_wait_ns = 0;   // waiting for input chunks (Reader mode)
+  std::uint64_t write_wait_ns = 0;  // compute waiting for a free output chunk
+  std::uint64_t compute_ns = 0;
+};
+
+// out = interpolate(a, b, t) for float32 arrays stored in files, without holding them in
+// memory: inputs stream in chunks while earlier chunks are interpolated (with the active
+// tuning, minfi/tuning.hpp) and written to `out_path` on a writer thread. `out_path` is created
+// or truncated and holds only samples.
+//
+// Throws std::invalid_argument if the inputs hold different sample counts, are not a whole
+// number of floats, input_offset is not a multiple of 4, or memory_limit cannot fit one 4 KiB
+// chunk per buffer; std::runtime_error on I/O errors.
+OutOfCoreStats interpolate_files(const std::string& a_path, const std::string& b_path,
+                                 const std::string& out_path, float t,
+                                 const OutOfCoreOptions& options = {});
+
+}  // namespace minfi
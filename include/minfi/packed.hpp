@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace minfi {
+
+// 8-bit interleaved pixel layouts as produced by decoders and consumed by texture uploads.
+enum class PixelFormat : std::uint8_t {
+  Rgb8,
+  Rgba8,
+};
+
+constexpr std::size_t bytes_per_pixel(PixelFormat format) {
+  return format == PixelFormat::Rgba8 ? 4 : 3;
+}
+
+// Strided view of a packed 8-bit image. stride is the distance between rows in bytes; 0 means
+// tightly packed (width * bytes_per_pixel).
+template <typename Byte>
+struct BasicPackedImage {
+  Byte* data = nullptr;
+  std::size_t width = 0;
+  std::size_t height = 0;
+  PixelFormat format = PixelFormat::Rgb8;
+  std::size_t stride = 0;
+
+  std::size_t row_bytes() const { return stride ? stride : width * bytes_per_pixel(format); }
+  Byte* row(std::size_t y) const { return data + y * row_bytes(); }
+
+  // A mutable view converts to a read-only one.
+  operator BasicPackedImage<const Byte>() const
+    requires(!std::is_const_v<Byte>)
+  {
+    return {data, width, height, format, stride};
+  }
+};
+using PackedImageView = BasicPackedImage<const std::uint8_t>;
+using MutablePackedImageView = BasicPackedImage<std::uint8_t>;
+
+// Fused u8 -> blend -> u8 interpolation: every output pixel is read, blended and packed in one
+// pass straight from the decoded inputs into the final layout, with no float frame, no
+// converted copy and no separate alpha-expansion pass.
+//
+// Channels are blended as interpolate_into<uint8_t> does (float weight, round to nearest), so an
+// Rgb8 -> Rgb8 call matches it bit for bit. An Rgb8 source written to Rgba8 gets opaque alpha
+// (255); an Rgba8 source written to Rgb8 drops alpha. Both inputs must share a format; t is
+// clamped to [0, 1].
+//
+// Throws std::invalid_argument if the inputs differ in size or format, the output size differs,
+// or a stride is smaller than a row.
+void interpolate_packed_into(const PackedImageView& a, const PackedImageView& b,
+                             const MutablePackedImageView& out, float t);
+
+// Rows [y0, y0 + rows) only, for producers that fill an output band at a time (e.g. a texture
+// upload buffer); row i of the band goes to out.row(i), so `out` describes the band.
+void interpolate_packed_rows(const PackedImageView& a, const PackedImageView& b,
+                             const MutablePackedImageView& out, float t, std::size_t y0,
+                             std::size_t rows);
+
+std::vector<std::uint8_t> interpolate_packed(const PackedImageView& a, const PackedImageView& b,
+                                             PixelFormat out_format, float t);
+
+}  // namespace minfi
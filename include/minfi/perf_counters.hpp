@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+namespace minfi {
+
+// Hardware and kernel event counters (Linux perf_event_open) for telling memory-bound kernels
+// from front-end or page-fault bound ones in benchmarks.
+enum class PerfEvent : std::uint8_t {
+  Cycles,
+  Instructions,
+  LlcMisses,   // last-level cache read misses
+  DtlbMisses,  // data TLB read misses
+  PageFaults,  // software event, usually available even without a PMU
+};
+inline constexpr std::size_t kPerfEventCount = 5;
+
+std::string_view to_string(PerfEvent event);
+
+// One reading of every counter. Counters that could not be opened read as invalid; values of
+// multiplexed counters are scaled to the full interval.
+struct PerfSample {
+  std::array<std::uint64_t, kPerfEventCount> values{};
+  std::array<bool, kPerfEventCount> valid{};
+  std::uint64_t time_ns = 0;
+
+  std::uint64_t operator[](PerfEvent e) const { return values[static_cast<std::size_t>(e)]; }
+  bool has(PerfEvent e) const { return valid[static_cast<std::size_t>(e)]; }
+};
+
+// Counters for the calling thread, opened once and left running; zones read them on entry and
+// exit, so zones nest freely. Counters the kernel refuses (no PMU in a VM or container,
+// perf_event_paranoid, non-Linux builds) are skipped individually and never throw; check
+// available() or PerfSample::has() before trusting a value.
+//
+// Counts only the thread that constructed the object (and no other threads it starts).
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool available(PerfEvent e) const { return fds_[static_cast<std::size_t>(e)] >= 0; }
+  bool any_available() const;
+
+  // Cumulative counts since construction.
+  PerfSample read() const;
+
+ private:
+  std::array<int, kPerfEventCount> fds_;
+};
+
+// Per-zone totals over any number of calls.
+class PerfStats {
+ public:
+  // Adds the difference between two readings as one call.
+  void add(const PerfSample& begin, const PerfSample& end);
+  void reset() { *this = PerfStats(); }
+
+  std::uint64_t calls() const { return calls_; }
+  bool has(PerfEvent e) const { return calls_ > 0 && valid_[static_cast<std::size_t>(e)]; }
+  std::uint64_t total(PerfEvent e) const { return totals_[static_cast<std::size_t>(e)]; }
+  std::uint64_t time_ns() const { return time_ns_; }
+
+  double per_call(PerfEvent e) const;
+  // total / (calls * units_per_call), e.g. elements or bytes processed by each call.
+  double per_unit(PerfEvent e, double units_per_call) const;
+  // Instructions per cycle; 0 unless both counters are available.
+  double ipc() const;
+
+  // One line per available event: total, per call, per element and per byte; notes the
+  // events that were unavailable.
+  void report(std::ostream& os, double elems_per_call, double bytes_per_call) const;
+
+ private:
+  std::array<std::uint64_t, kPerfEventCount> totals_{};
+  std::array<bool, kPerfEventCount> valid_{};
+  std::uint64_t calls_ = 0;
+  std::uint64_t time_ns_ = 0;
+};
+
+// Adds the counters between construction and destruction to `stats` as one call.
+class PerfZone {
+ public:
+  PerfZone(const PerfCounters& counters, PerfStats& stats)
+      : counters_(counters), stats_(stats), begin_(counters.read()) {}
+  ~PerfZone() { stats_.add(begin_, counters_.read()); }
+  PerfZone(const PerfZone&) = delete;
+  PerfZone& operator=(const PerfZone&) = delete;
+
+ private:
+  const PerfCounters& counters_;
+  PerfStats& stats_;
+  PerfSample begin_;
+};
+
+}  // namespace minfi
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include "minfi/memory.hpp"
+
+namespace minfi {
+
+struct PresentStats {
+  std::uint64_t published = 0;  // frames handed over by the producer
+  std::uint64_t presented = 0;  // frames the consumer finished with
+  std::uint64_t dropped = 0;    // frames replaced by a newer one before being taken
+};
+
+// Triple-buffered latest-frame slot between one producer and one consumer (mailbox semantics):
+// the producer fills back() and publish()es it without ever waiting; the consumer take()s the
+// newest published frame. A frame published while the previous one is still untaken replaces
+// it, and the replaced frame counts as dropped. Buffers are swapped, never copied, and
+// allocated once (Subsystem::Upload).
+class FrameMailbox {
+ public:
+  explicit FrameMailbox(std::size_t frame_bytes);
+
+  FrameMailbox(const FrameMailbox&) = delete;
+  FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+  std::size_t frame_bytes() const { return frame_bytes_; }
+
+  // Producer side. The span stays valid until the next publish().
+  std::span<std::uint8_t> back() { return {back_->data(), frame_bytes_}; }
+  void publish();
+
+  // Consumer side: waits up to `timeout` for a frame newer than the last one taken. The span
+  // stays valid until the next take(). Returns nullopt on timeout or once closed.
+  std::optional<std::span<const std::uint8_t>> take(std::chrono::nanoseconds timeout);
+  // Marks the frame returned by the last take() as presented (for stats and wait_presented).
+  void done();
+
+  // Wakes a waiting take() and makes every later take() return nullopt.
+  void close();
+  bool closed() const;
+
+  // Waits until every published frame has been presented or dropped.
+  bool wait_presented(std::chrono::nanoseconds timeout);
+
+  PresentStats stats() const;
+
+ private:
+  using Buffer = Vector<std::uint8_t, Subsystem::Upload>;
+
+  std::size_t frame_bytes_;
+  Buffer buffers_[3];
+  Buffer* back_ = &buffers_[0];    // owned by the producer
+  Buffer* middle_ = &buffers_[1];  // latest published, shared
+  Buffer* front_ = &buffers_[2];   // owned by the consumer
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool fresh_ = false;  // middle_ holds a frame not yet taken
+  bool closed_ = false;
+  PresentStats stats_;
+};
+
+// Consumer of presented frames, called on the Presenter's thread. present() must not throw.
+class PresentSink {
+ public:
+  virtual ~PresentSink() = default;
+  virtual void present(std::span<const std::uint8_t> frame) = 0;
+};
+
+// Owns a presentation thread that feeds the newest published frame to a sink, so a slow sink
+// (e.g. a vsync-locked swap chain) never throttles the producer; frames the sink cannot keep
+// up with are dropped instead of queued:
+//
+//   minfi::Presenter presenter(sink, width * height * 4);
+//   for (;;) {
+//     render_into(presenter.back());
+//     presenter.publish();  // returns immediately
+//   }
+class Presenter {
+ public:
+  Presenter(PresentSink& sink, std::size_t frame_bytes);
+  // Stops after the frame being presented, if any; frames still unpresented are discarded.
+  ~Presenter();
+
+  Presenter(const Presenter&) = delete;
+  Presenter& operator=(const Presenter&) = delete;
+
+  std::span<std::uint8_t> back() { return mailbox_.back(); }
+  void publish() { mailbox_.publish(); }
+
+  // Waits until the sink has seen the newest published frame (or it was dropped in favour of a
+  // newer one that has been presented).
+  bool flush(std::chrono::nanoseconds timeout = std::chrono::seconds(1)) {
+    return mailbox_.wait_presented(timeout);
+  }
+
+  PresentStats stats() const { return mailbox_.stats(); }
+
+ private:
+  void run_();
+
+  PresentSink& sink_;
+  FrameMailbox mailbox_;
+  std::thread thread_;
+};
+
+}  // namespace minfi
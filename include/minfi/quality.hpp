@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "minfi/shape.hpp"
+
+namespace minfi {
+
+// Full-reference image quality metrics for judging interpolated frames against ground truth.
+// Both take float samples whose nominal range is [0, peak].
+
+// Mean squared error over every sample. Throws std::invalid_argument on size mismatch.
+double mse(std::span<const float> a, std::span<const float> b);
+
+// Peak signal-to-noise ratio in dB, 10 log10(peak^2 / mse); +infinity for identical inputs.
+// Throws std::invalid_argument on size mismatch or a non-positive peak.
+double psnr(std::span<const float> a, std::span<const float> b, float peak = 1.0f);
+
+struct SsimOptions {
+  std::size_t window = 8;  // square window side in pixels (uniform weights)
+  std::size_t stride = 4;  // window step in pixels; equal to window for disjoint windows
+  float peak = 1.0f;       // dynamic range L, giving C1 = (0.01 L)^2 and C2 = (0.03 L)^2
+};
+
+// Mean structural similarity over all windows and channels, in [-1, 1] (1 for identical
+// frames). Each channel is scored separately on windows that fit inside the frame; frames
+// smaller than one window are scored as a single window.
+// Throws std::invalid_argument if the frames do not match `shape` or options are invalid.
+double ssim(std::span<const float> a, std::span<const float> b, const FrameShape& shape,
+            const SsimOptions& options = {});
+
+}  // namespace minfi
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace minfi {
+
+// Dimensions of an interleaved, row-major frame (e.g. H x W x C for RGB).
+struct FrameShape {
+  std::size_t width = 0;
+  std::size_t height = 0;
+  std::size_t channels = 1;
+
+  constexpr std::size_t row_elems() const { return width * channels; }
+  constexpr std::size_t elems() const { return row_elems() * height; }
+
+  friend constexpr bool operator==(const FrameShape&, const FrameShape&) = default;
+};
+
+}  // namespace minfi
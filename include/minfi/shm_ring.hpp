@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace minfi {
+
+// Single-producer / single-consumer ring of fixed-size float frames in POSIX shared memory
+// (shm_open + mmap), for handing frames between processes without copying.
+//
+// Slot payloads are 64-byte aligned spans that can be passed directly to
+// minfi::interpolate_into as inputs or output. Producer and consumer coordinate through two
+// 32-bit atomic counters in the shared header; a waiting side sleeps on a futex (Linux) or
+// polls with a short sleep elsewhere, and the other side only issues a wake syscall when it
+// sees a waiter.
+//
+// Typical consumer loop interpolating consecutive pairs in place:
+//
+//   ring.wait_readable(2);
+//   minfi::interpolate_into<float>(ring.read(0), ring.read(1), out, t);
+//   ring.release(1);  // frame n+1 stays for the next pair
+class ShmFrameRing {
+ public:
+  // Per-slot metadata written by the producer.
+  struct SlotMeta {
+    std::uint64_t sequence = 0;     // publish counter value of this frame
+    std::int64_t timestamp_ns = 0;  // producer-supplied, e.g. capture time (steady clock)
+  };
+
+  // Creates (or replaces) the segment `name`. `slots` is rounded up to a power of two. The
+  // creating side unlinks the segment on destruction.
+  static ShmFrameRing create(const std::string& name, std::size_t slots, std::size_t frame_elems);
+  // Maps an existing segment created by another process.
+  static ShmFrameRing open(const std::string& name);
+
+  ShmFrameRing(ShmFrameRing&& other) noexcept;
+  ShmFrameRing& operator=(ShmFrameRing&& other) noexcept;
+  ShmFrameRing(const ShmFrameRing&) = delete;
+  ShmFrameRing& operator=(const ShmFrameRing&) = delete;
+  ~ShmFrameRing();
+
+  std::size_t slots() const;
+  std::size_t frame_elems() const;
+
+  // Producer side. acquire_write returns the next free slot, or an empty span when the ring
+  // stays full for `timeout`; the slot becomes visible to the consumer on publish().
+  std::span<float> try_acquire_write();
+  std::span<float> acquire_write(std::chrono::milliseconds timeout = kForever);
+  void publish(std::int64_t timestamp_ns = 0);
+
+  // Consumer side. read(i) is the i-th oldest unreleased frame; read() and meta() throw
+  // std::out_of_range unless i < readable(), release() std::invalid_argument if n > readable().
+  std::size_t readable() const;
+  bool wait_readable(std::size_t n, std::chrono::milliseconds timeout = kForever);
+  std::span<const float> read(std::size_t i) const;
+  const SlotMeta& meta(std::size_t i) const;
+  void release(std::size_t n = 1);
+
+  static constexpr std::chrono::milliseconds kForever{-1};
+
+ private:
+  struct Header;
+
+  ShmFrameRing(std::string name, void* base, std::size_t bytes, bool owner);
+  std::byte* slot_(std::uint32_t counter) const;
+
+  std::string name_;
+  void* base_ = nullptr;
+  std::size_t bytes_ = 0;
+  bool owner_ = false;
+  Header* header_ = nullptr;
+};
+
+}  // namespace minfi
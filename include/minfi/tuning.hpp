@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace minfi {
+
+// Inner loop used by the tuned float path. Both produce bit-identical results.
+enum class KernelVariant : std::uint8_t {
+  Flat,       // cache-allocating loop (interpolate_into<float>)
+  Streaming,  // non-temporal stores that bypass the cache; Flat where SSE2 is unavailable
+};
+
+const char* to_string(KernelVariant kernel);
+std::optional<KernelVariant> parse_kernel_variant(std::string_view name);
+
+// Execution settings for frames of at least min_elems elements.
+struct TuningEntry {
+  std::size_t min_elems = 0;
+  std::size_t tile_elems = 0;  // work item size; 0 splits the frame evenly across threads
+  std::size_t threads = 1;     // including the calling thread
+  KernelVariant kernel = KernelVariant::Flat;
+
+  friend bool operator==(const TuningEntry&, const TuningEntry&) = default;
+};
+
+// Tuned settings by frame size: the entry with the largest min_elems <= size applies.
+struct TuningConfig {
+  std::vector<TuningEntry> entries;
+
+  // Serial Flat kernel when no entry matches.
+  TuningEntry select(std::size_t elems) const;
+
+  friend bool operator==(const TuningConfig&, const TuningConfig&) = default;
+};
+
+// Config file format (text, one entry per line, '#' starts a comment):
+//
+//   minfi-tuning 1
+//   <min_elems> <tile_elems> <threads> <flat|streaming>
+//
+// load_tuning throws std::runtime_error if the file cannot be read or is malformed;
+// save_tuning throws std::runtime_error if it cannot be written.
+TuningConfig load_tuning(const std::filesystem::path& path);
+void save_tuning(const TuningConfig& config, const std::filesystem::path& path);
+
+// $MINFI_TUNING_FILE if set, else $XDG_CONFIG_HOME/minfi/tuning.conf, else
+// $HOME/.config/minfi/tuning.conf; empty if none of these variables is set.
+std::filesystem::path default_tuning_path();
+
+// Process-wide configuration used by interpolate(). On first use it is loaded from
+// default_tuning_path(); a missing or malformed file leaves the built-in serial defaults.
+// Reads are lock-free after each thread's first call following a set_active_tuning().
+std::shared_ptr<const TuningConfig> active_tuning();
+void set_active_tuning(TuningConfig config);
+
+// out = interpolate(a, b, t) executed with `config`: tiles are claimed dynamically by the
+// calling thread and up to threads - 1 helpers on default_executor(). The caller never waits
+// for a helper that has not started, so this is safe to call from executor tasks.
+// Throws std::invalid_argument on size mismatch.
+void interpolate_tuned_into(std::span<const float> a, std::span<const float> b,
+                            std::span<float> out, float t, const TuningEntry& config);
+
+namespace detail {
+
+// Blends n elements with the already clamped weight w using `kernel`.
+void blend_range(KernelVariant kernel, const float* a, const float* b, float* out,
+                 std::size_t n, float w);
+
+// active_tuning() without the shared_ptr copy, for per-call use. The reference stays valid
+// until this thread's next call after set_active_tuning().
+const TuningConfig& cached_active_tuning();
+
+// Calls body(i) for every i in [0, count) on the calling thread and up to threads - 1 helpers
+// on default_executor(), returning once all calls have finished.
+void run_tiles(std::size_t count, std::size_t threads,
+               const std::function<void(std::size_t)>& body);
+
+}  // namespace detail
+
+struct CalibrationOptions {
+  // Representative frame sizes in elements; each becomes one entry.
+  std::vector<std::size_t> frame_elems = {1u << 14, 1u << 18, 1920u * 1080u * 3u};
+  std::vector<std::size_t> tile_elems = {0, 1u << 12, 1u << 14, 1u << 16, 1u << 18};
+  // Empty: powers of two up to the hardware concurrency, plus the concurrency itself.
+  std::vector<std::size_t> threads;
+  std::vector<KernelVariant> kernels = {KernelVariant::Flat, KernelVariant::Streaming};
+  int repeats = 5;  // timed runs per candidate; the fastest counts
+};
+
+// Benchmarks every candidate on each frame size and returns the fastest per size. Entry
+// boundaries lie at the geometric mean of neighbouring sizes.
+TuningConfig calibrate(const CalibrationOptions& options = {});
+
+}  // namespace minfi
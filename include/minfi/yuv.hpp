@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "minfi/motion.hpp"
+
+namespace minfi {
+
+// 8-bit YUV 4:2:0 layouts. Chroma planes are ceil(width / 2) x ceil(height / 2) samples.
+enum class YuvLayout : std::uint8_t {
+  I420,  // three planes: Y, U, V
+  NV12,  // two planes: Y, interleaved UV
+};
+
+// Planar view of one YUV 4:2:0 frame. For NV12, `u` points at the interleaved UV plane and `v`
+// is unused. Strides are in bytes; 0 means tightly packed.
+template <typename Byte>
+struct BasicYuvImage {
+  YuvLayout layout = YuvLayout::I420;
+  std::size_t width = 0;
+  std::size_t height = 0;
+  Byte* y = nullptr;
+  Byte* u = nullptr;
+  Byte* v = nullptr;
+  std::size_t y_stride = 0;
+  std::size_t uv_stride = 0;
+
+  std::size_t chroma_width() const { return (width + 1) / 2; }
+  std::size_t chroma_height() const { return (height + 1) / 2; }
+  // Bytes per chroma row actually used: one plane row for I420, interleaved pairs for NV12.
+  std::size_t chroma_row_bytes() const {
+    return chroma_width() * (layout == YuvLayout::NV12 ? 2 : 1);
+  }
+  std::size_t y_pitch() const { return y_stride ? y_stride : width; }
+  std::size_t uv_pitch() const { return uv_stride ? uv_stride : chroma_row_bytes(); }
+
+  // A mutable view converts to a read-only one.
+  operator BasicYuvImage<const Byte>() const
+    requires(!std::is_const_v<Byte>)
+  {
+    return {layout, width, height, y, u, v, y_stride, uv_stride};
+  }
+};
+using YuvImageView = BasicYuvImage<const std::uint8_t>;
+using MutableYuvImageView = BasicYuvImage<std::uint8_t>;
+
+// Size of a tightly packed frame (planes back to back, as most decoders and encoders exchange).
+std::size_t yuv420_frame_bytes(std::size_t width, std::size_t height);
+// Views over a tightly packed frame of yuv420_frame_bytes(width, height) bytes.
+YuvImageView yuv420_view(YuvLayout layout, const std::uint8_t* data, std::size_t width,
+                         std::size_t height);
+MutableYuvImageView yuv420_view(YuvLayout layout, std::uint8_t* data, std::size_t width,
+                                std::size_t height);
+
+// Per-plane linear interpolation in the native layout: luma at full resolution, chroma at its
+// subsampled size (NV12 UV pairs blended as independent samples). Samples are rounded as
+// interpolate_into<uint8_t> does; t is clamped to [0, 1]. The output keeps the input layout.
+// Throws std::invalid_argument if sizes or layouts differ or a stride is smaller than a row.
+void interpolate_yuv_into(const YuvImageView& a, const YuvImageView& b,
+                          const MutableYuvImageView& out, float t);
+std::vector<std::uint8_t> interpolate_yuv(YuvLayout layout, const std::vector<std::uint8_t>& a,
+                                          const std::vector<std::uint8_t>& b, std::size_t width,
+                                          std::size_t height, float t);
+
+// Block motion estimation on the luma plane.
+MotionField estimate_motion_yuv(const YuvImageView& a, const YuvImageView& b,
+                                const MotionOptions& options = {});
+
+// Motion-compensated interpolation with a field estimated on luma. Chroma sample (x, y) takes
+// the vector of luma pixel (2x, 2y), halved to chroma units.
+void interpolate_yuv_motion_into(const YuvImageView& a, const YuvImageView& b,
+                                 const MutableYuvImageView& out, const MotionFieldView& field,
+                                 float t, MotionSampling sampling = MotionSampling::Block);
+
+}  // namespace minfi
@@ -0,0 +1,123 @@
+#include "minfi/adaptive.hpp"
+
+#include <stdexcept>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+namespace {
+
+std::size_t index_of(QualityTier tier) { return static_cast<std::size_t>(tier); }
+
+}  // namespace
+
+const char* to_string(QualityTier tier) {
+  switch (tier) {
+    case QualityTier::Linear:
+      return "linear";
+    case QualityTier::Block:
+      return "block";
+    case QualityTier::Dense:
+      return "dense";
+  }
+  return "unknown";
+}
+
+AdaptiveInterpolator::AdaptiveInterpolator(FrameShape shape, AdaptiveOptions options)
+    : shape_(shape), options_(options), motion_cache_(options.motion_cache_bytes) {
+  if (shape_.elems() == 0) {
+    throw std::invalid_argument("AdaptiveInterpolator: empty frame shape");
+  }
+  if (!(options_.headroom > 0.0 && options_.headroom <= 1.0) ||
+      !(options_.cost_alpha > 0.0 && options_.cost_alpha <= 1.0) ||
+      index_of(options_.max_tier) >= kQualityTiers) {
+    throw std::invalid_argument("AdaptiveInterpolator: invalid options");
+  }
+}
+
+void AdaptiveInterpolator::reset_model() {
+  stats_.tier_cost = {};
+  stats_.estimate_cost = {};
+  stats_.ceiling = QualityTier::Linear;
+  on_time_streak_ = 0;
+}
+
+void AdaptiveInterpolator::record_(Clock::duration& average, Clock::duration sample) const {
+  if (average == Clock::duration::zero()) {
+    average = sample;
+    return;
+  }
+  const double mixed = options_.cost_alpha * static_cast<double>(sample.count()) +
+                       (1.0 - options_.cost_alpha) * static_cast<double>(average.count());
+  average = Clock::duration(static_cast<Clock::rep>(mixed));
+}
+
+QualityTier AdaptiveInterpolator::choose(const FramePairKey& key, Clock::duration budget) const {
+  if (budget <= Clock::duration::zero()) return QualityTier::Linear;
+  const double allowed = options_.headroom * static_cast<double>(budget.count());
+  // Peek without touching the cache's LRU order or hit counters.
+  const bool have_field = motion_cache_.contains(key, options_.motion);
+  for (std::size_t i = index_of(stats_.ceiling); i > 0; --i) {
+    const Clock::duration warp = stats_.tier_cost[i];
+    // A tier that was never measured is only tried once the ceiling was raised to it.
+    if (warp == Clock::duration::zero() && i != index_of(stats_.ceiling)) continue;
+    const Clock::duration predicted = warp + (have_field ? Clock::duration::zero()
+                                                         : stats_.estimate_cost);
+    if (static_cast<double>(predicted.count()) <= allowed) return static_cast<QualityTier>(i);
+  }
+  return QualityTier::Linear;
+}
+
+AdaptiveInterpolator::Result AdaptiveInterpolator::interpolate_into(
+    const FramePairKey& key, std::span<const float> a, std::span<const float> b, float t,
+    std::span<float> out, Clock::time_point deadline) {
+  if (a.size() != shape_.elems() || b.size() != shape_.elems() || out.size() != shape_.elems()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  const Clock::time_point start = Clock::now();
+  Result r;
+  r.tier = choose(key, deadline - start);
+
+  if (r.tier == QualityTier::Linear) {
+    minfi::interpolate_into<float>(a, b, out, t);
+  } else {
+    auto field = motion_cache_.find(key, options_.motion);
+    Clock::time_point warp_start = start;
+    if (!field) {
+      field = motion_cache_.insert(key, estimate_motion(a, b, shape_, options_.motion),
+                                   options_.motion);
+      warp_start = Clock::now();
+      record_(stats_.estimate_cost, warp_start - start);
+      ++stats_.estimations;
+    }
+    interpolate_motion_into(a, b, shape_, field->view(), t, out,
+                            r.tier == QualityTier::Dense ? MotionSampling::Smooth
+                                                         : MotionSampling::Block);
+    record_(stats_.tier_cost[index_of(r.tier)], Clock::now() - warp_start);
+  }
+
+  const Clock::time_point end = Clock::now();
+  if (r.tier == QualityTier::Linear) record_(stats_.tier_cost[0], end - start);
+  r.elapsed = end - start;
+  r.met_deadline = end <= deadline;
+  ++stats_.frames[index_of(r.tier)];
+
+  if (!r.met_deadline) {
+    ++stats_.deadline_misses;
+    on_time_streak_ = 0;
+    if (stats_.ceiling != QualityTier::Linear) {
+      stats_.ceiling = static_cast<QualityTier>(index_of(stats_.ceiling) - 1);
+      ++stats_.downgrades;
+    }
+  } else if (++on_time_streak_ >= options_.upgrade_after && stats_.ceiling < options_.max_tier &&
+             r.tier == stats_.ceiling) {
+    // Only probe upwards while the current ceiling is actually affordable.
+    stats_.ceiling = static_cast<QualityTier>(index_of(stats_.ceiling) + 1);
+    ++stats_.upgrades;
+    on_time_streak_ = 0;
+  }
+  return r;
+}
+
+}  // namespace minfi
@@ -0,0 +1,98 @@
+#include "minfi/async.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+namespace {
+
+// Elements per cancellation check: large enough to keep the kernel vectorized, small enough
+// that a stop request is observed within a fraction of a millisecond.
+constexpr std::size_t kChunkElems = 1 << 16;
+
+Frame run_interpolate(const Frame& a, const Frame& b, float t, const std::stop_token& stop) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  Frame out(a.size());
+  for (std::size_t off = 0; off < a.size(); off += kChunkElems) {
+    if (stop.stop_requested()) throw Cancelled();
+    const std::size_t n = std::min(kChunkElems, a.size() - off);
+    interpolate_into<float>(std::span<const float>(a).subspan(off, n),
+                            std::span<const float>(b).subspan(off, n),
+                            std::span<float>(out).subspan(off, n), t);
+  }
+  if (stop.stop_requested()) throw Cancelled();
+  return out;
+}
+
+// Runs on_complete once the outcome is settled; an exception from the callback is swallowed so
+// it can neither replace the outcome nor escape into the executor.
+void notify(const AsyncOptions& options, const Frame* result, std::exception_ptr error) {
+  if (!options.on_complete) return;
+  try {
+    options.on_complete(result, std::move(error));
+  } catch (...) {
+  }
+}
+
+Executor& executor_for(const AsyncOptions& options) {
+  return options.executor ? *options.executor : default_executor();
+}
+
+}  // namespace
+
+std::future<Frame> interpolate_async(Frame a, Frame b, float t, AsyncOptions options) {
+  auto promise = std::make_shared<std::promise<Frame>>();
+  auto future = promise->get_future();
+  Executor& executor = executor_for(options);
+  executor.submit([promise, a = std::move(a), b = std::move(b), t,
+                   options = std::move(options)]() mutable {
+    Frame out;
+    std::exception_ptr error;
+    try {
+      out = run_interpolate(a, b, t, options.stop);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    notify(options, error ? nullptr : &out, error);
+    if (error) {
+      promise->set_exception(error);
+    } else {
+      promise->set_value(std::move(out));
+    }
+  });
+  return future;
+}
+
+InterpolateAwaitable::InterpolateAwaitable(Frame a, Frame b, float t, AsyncOptions options)
+    : a_(std::move(a)), b_(std::move(b)), t_(t), options_(std::move(options)) {}
+
+void InterpolateAwaitable::await_suspend(std::coroutine_handle<> handle) {
+  executor_for(options_).submit([this, handle] {
+    try {
+      result_ = run_interpolate(a_, b_, t_, options_.stop);
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+    notify(options_, error_ ? nullptr : &result_, error_);
+    handle.resume();
+  });
+}
+
+Frame InterpolateAwaitable::await_resume() {
+  if (error_) std::rethrow_exception(error_);
+  return std::move(result_);
+}
+
+InterpolateAwaitable interpolate_awaitable(Frame a, Frame b, float t, AsyncOptions options) {
+  return InterpolateAwaitable(std::move(a), std::move(b), t, std::move(options));
+}
+
+}  // namespace minfi
@@ -0,0 +1,100 @@
+#include "minfi/batch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "minfi/kernels.hpp"
+#include "minfi/tuning.hpp"
+
+namespace minfi {
+
+FrameBatch::FrameBatch(FrameShape shape, std::size_t frames)
+    : shape_(shape), frame_elems_(shape.elems()) {
+  if (frame_elems_ == 0) throw std::invalid_argument("FrameBatch: empty frame shape");
+  resize(frames);
+}
+
+void FrameBatch::reserve(std::size_t frames) { data_.reserve(frames * frame_elems_); }
+
+void FrameBatch::resize(std::size_t frames) {
+  data_.resize(frames * frame_elems_);
+  frames_ = frames;
+}
+
+std::size_t FrameBatch::push_back(std::span<const float> frame) {
+  if (frame.size() != frame_elems_) {
+    throw std::invalid_argument("FrameBatch: frame size does not match the batch shape");
+  }
+  data_.insert(data_.end(), frame.begin(), frame.end());
+  return frames_++;
+}
+
+void FrameBatch::gather_into(std::size_t i, std::span<float> dst) const {
+  if (i >= frames_) {
+    throw std::out_of_range("FrameBatch: frame " + std::to_string(i) + " out of range");
+  }
+  if (dst.size() != frame_elems_) {
+    throw std::invalid_argument("FrameBatch: gather destination size mismatch");
+  }
+  std::memcpy(dst.data(), data_.data() + i * frame_elems_, frame_elems_ * sizeof(float));
+}
+
+Frame FrameBatch::gather(std::size_t i) const {
+  Frame out(frame_elems_);
+  gather_into(i, out);
+  return out;
+}
+
+std::vector<Frame> FrameBatch::gather_all() const {
+  std::vector<Frame> frames;
+  frames.reserve(frames_);
+  for (std::size_t i = 0; i < frames_; ++i) frames.push_back(gather(i));
+  return frames;
+}
+
+void interpolate_batch_into(const FrameBatch& a, const FrameBatch& b, std::span<const float> t,
+                            FrameBatch& out) {
+  if (a.shape() != b.shape() || a.shape() != out.shape()) {
+    throw std::invalid_argument("interpolate_batch: frame shape mismatch");
+  }
+  if (a.size() != b.size() || t.size() != a.size()) {
+    throw std::invalid_argument("interpolate_batch: frame count mismatch");
+  }
+  out.resize(a.size());
+
+  // Parallel over groups of whole frames, so each frame keeps a single weight and one
+  // uninterrupted vectorized loop.
+  const std::size_t elems = a.frame_elems();
+  const TuningEntry config = detail::cached_active_tuning().select(a.data().size());
+  const std::size_t threads = std::max<std::size_t>(1, config.threads);
+  const std::size_t group =
+      config.tile_elems ? std::max<std::size_t>(1, config.tile_elems / elems)
+                        : std::max<std::size_t>(1, (a.size() + threads - 1) / threads);
+  const std::size_t groups = (a.size() + group - 1) / group;
+  const float* pa = a.data().data();
+  const float* pb = b.data().data();
+  float* po = out.data().data();
+  detail::run_tiles(groups, threads, [&](std::size_t g) {
+    const std::size_t end = std::min(a.size(), (g + 1) * group);
+    for (std::size_t i = g * group; i < end; ++i) {
+      const std::size_t off = i * elems;
+      detail::blend_range(config.kernel, pa + off, pb + off, po + off, elems,
+                          detail::clamp01(t[i]));
+    }
+  });
+}
+
+FrameBatch interpolate_batch(const FrameBatch& a, const FrameBatch& b, std::span<const float> t) {
+  FrameBatch out(a.shape());
+  interpolate_batch_into(a, b, t, out);
+  return out;
+}
+
+FrameBatch interpolate_batch(const FrameBatch& a, const FrameBatch& b, float t) {
+  const std::vector<float> ts(a.size(), t);
+  return interpolate_batch(a, b, ts);
+}
+
+}  // namespace minfi
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "minfi/cubic.hpp"
+#include "minfi/executor.hpp"
+#include "minfi/kernels.hpp"
+#include "minfi/minfi.h"
+#include "minfi/motion.hpp"
+#include "minfi/motion_cache.hpp"
+
+struct minfi_pool {
+  explicit minfi_pool(std::size_t threads) : executor(threads) {}
+  minfi::Executor executor;
+};
+
+struct minfi_motion {
+  minfi::MotionOptions options;
+  minfi::MotionCache cache;
+};
+
+namespace {
+
+thread_local std::string g_last_error;
+
+minfi_status fail(minfi_status status, const char* what) {
+  g_last_error = what;
+  return status;
+}
+
+// Runs `body` with C++ exceptions mapped to status codes.
+template <typename F>
+minfi_status guarded(F&& body) {
+  try {
+    body();
+    return MINFI_OK;
+  } catch (const std::invalid_argument& e) {
+    return fail(MINFI_ERROR_INVALID_ARGUMENT, e.what());
+  } catch (const std::bad_alloc&) {
+    return fail(MINFI_ERROR_OUT_OF_MEMORY, "out of memory");
+  } catch (const std::exception& e) {
+    return fail(MINFI_ERROR_INTERNAL, e.what());
+  } catch (...) {
+    return fail(MINFI_ERROR_INTERNAL, "unknown error");
+  }
+}
+
+std::size_t element_bytes(minfi_element e) {
+  switch (e) {
+    case MINFI_ELEMENT_F32:
+      return 4;
+    case MINFI_ELEMENT_U8:
+      return 1;
+    case MINFI_ELEMENT_U16:
+      return 2;
+  }
+  throw std::invalid_argument("minfi: unknown element type");
+}
+
+std::size_t row_elems(const minfi_image& im) {
+  return static_cast<std::size_t>(im.width) * im.channels;
+}
+
+std::size_t stride_of(const minfi_image& im) {
+  return im.row_stride ? im.row_stride : row_elems(im) * element_bytes(im.element);
+}
+
+void check_image(const minfi_image* im) {
+  if (!im) throw std::invalid_argument("minfi: null image");
+  if (im->width == 0 || im->height == 0 || im->channels == 0) {
+    throw std::invalid_argument("minfi: empty image");
+  }
+  if (!im->data) throw std::invalid_argument("minfi: null image data");
+  const std::size_t bytes = element_bytes(im->element);
+  if (im->row_stride != 0 && (im->row_stride < row_elems(*im) * bytes || im->row_stride % bytes)) {
+    throw std::invalid_argument("minfi: row_stride is smaller than a row or misaligned");
+  }
+}
+
+// NaN would survive clamping and reach float-to-integer conversions.
+void check_t(float t) {
+  if (std::isnan(t)) throw std::invalid_argument("minfi: t is NaN");
+}
+
+void check_same_layout(const minfi_image& a, const minfi_image& b) {
+  if (a.width != b.width || a.height != b.height || a.channels != b.channels) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if (a.element != b.element) throw std::invalid_argument("minfi: element type mismatch");
+}
+
+// Whether the bytes of two packed images overlap.
+bool overlaps(const minfi_image& x, const minfi_image& y) {
+  const auto bx = reinterpret_cast<std::uintptr_t>(x.data);
+  const auto by = reinterpret_cast<std::uintptr_t>(y.data);
+  return bx < by + stride_of(y) * y.height && by < bx + stride_of(x) * x.height;
+}
+
+template <typename T>
+T* row_ptr(const minfi_image& im, std::size_t y) {
+  return reinterpret_cast<T*>(static_cast<unsigned char*>(im.data) + y * stride_of(im));
+}
+
+// Calls rows(y0, y1) over [0, height), split into bands across the pool when there is one.
+template <typename Rows>
+void for_rows(std::size_t height, minfi_pool* pool, Rows rows) {
+  const std::size_t threads = pool ? pool->executor.thread_count() : 1;
+  if (threads <= 1 || height < 2) {
+    rows(std::size_t{0}, height);
+    return;
+  }
+  // A few bands per worker keeps the tail short when rows cost unevenly.
+  const std::size_t bands = std::min(height, threads * 4);
+  std::latch done(static_cast<std::ptrdiff_t>(bands));
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto band = [&](std::size_t i) {
+    // Escaping the task would terminate the worker; the first error is rethrown to guarded().
+    try {
+      rows(height * i / bands, height * (i + 1) / bands);
+    } catch (...) {
+      const std::lock_guard lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    done.count_down();
+  };
+  std::size_t i = 0;
+  try {
+    for (; i < bands; ++i) pool->executor.submit([&band, i] { band(i); });
+  } catch (...) {
+    // Queued bands still reference the locals above: finish the rest here and wait for them.
+    {
+      const std::lock_guard lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    for (; i < bands; ++i) band(i);
+  }
+  done.wait();
+  if (error) std::rethrow_exception(error);
+}
+
+template <typename T>
+void interpolate_rows(const minfi_image& a, const minfi_image& b, const minfi_image& out, float t,
+                      minfi_pool* pool) {
+  const std::size_t n = row_elems(a);
+  for_rows(a.height, pool, [&](std::size_t y0, std::size_t y1) {
+    for (std::size_t y = y0; y < y1; ++y) {
+      minfi::interpolate_into<T>(std::span<const T>(row_ptr<const T>(a, y), n),
+                                 std::span<const T>(row_ptr<const T>(b, y), n),
+                                 std::span<T>(row_ptr<T>(out, y), n), t);
+    }
+  });
+}
+
+bool packed_f32(const minfi_image& im) {
+  return im.element == MINFI_ELEMENT_F32 &&
+         (im.row_stride == 0 || im.row_stride == row_elems(im) * sizeof(float));
+}
+
+std::span<const float> packed_span(const minfi_image& im) {
+  return {static_cast<const float*>(im.data), row_elems(im) * im.height};
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t minfi_abi_version(void) { return MINFI_ABI_VERSION; }
+
+const char* minfi_status_string(minfi_status status) {
+  switch (status) {
+    case MINFI_OK:
+      return "ok";
+    case MINFI_ERROR_INVALID_ARGUMENT:
+      return "invalid argument";
+    case MINFI_ERROR_OUT_OF_MEMORY:
+      return "out of memory";
+    case MINFI_ERROR_INTERNAL:
+      return "internal error";
+  }
+  return "unknown status";
+}
+
+const char* minfi_last_error(void) { return g_last_error.c_str(); }
+
+minfi_pool* minfi_pool_create(uint32_t threads) {
+  minfi_pool* pool = nullptr;
+  const minfi_status st = guarded([&] { pool = new minfi_pool(threads); });
+  return st == MINFI_OK ? pool : nullptr;
+}
+
+void minfi_pool_destroy(minfi_pool* pool) { delete pool; }
+
+uint32_t minfi_pool_thread_count(const minfi_pool* pool) {
+  return pool ? static_cast<uint32_t>(pool->executor.thread_count()) : 0;
+}
+
+minfi_status minfi_interpolate(const minfi_image* a, const minfi_image* b,
+                               const minfi_image* out, float t, minfi_pool* pool) {
+  return guarded([&] {
+    check_image(a);
+    check_image(b);
+    check_image(out);
+    check_t(t);
+    check_same_layout(*a, *b);
+    check_same_layout(*a, *out);
+    switch (a->element) {
+      case MINFI_ELEMENT_F32:
+        interpolate_rows<float>(*a, *b, *out, t, pool);
+        break;
+      case MINFI_ELEMENT_U8:
+        interpolate_rows<std::uint8_t>(*a, *b, *out, t, pool);
+        break;
+      case MINFI_ELEMENT_U16:
+        interpolate_rows<std::uint16_t>(*a, *b, *out, t, pool);
+        break;
+    }
+  });
+}
+
+minfi_status minfi_interpolate_cubic(const minfi_image* p0, const minfi_image* p1,
+                                     const minfi_image* p2, const minfi_image* p3,
+                                     const minfi_image* out, float t, minfi_pool* pool) {
+  return guarded([&] {
+    for (const minfi_image* im : {p0, p1, p2, p3, out}) {
+      check_image(im);
+      check_same_layout(*p1, *im);
+    }
+    check_t(t);
+    if (p1->element != MINFI_ELEMENT_F32) {
+      throw std::invalid_argument("minfi_interpolate_cubic: only F32 images are supported");
+    }
+    const std::size_t n = row_elems(*p1);
+    for_rows(p1->height, pool, [&](std::size_t y0, std::size_t y1) {
+      for (std::size_t y = y0; y < y1; ++y) {
+        minfi::interpolate_cubic_into({row_ptr<const float>(*p0, y), n},
+                                      {row_ptr<const float>(*p1, y), n},
+                                      {row_ptr<const float>(*p2, y), n},
+                                      {row_ptr<const float>(*p3, y), n},
+                                      {row_ptr<float>(*out, y), n}, t);
+      }
+    });
+  });
+}
+
+minfi_motion* minfi_motion_create(const minfi_motion_options* options) {
+  minfi_motion* motion = nullptr;
+  const minfi_status st = guarded([&] {
+    minfi::MotionOptions mo;
+    std::size_t cache_bytes = 64u << 20;
+    if (options) {
+      if (options->block) mo.block = options->block;
+      if (options->search) mo.search = static_cast<int>(options->search);
+      if (options->cache_bytes) cache_bytes = options->cache_bytes;
+    }
+    motion = new minfi_motion{mo, minfi::MotionCache(cache_bytes)};
+  });
+  return st == MINFI_OK ? motion : nullptr;
+}
+
+void minfi_motion_destroy(minfi_motion* motion) { delete motion; }
+
+minfi_status minfi_motion_interpolate(minfi_motion* motion, const minfi_image* a, uint64_t id_a,
+                                      const minfi_image* b, uint64_t id_b,
+                                      const minfi_image* out, float t,
+                                      minfi_motion_sampling sampling) {
+  return guarded([&] {
+    if (!motion) throw std::invalid_argument("minfi: null motion context");
+    check_image(a);
+    check_image(b);
+    check_image(out);
+    check_t(t);
+    check_same_layout(*a, *b);
+    check_same_layout(*a, *out);
+    if (!packed_f32(*a) || !packed_f32(*b) || !packed_f32(*out)) {
+      throw std::invalid_argument("minfi_motion_interpolate: needs tightly packed F32 images");
+    }
+    // Warping reads inputs at displaced positions, so writes would clobber pixels still needed.
+    if (overlaps(*out, *a) || overlaps(*out, *b)) {
+      throw std::invalid_argument("minfi_motion_interpolate: out must not alias an input");
+    }
+    const minfi::FrameShape shape{a->width, a->height, a->channels};
+    const auto sa = packed_span(*a);
+    const auto sb = packed_span(*b);
+    const minfi::FramePairKey key{id_a ? id_a : minfi::frame_id(sa),
+                                  id_b ? id_b : minfi::frame_id(sb)};
+    const auto field = motion->cache.get_or_estimate(key, sa, sb, shape, motion->options);
+    minfi::interpolate_motion_into(
+        sa, sb, shape, field->view(), t,
+        std::span<float>(static_cast<float*>(out->data), sa.size()),
+        sampling == MINFI_MOTION_SMOOTH ? minfi::MotionSampling::Smooth
+                                        : minfi::MotionSampling::Block);
+  });
+}
+
+}  // extern "C"
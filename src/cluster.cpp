@@ -0,0 +1,606 @@
+#include "cluster.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi::cluster {
+
+namespace {
+
+using steady = std::chrono::steady_clock;
+
+constexpr std::uint32_t kMagic = 0x464e494d;  // "MINF"
+
+enum class MsgType : std::uint32_t { Hello = 1, Job = 2, Result = 3, Shutdown = 4 };
+
+struct MsgHeader {
+  std::uint32_t magic;
+  std::uint32_t type;
+  std::uint64_t bytes;  // body size following the header
+};
+struct HelloBody {
+  std::uint64_t pid;
+};
+struct JobBody {
+  std::uint64_t segment_id, first, count, frame_elems, factor;
+};
+struct ResultBody {
+  std::uint64_t segment_id, frames, frame_elems;
+};
+
+struct Message {
+  MsgType type{};
+  std::vector<std::uint8_t> body;
+};
+
+bool write_all(int fd, const void* data, std::size_t n) {
+  const auto* p = static_cast<const std::uint8_t*>(data);
+  while (n > 0) {
+    const ssize_t k = ::write(fd, p, n);
+    if (k < 0 && errno == EINTR) continue;
+    if (k <= 0) return false;
+    p += k;
+    n -= static_cast<std::size_t>(k);
+  }
+  return true;
+}
+
+bool read_all(int fd, void* data, std::size_t n) {
+  auto* p = static_cast<std::uint8_t*>(data);
+  while (n > 0) {
+    const ssize_t k = ::read(fd, p, n);
+    if (k < 0 && errno == EINTR) continue;
+    if (k <= 0) return false;
+    p += k;
+    n -= static_cast<std::size_t>(k);
+  }
+  return true;
+}
+
+template <typename Body>
+bool send_msg(int fd, MsgType type, const Body& body, std::span<const float> payload = {}) {
+  const MsgHeader h{kMagic, static_cast<std::uint32_t>(type), sizeof(Body) + payload.size_bytes()};
+  return write_all(fd, &h, sizeof(h)) && write_all(fd, &body, sizeof(Body)) &&
+         write_all(fd, payload.data(), payload.size_bytes());
+}
+
+// Blocking receive for workers. Bodies above `max_body` are rejected before allocating.
+bool recv_msg(int fd, Message& msg, std::size_t max_body) {
+  MsgHeader h{};
+  if (!read_all(fd, &h, sizeof(h)) || h.magic != kMagic || h.bytes > max_body) return false;
+  msg.type = static_cast<MsgType>(h.type);
+  msg.body.resize(h.bytes);
+  return read_all(fd, msg.body.data(), msg.body.size());
+}
+
+// Appends whatever `fd` has ready without blocking, up to `limit` buffered bytes. Returns false
+// once the peer has closed or failed.
+bool drain(int fd, std::vector<std::uint8_t>& in, std::size_t limit) {
+  std::uint8_t buf[64 * 1024];
+  while (in.size() < limit) {
+    const ssize_t k = ::recv(fd, buf, std::min(sizeof(buf), limit - in.size()), MSG_DONTWAIT);
+    if (k > 0) {
+      in.insert(in.end(), buf, buf + k);
+      continue;
+    }
+    if (k < 0 && errno == EINTR) continue;
+    return k < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+  return true;
+}
+
+enum class Take { Message, More, Malformed };
+
+// Moves the first complete message out of `in`.
+Take take_msg(std::vector<std::uint8_t>& in, std::size_t max_body, Message& msg) {
+  if (in.size() < sizeof(MsgHeader)) return Take::More;
+  MsgHeader h{};
+  std::memcpy(&h, in.data(), sizeof(h));
+  if (h.magic != kMagic || h.bytes > max_body) return Take::Malformed;
+  const std::size_t total = sizeof(h) + static_cast<std::size_t>(h.bytes);
+  if (in.size() < total) return Take::More;
+  msg.type = static_cast<MsgType>(h.type);
+  msg.body.assign(in.begin() + sizeof(h), in.begin() + static_cast<std::ptrdiff_t>(total));
+  in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(total));
+  return Take::Message;
+}
+
+template <typename Body>
+bool parse_body(const Message& msg, Body& body, std::span<const float>& payload) {
+  if (msg.body.size() < sizeof(Body)) return false;
+  std::memcpy(&body, msg.body.data(), sizeof(Body));
+  const std::size_t rest = msg.body.size() - sizeof(Body);
+  if (rest % sizeof(float) != 0) return false;
+  // The body buffer comes from std::vector, whose storage is suitably aligned for float, and
+  // every body struct is a multiple of 8 bytes.
+  payload = std::span<const float>(reinterpret_cast<const float*>(msg.body.data() + sizeof(Body)),
+                                   rest / sizeof(float));
+  return true;
+}
+
+struct Endpoint {
+  bool is_unix = true;
+  std::string path;
+  std::string host;
+  std::uint16_t port = 0;
+
+  std::string str() const {
+    return is_unix ? "unix:" + path : "tcp:" + host + ":" + std::to_string(port);
+  }
+};
+
+Endpoint parse_endpoint(const std::string& s) {
+  Endpoint ep;
+  if (s.rfind("unix:", 0) == 0) {
+    ep.path = s.substr(5);
+    if (ep.path.empty() || ep.path.size() >= sizeof(sockaddr_un::sun_path)) {
+      throw std::invalid_argument("cluster: bad unix socket path '" + ep.path + "'");
+    }
+    return ep;
+  }
+  if (s.rfind("tcp:", 0) == 0) {
+    const auto colon = s.rfind(':');
+    if (colon <= 4) throw std::invalid_argument("cluster: expected tcp:<host>:<port>");
+    ep.is_unix = false;
+    ep.host = s.substr(4, colon - 4);
+    const std::string port = s.substr(colon + 1);
+    std::size_t used = 0;
+    unsigned long value = 0;
+    try {
+      value = std::stoul(port, &used);
+    } catch (const std::exception&) {
+      used = 0;
+    }
+    if (used == 0 || used != port.size() || value > 65535) {
+      throw std::invalid_argument("cluster: bad tcp port '" + port + "'");
+    }
+    ep.port = static_cast<std::uint16_t>(value);
+    return ep;
+  }
+  throw std::invalid_argument("cluster: endpoint must start with unix: or tcp:");
+}
+
+sockaddr_in tcp_address(const Endpoint& ep) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(ep.port);
+  if (::inet_pton(AF_INET, ep.host.c_str(), &addr.sin_addr) != 1) {
+    throw std::invalid_argument("cluster: tcp host must be a dotted IPv4 address");
+  }
+  return addr;
+}
+
+sockaddr_un unix_address(const Endpoint& ep) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, ep.path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+
+// Pid of the process on the other end of a Unix domain socket, or 0 when the kernel cannot tell
+// (TCP, other platforms). Unlike the pid a worker reports in Hello, this cannot be forged.
+pid_t peer_pid(int fd) {
+#if defined(SO_PEERCRED)
+  ucred cred{};
+  socklen_t len = sizeof(cred);
+  if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0) return cred.pid;
+#elif defined(LOCAL_PEERPID)
+  pid_t pid = 0;
+  socklen_t len = sizeof(pid);
+  if (::getsockopt(fd, SOL_LOCAL, LOCAL_PEERPID, &pid, &len) == 0) return pid;
+#endif
+  (void) fd;
+  return 0;
+}
+
+// Coordinator descriptors must not leak into spawned workers: a worker holding a copy of the
+// listening socket would keep it connectable after the coordinator is done with it.
+void set_cloexec(int fd) {
+  ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+// Removes a stale socket at `path`; anything else there is left for bind() to report.
+void unlink_socket(const std::string& path) {
+  struct stat st {};
+  if (::lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) ::unlink(path.c_str());
+}
+
+// Binds and listens; for TCP port 0 the chosen port is written back into `ep`.
+int listen_on(Endpoint& ep) {
+  const int fd = ::socket(ep.is_unix ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) throw std::runtime_error("cluster: socket() failed");
+  set_cloexec(fd);
+  int rc = 0;
+  if (ep.is_unix) {
+    unlink_socket(ep.path);
+    const sockaddr_un addr = unix_address(ep);
+    rc = ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  } else {
+    const int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    const sockaddr_in addr = tcp_address(ep);
+    rc = ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    if (rc == 0 && ep.port == 0) {
+      sockaddr_in bound{};
+      socklen_t len = sizeof(bound);
+      ::getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &len);
+      ep.port = ntohs(bound.sin_port);
+    }
+  }
+  if (rc != 0 || ::listen(fd, 64) != 0) {
+    ::close(fd);
+    throw std::runtime_error("cluster: cannot listen on " + ep.str() + ": " + std::strerror(errno));
+  }
+  return fd;
+}
+
+int connect_to(const Endpoint& ep) {
+  const int fd = ::socket(ep.is_unix ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  int rc = 0;
+  if (ep.is_unix) {
+    const sockaddr_un addr = unix_address(ep);
+    rc = ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  } else {
+    const sockaddr_in addr = tcp_address(ep);
+    rc = ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  }
+  if (rc != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// For each source interval of `count` frames: the left source frame followed by factor - 1
+// in-between frames at t = k / factor. The right boundary frame is left to the caller.
+std::vector<float> interpolate_segment(std::span<const float> frames, std::size_t count,
+                                       std::size_t elems, std::size_t factor) {
+  std::vector<float> out((count - 1) * factor * elems);
+  float* dst = out.data();
+  for (std::size_t i = 0; i + 1 < count; ++i) {
+    const auto a = frames.subspan(i * elems, elems);
+    const auto b = frames.subspan((i + 1) * elems, elems);
+    std::copy(a.begin(), a.end(), dst);
+    dst += elems;
+    for (std::size_t k = 1; k < factor; ++k) {
+      const float t = static_cast<float>(k) / static_cast<float>(factor);
+      interpolate_into<float>(a, b, std::span<float>(dst, elems), t);
+      dst += elems;
+    }
+  }
+  return out;
+}
+
+std::vector<float> load_frames(const CoordinatorOptions& o, std::size_t& frames) {
+  if (o.input.empty()) {
+    frames = o.synthetic_frames;
+    std::vector<float> data(frames * o.frame_elems);
+    for (std::size_t i = 0; i < frames; ++i) {
+      for (std::size_t j = 0; j < o.frame_elems; ++j) {
+        data[i * o.frame_elems + j] =
+            0.5f + 0.5f * std::sin(0.01f * static_cast<float>(j) + 0.3f * static_cast<float>(i));
+      }
+    }
+    return data;
+  }
+  std::ifstream ifs(o.input, std::ios::binary | std::ios::ate);
+  if (!ifs) throw std::runtime_error("cluster: cannot open input '" + o.input + "'");
+  const auto bytes = static_cast<std::size_t>(ifs.tellg());
+  const std::size_t frame_bytes = o.frame_elems * sizeof(float);
+  if (frame_bytes == 0 || bytes % frame_bytes != 0) {
+    throw std::runtime_error("cluster: input size is not a multiple of the frame size");
+  }
+  frames = bytes / frame_bytes;
+  std::vector<float> data(bytes / sizeof(float));
+  ifs.seekg(0);
+  ifs.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(bytes));
+  return data;
+}
+
+pid_t spawn_worker(const CoordinatorOptions& o, const Endpoint& ep, bool crash) {
+  const std::string endpoint = ep.str();
+  const pid_t pid = ::fork();
+  if (pid != 0) return pid;
+  std::vector<const char*> args{o.self_exe.c_str(), "--worker", "--connect", endpoint.c_str()};
+  if (crash) {
+    args.push_back("--crash-after");
+    args.push_back("1");
+  }
+  args.push_back(nullptr);
+#if defined(__linux__)
+  ::execv("/proc/self/exe", const_cast<char* const*>(args.data()));
+#endif
+  ::execvp(o.self_exe.c_str(), const_cast<char* const*>(args.data()));
+  ::_exit(127);
+}
+
+// Largest body a worker may receive; the coordinator bounds what it accepts per job instead.
+constexpr std::size_t kWorkerMaxBody = std::size_t{1} << 31;
+
+struct WorkerConn {
+  int fd = -1;
+  pid_t pid = 0;                  // local child verified through the socket, else 0
+  std::uint64_t reported_pid = 0;  // from Hello; for messages only
+  bool hello = false;
+  std::optional<std::size_t> segment;
+  steady::time_point since;  // accept time until Hello, then dispatch time of `segment`
+  std::vector<std::uint8_t> in;  // bytes received but not yet parsed
+};
+
+}  // namespace
+
+std::vector<Segment> plan_segments(std::size_t frames, std::size_t segment_frames) {
+  if (frames < 2 || segment_frames < 2) {
+    throw std::invalid_argument("plan_segments: need at least two frames per sequence/segment");
+  }
+  std::vector<Segment> out;
+  for (std::size_t first = 0; first + 1 < frames; first += segment_frames - 1) {
+    out.push_back({out.size(), first, std::min(segment_frames, frames - first)});
+  }
+  return out;
+}
+
+int run_coordinator(const CoordinatorOptions& o) {
+  ::signal(SIGPIPE, SIG_IGN);
+  if (o.factor < 1 || o.workers < 1) {
+    throw std::invalid_argument("cluster: factor and workers must be at least 1");
+  }
+  std::size_t frames = 0;
+  const std::vector<float> source = load_frames(o, frames);
+  const std::size_t elems = o.frame_elems;
+  const std::vector<Segment> segments = plan_segments(frames, o.segment_frames);
+
+  Endpoint ep = parse_endpoint(o.endpoint.empty()
+                                   ? "unix:/tmp/minfi-coord-" + std::to_string(::getpid()) + ".sock"
+                                   : o.endpoint);
+  const int listen_fd = listen_on(ep);
+  std::cout << "coordinator: " << frames << " frames, " << segments.size() << " segments, "
+            << o.workers << " workers on " << ep.str() << "\n";
+
+  std::set<pid_t> children;
+  for (std::size_t i = 0; i < o.workers; ++i) {
+    children.insert(spawn_worker(o, ep, o.inject_failure && i == 0));
+  }
+  int respawns = 0;
+
+  std::deque<std::size_t> pending;
+  for (const auto& s : segments) pending.push_back(s.id);
+  std::vector<std::vector<float>> results(segments.size());
+  std::size_t done = 0;
+  std::vector<WorkerConn> conns;
+
+  // Peers only ever send Hello and Result; nothing larger than the biggest Result is buffered.
+  const std::size_t max_result = (o.segment_frames - 1) * o.factor * elems * sizeof(float);
+  const std::size_t max_body = sizeof(ResultBody) + max_result;
+  const auto timeout = std::chrono::milliseconds(o.job_timeout_ms);
+
+  // Only a child this coordinator spawned, identified by the kernel, is ever killed.
+  const auto fail_conn = [&](WorkerConn& c, const char* why) {
+    std::cerr << "coordinator: worker pid " << c.reported_pid << " " << why;
+    if (c.segment) {
+      std::cerr << "; re-dispatching segment " << *c.segment;
+      pending.push_front(*c.segment);
+    }
+    std::cerr << "\n";
+    if (c.pid > 0 && children.count(c.pid)) ::kill(c.pid, SIGKILL);
+    ::close(c.fd);
+    c.fd = -1;
+  };
+
+  // Handles one complete message; false if the peer broke the protocol.
+  const auto handle = [&](WorkerConn& c, const Message& msg) {
+    std::span<const float> payload;
+    if (!c.hello) {
+      HelloBody body{};
+      if (msg.type != MsgType::Hello || !parse_body(msg, body, payload)) return false;
+      c.hello = true;
+      c.reported_pid = body.pid;
+      return true;
+    }
+    ResultBody body{};
+    if (msg.type != MsgType::Result || !parse_body(msg, body, payload) || !c.segment ||
+        body.segment_id != *c.segment) {
+      return false;
+    }
+    const Segment& s = segments[body.segment_id];
+    const std::size_t expected = (s.count - 1) * o.factor * elems;
+    if (payload.size() != expected || body.frame_elems != elems ||
+        body.frames != (s.count - 1) * o.factor) {
+      return false;
+    }
+    results[body.segment_id].assign(payload.begin(), payload.end());
+    c.segment.reset();
+    ++done;
+    return true;
+  };
+
+  int status = EXIT_SUCCESS;
+  while (done < segments.size()) {
+    for (pid_t pid; (pid = ::waitpid(-1, nullptr, WNOHANG)) > 0;) children.erase(pid);
+
+    for (auto& c : conns) {
+      if (c.fd < 0 || !c.hello || c.segment || pending.empty()) continue;
+      const Segment& s = segments[pending.front()];
+      const JobBody job{s.id, s.first, s.count, elems, o.factor};
+      c.segment = s.id;
+      c.since = steady::now();
+      pending.pop_front();
+      if (!send_msg(c.fd, MsgType::Job, job,
+                    std::span<const float>(source).subspan(s.first * elems, s.count * elems))) {
+        fail_conn(c, "dropped while sending a job");
+      }
+    }
+    std::erase_if(conns, [](const WorkerConn& c) { return c.fd < 0; });
+
+    // Keep the local pool at strength while work remains; replacements are budgeted.
+    if (children.size() < o.workers && respawns < o.max_respawns) {
+      children.insert(spawn_worker(o, ep, false));
+      ++respawns;
+    }
+    if (children.empty() && conns.empty()) {
+      std::cerr << "coordinator: no workers left and respawn budget exhausted\n";
+      status = EXIT_FAILURE;
+      break;
+    }
+
+    std::vector<pollfd> fds{{listen_fd, POLLIN, 0}};
+    for (const auto& c : conns) fds.push_back({c.fd, POLLIN, 0});
+    if (::poll(fds.data(), fds.size(), 100) < 0 && errno != EINTR) {
+      status = EXIT_FAILURE;
+      break;
+    }
+
+    // Reads never block: a peer that connects and stalls, or stops half way through a
+    // message, only runs down its own Hello or job deadline.
+    for (std::size_t i = 1; i < fds.size(); ++i) {
+      WorkerConn& c = conns[i - 1];
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        const bool open = drain(c.fd, c.in, sizeof(MsgHeader) + max_body);
+        Message msg;
+        Take took;
+        while ((took = take_msg(c.in, max_body, msg)) == Take::Message && handle(c, msg)) {
+        }
+        if (took == Take::Message || took == Take::Malformed) {
+          fail_conn(c, "sent a malformed message");
+          continue;
+        }
+        if (!open) {
+          fail_conn(c, "disconnected");
+          continue;
+        }
+      }
+      if (!c.hello && steady::now() - c.since > timeout) {
+        fail_conn(c, "sent no Hello");
+      } else if (c.segment && steady::now() - c.since > timeout) {
+        fail_conn(c, "timed out");
+      }
+    }
+
+    if (fds[0].revents & POLLIN) {
+      const int fd = ::accept(listen_fd, nullptr, nullptr);
+      if (fd >= 0) {
+        set_cloexec(fd);
+        // Job sends stay blocking but give up on a peer that stops reading.
+        const timeval tv{o.job_timeout_ms / 1000, (o.job_timeout_ms % 1000) * 1000};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        WorkerConn c;
+        c.fd = fd;
+        const pid_t pid = ep.is_unix ? peer_pid(fd) : 0;
+        c.pid = children.count(pid) ? pid : 0;
+        c.since = steady::now();
+        conns.push_back(std::move(c));
+      }
+    }
+    std::erase_if(conns, [](const WorkerConn& c) { return c.fd < 0; });
+  }
+
+  std::set<pid_t> connected;
+  for (auto& c : conns) {
+    if (c.hello) (void) send_msg(c.fd, MsgType::Shutdown, HelloBody{0});
+    ::close(c.fd);
+    // A pid a peer reports may only spare a process from SIGTERM, never select one to kill.
+    if (c.hello) connected.insert(c.pid > 0 ? c.pid : static_cast<pid_t>(c.reported_pid));
+  }
+  for (pid_t pid : children) {
+    // Late replacements that never connected are not needed any more.
+    if (!connected.count(pid)) ::kill(pid, SIGTERM);
+    ::waitpid(pid, nullptr, 0);
+  }
+  ::close(listen_fd);
+  if (ep.is_unix) unlink_socket(ep.path);
+  if (status != EXIT_SUCCESS) return status;
+
+  std::vector<float> out;
+  out.reserve(((frames - 1) * o.factor + 1) * elems);
+  for (const auto& r : results) out.insert(out.end(), r.begin(), r.end());
+  out.insert(out.end(), source.end() - static_cast<std::ptrdiff_t>(elems), source.end());
+  std::cout << "coordinator: assembled " << out.size() / elems << " frames (" << respawns
+            << " respawns)\n";
+
+  if (o.verify) {
+    std::vector<float> expected = interpolate_segment(source, frames, elems, o.factor);
+    expected.insert(expected.end(), source.end() - static_cast<std::ptrdiff_t>(elems),
+                    source.end());
+    if (expected != out) {
+      std::cerr << "coordinator: verification FAILED\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << "coordinator: verification OK\n";
+  }
+  if (!o.output.empty()) {
+    std::ofstream ofs(o.output, std::ios::binary);
+    ofs.write(reinterpret_cast<const char*>(out.data()),
+              static_cast<std::streamsize>(out.size() * sizeof(float)));
+    if (!ofs) throw std::runtime_error("cluster: cannot write output '" + o.output + "'");
+  }
+  return EXIT_SUCCESS;
+}
+
+int run_worker(const WorkerOptions& o) {
+  ::signal(SIGPIPE, SIG_IGN);
+  const Endpoint ep = parse_endpoint(o.endpoint);
+  int fd = -1;
+  for (int attempt = 0; attempt < 50 && fd < 0; ++attempt) {
+    fd = connect_to(ep);
+    if (fd < 0) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  if (fd < 0) {
+    std::cerr << "worker: cannot connect to " << ep.str() << "\n";
+    return EXIT_FAILURE;
+  }
+  if (!send_msg(fd, MsgType::Hello, HelloBody{static_cast<std::uint64_t>(::getpid())})) {
+    return EXIT_FAILURE;
+  }
+
+  int jobs = 0;
+  Message msg;
+  while (recv_msg(fd, msg, kWorkerMaxBody)) {
+    if (msg.type == MsgType::Shutdown) break;
+    JobBody job{};
+    std::span<const float> frames;
+    if (msg.type != MsgType::Job || !parse_body(msg, job, frames) ||
+        frames.size() != job.count * job.frame_elems || job.count < 2) {
+      std::cerr << "worker: malformed job\n";
+      ::close(fd);
+      return EXIT_FAILURE;
+    }
+    if (++jobs == o.crash_after) ::_exit(3);
+    const std::vector<float> out =
+        interpolate_segment(frames, job.count, job.frame_elems, job.factor);
+    const ResultBody result{job.segment_id, (job.count - 1) * job.factor, job.frame_elems};
+    if (!send_msg(fd, MsgType::Result, result, out)) break;
+  }
+  ::close(fd);
+  return EXIT_SUCCESS;
+}
+
+}  // namespace minfi::cluster
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Multi-process interpolation for minfi_demo.
+//
+// A coordinator shards a sequence of source frames into segments that overlap by one boundary
+// frame, hands them to worker processes over a stream socket and writes the interpolated
+// sequence back in order. Workers are spawned locally by default; any process that can reach
+// the endpoint may join with `minfi_demo --worker --connect <endpoint>`, which is how the same
+// protocol extends to other nodes. Messages use host byte order, so all participants must share
+// an endianness.
+//
+// Endpoints: "unix:<path>" for a Unix domain socket, "tcp:<host>:<port>" for TCP (port 0 lets
+// the coordinator pick a free port on loopback).
+namespace minfi::cluster {
+
+struct Segment {
+  std::size_t id = 0;
+  std::size_t first = 0;  // index of the first source frame
+  std::size_t count = 0;  // source frames, including the boundary frame shared with the next
+};
+
+// Splits `frames` source frames into segments of at most `segment_frames` frames where each
+// segment's last frame is the next segment's first. Requires frames >= 2, segment_frames >= 2.
+std::vector<Segment> plan_segments(std::size_t frames, std::size_t segment_frames);
+
+struct CoordinatorOptions {
+  std::string input;                // raw float32 frames back to back; empty selects synthetic
+  std::size_t synthetic_frames = 16;
+  std::size_t frame_elems = 1024;
+  std::size_t factor = 2;           // output frames per source interval
+  std::size_t workers = 2;
+  std::size_t segment_frames = 4;
+  std::string endpoint;             // default: unix socket in /tmp named after the pid
+  std::string output;               // raw float32 output; empty skips writing
+  std::string self_exe;             // binary used to spawn local workers
+  int job_timeout_ms = 30000;       // a busy worker, or a peer before Hello, silent this long fails
+  int max_respawns = 8;
+  bool verify = false;              // compare against single-process interpolation
+  bool inject_failure = false;      // the first spawned worker crashes on its first job
+};
+
+struct WorkerOptions {
+  std::string endpoint;
+  int crash_after = -1;  // testing aid: exit abruptly when receiving this many jobs
+};
+
+// Both return a process exit code.
+int run_coordinator(const CoordinatorOptions& options);
+int run_worker(const WorkerOptions& options);
+
+}  // namespace minfi::cluster
@@ -0,0 +1,95 @@
+#include "minfi/cubic.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+CubicWeights catmull_rom_weights(float t) {
+  const float u = detail::clamp01(t);
+  const float u2 = u * u;
+  const float u3 = u2 * u;
+  return {0.5f * (-u3 + 2.0f * u2 - u), 0.5f * (3.0f * u3 - 5.0f * u2 + 2.0f),
+          0.5f * (-3.0f * u3 + 4.0f * u2 + u), 0.5f * (u3 - u2)};
+}
+
+void interpolate_cubic_into(std::span<const float> p0, std::span<const float> p1,
+                            std::span<const float> p2, std::span<const float> p3,
+                            std::span<float> out, float t) {
+  const std::size_t n = p1.size();
+  if (p0.size() != n || p2.size() != n || p3.size() != n || out.size() != n) {
+    throw std::invalid_argument("interpolate_cubic: frame size mismatch");
+  }
+  const CubicWeights w = catmull_rom_weights(t);
+  const float* s0 = p0.data();
+  const float* s1 = p1.data();
+  const float* s2 = p2.data();
+  const float* s3 = p3.data();
+  float* dst = out.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = w.w0 * s0[i] + w.w1 * s1[i] + w.w2 * s2[i] + w.w3 * s3[i];
+  }
+}
+
+Frame interpolate_cubic(const Frame& p0, const Frame& p1, const Frame& p2, const Frame& p3,
+                        float t) {
+  Frame out(p1.size());
+  interpolate_cubic_into(p0, p1, p2, p3, out, t);
+  return out;
+}
+
+void CubicInterpolator::push(const Frame& frame) {
+  Frame& slot = next_slot(frame.size());
+  std::copy(frame.begin(), frame.end(), slot.begin());
+  commit();
+}
+
+void CubicInterpolator::push(Frame&& frame) {
+  std::swap(slots_[(head_ + count_) % kWindow], frame);
+  commit();
+}
+
+Frame& CubicInterpolator::next_slot(std::size_t size) {
+  Frame& slot = slots_[(head_ + count_) % kWindow];
+  slot.resize(size);
+  return slot;
+}
+
+void CubicInterpolator::commit() {
+  if (count_ < kWindow) {
+    ++count_;
+  } else {
+    // The slot just written held frame n-1; the window advances by one.
+    head_ = (head_ + 1) % kWindow;
+  }
+}
+
+void CubicInterpolator::reset() {
+  head_ = 0;
+  count_ = 0;
+}
+
+const Frame& CubicInterpolator::frame(int offset) const {
+  if (!ready()) {
+    throw std::logic_error("CubicInterpolator: window is not full");
+  }
+  if (offset < -1 || offset > 2) {
+    throw std::out_of_range("CubicInterpolator: frame offset must be in [-1, 2]");
+  }
+  return slots_[(head_ + static_cast<std::size_t>(offset + 1)) % kWindow];
+}
+
+void CubicInterpolator::interpolate_into(float t, std::span<float> out) const {
+  interpolate_cubic_into(frame(-1), frame(0), frame(1), frame(2), out, t);
+}
+
+Frame CubicInterpolator::interpolate(float t) const {
+  Frame out(frame(0).size());
+  interpolate_into(t, out);
+  return out;
+}
+
+}  // namespace minfi
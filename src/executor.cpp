@@ -0,0 +1,72 @@
+#include "minfi/executor.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace minfi {
+
+Executor::Executor(std::size_t threads) {
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this] { run_(); });
+  }
+}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& w : workers_) w.join();
+}
+
+void Executor::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // After shutdown only running tasks may submit; the workers stay until those finish.
+    assert(!stopping_ || running_ > 0);
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+std::size_t Executor::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+void Executor::run_() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return !queue_.empty() || (stopping_ && running_ == 0); });
+      if (queue_.empty()) {
+        cv_.notify_all();  // stopping and drained
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      ++running_;
+    }
+    // A throwing task would otherwise terminate the process; tasks report their own errors.
+    try {
+      task();
+    } catch (...) {
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0 && stopping_) cv_.notify_all();
+  }
+}
+
+Executor& default_executor() {
+  static Executor executor;
+  return executor;
+}
+
+}  // namespace minfi
@@ -0,0 +1,304 @@
+#include "minfi/frame_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(MINFI_WITH_LZ4)
+#include <lz4.h>
+#endif
+
+namespace minfi {
+
+namespace {
+
+using Packed = Vector<std::uint8_t, Subsystem::Frames>;
+using Bytes = Vector<std::uint8_t, Subsystem::Scratch>;
+
+// Splits the floats into four byte planes (all low bytes, ..., all high bytes). Sign and
+// exponent bytes of neighbouring pixels mostly agree, which the entropy stage then exploits.
+Bytes shuffle(std::span<const float> frame) {
+  const auto* src = reinterpret_cast<const std::uint8_t*>(frame.data());
+  const std::size_t n = frame.size();
+  Bytes planes(n * sizeof(float));
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t p = 0; p < sizeof(float); ++p) planes[p * n + i] = src[i * sizeof(float) + p];
+  }
+  return planes;
+}
+
+void unshuffle(const Bytes& planes, std::span<float> out) {
+  auto* dst = reinterpret_cast<std::uint8_t*>(out.data());
+  const std::size_t n = out.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t p = 0; p < sizeof(float); ++p) dst[i * sizeof(float) + p] = planes[p * n + i];
+  }
+}
+
+[[noreturn]] void corrupt() { throw std::runtime_error("FrameCache: corrupt compressed entry"); }
+
+#if !defined(MINFI_WITH_LZ4)
+// Run-length coding: a control byte c < 128 is followed by c + 1 literal bytes; c >= 128 by one
+// byte repeated c - 126 times (2..129).
+Packed rle_encode(const Bytes& src) {
+  Packed out;
+  out.reserve(src.size() / 2);
+  const std::size_t n = src.size();
+  std::size_t i = 0;
+  while (i < n) {
+    std::size_t run = 1;
+    while (i + run < n && run < 129 && src[i + run] == src[i]) ++run;
+    if (run >= 2) {
+      out.push_back(static_cast<std::uint8_t>(126 + run));
+      out.push_back(src[i]);
+      i += run;
+      continue;
+    }
+    const std::size_t start = i;
+    while (i < n && i - start < 128 && !(i + 1 < n && src[i] == src[i + 1])) ++i;
+    out.push_back(static_cast<std::uint8_t>(i - start - 1));
+    out.insert(out.end(), src.begin() + static_cast<std::ptrdiff_t>(start),
+               src.begin() + static_cast<std::ptrdiff_t>(i));
+  }
+  return out;
+}
+
+void rle_decode(const Packed& src, Bytes& dst) {
+  std::size_t o = 0;
+  for (std::size_t i = 0; i < src.size();) {
+    const std::uint8_t c = src[i++];
+    if (c < 128) {
+      const std::size_t len = std::size_t{c} + 1;
+      if (i + len > src.size() || o + len > dst.size()) corrupt();
+      std::memcpy(dst.data() + o, src.data() + i, len);
+      i += len;
+      o += len;
+    } else {
+      const std::size_t len = std::size_t{c} - 126;
+      if (i >= src.size() || o + len > dst.size()) corrupt();
+      std::memset(dst.data() + o, src[i++], len);
+      o += len;
+    }
+  }
+  if (o != dst.size()) corrupt();
+}
+#endif
+
+// Lossless encoding of a frame; the result may be larger than the input when it does not
+// compress.
+Packed encode(std::span<const float> frame) {
+  const Bytes planes = shuffle(frame);
+#if defined(MINFI_WITH_LZ4)
+  if (planes.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) return Packed(planes.size());
+  Packed out(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(planes.size()))));
+  const int n = LZ4_compress_default(reinterpret_cast<const char*>(planes.data()),
+                                     reinterpret_cast<char*>(out.data()),
+                                     static_cast<int>(planes.size()), static_cast<int>(out.size()));
+  if (n <= 0) return Packed(planes.size());
+  out.resize(static_cast<std::size_t>(n));
+  out.shrink_to_fit();
+  return out;
+#else
+  Packed out = rle_encode(planes);
+  out.shrink_to_fit();
+  return out;
+#endif
+}
+
+void decode(const Packed& packed, std::span<float> out) {
+  Bytes planes(out.size_bytes());
+#if defined(MINFI_WITH_LZ4)
+  const int n = LZ4_decompress_safe(reinterpret_cast<const char*>(packed.data()),
+                                    reinterpret_cast<char*>(planes.data()),
+                                    static_cast<int>(packed.size()),
+                                    static_cast<int>(planes.size()));
+  if (n < 0 || static_cast<std::size_t>(n) != planes.size()) corrupt();
+#else
+  rle_decode(packed, planes);
+#endif
+  unshuffle(planes, out);
+}
+
+}  // namespace
+
+FrameCache::FrameCache(Options options) : options_(options) {
+  if (options_.t_steps == 0) throw std::invalid_argument("FrameCache: t_steps must be > 0");
+}
+
+OutputKey FrameCache::key(const FramePairKey& pair, float t, OutputMethod method) const {
+  if (std::isnan(t)) throw std::invalid_argument("FrameCache: t is NaN");
+  const float steps = static_cast<float>(options_.t_steps);
+  const auto q = static_cast<std::uint32_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * steps));
+  return {pair, q, method};
+}
+
+bool FrameCache::lookup(const OutputKey& key, std::span<float> out) {
+  std::shared_ptr<const Frame> raw;
+  std::shared_ptr<const Packed> packed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return false;
+    }
+    Slot& slot = slots_[it->second];
+    if (slot.elems != out.size()) {
+      throw std::invalid_argument("FrameCache: cached frame size does not match the output");
+    }
+    slot.referenced = true;
+    ++stats_.hits;
+    raw = slot.raw;
+    packed = slot.packed;
+  }
+  if (raw) {
+    std::memcpy(out.data(), raw->data(), out.size_bytes());
+    return true;
+  }
+  decode(*packed, out);
+
+  // Re-requested, so no longer cold: keep it uncompressed unless it changed meanwhile.
+  auto promoted = std::make_shared<const Frame>(out.begin(), out.end());
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end() && slots_[it->second].packed == packed) {
+    Slot& slot = slots_[it->second];
+    stats_.bytes -= slot_bytes_(slot);
+    slot.packed.reset();
+    slot.raw = std::move(promoted);
+    stats_.bytes += slot_bytes_(slot);
+    --stats_.compressed_entries;
+    evict_to_budget_(lock);
+  }
+  return true;
+}
+
+void FrameCache::insert(const OutputKey& key, std::span<const float> frame) {
+  auto raw = std::make_shared<const Frame>(frame.begin(), frame.end());
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) release_(it->second);
+  if (frame.size_bytes() > options_.byte_budget) return;
+
+  std::size_t index;
+  if (free_.empty()) {
+    index = slots_.size();
+    slots_.emplace_back();
+  } else {
+    index = free_.back();
+    free_.pop_back();
+  }
+  Slot& slot = slots_[index];
+  slot.key = key;
+  slot.elems = frame.size();
+  slot.raw = std::move(raw);
+  slot.used = true;
+  slot.referenced = false;
+  index_.emplace(key, index);
+  stats_.bytes += slot_bytes_(slot);
+  evict_to_budget_(lock);
+}
+
+void FrameCache::set_budget(std::size_t byte_budget) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  options_.byte_budget = byte_budget;
+  evict_to_budget_(lock);
+}
+
+std::size_t FrameCache::budget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return options_.byte_budget;
+}
+
+void FrameCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  slots_.clear();
+  free_.clear();
+  index_.clear();
+  hand_ = 0;
+  stats_.bytes = 0;
+  stats_.compressed_entries = 0;
+}
+
+FrameCache::Stats FrameCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats s = stats_;
+  s.entries = index_.size();
+  return s;
+}
+
+std::size_t FrameCache::slot_bytes_(const Slot& slot) {
+  return slot.packed ? slot.packed->size() : slot.elems * sizeof(float);
+}
+
+void FrameCache::release_(std::size_t index) {
+  Slot& slot = slots_[index];
+  stats_.bytes -= slot_bytes_(slot);
+  if (slot.packed) --stats_.compressed_entries;
+  index_.erase(slot.key);
+  slot = Slot{};
+  free_.push_back(index);
+}
+
+void FrameCache::evict_to_budget_(std::unique_lock<std::mutex>& lock) {
+  // Two sweeps without a change mean the remaining bytes sit in entries other threads are
+  // compressing; they shrink the total when they finish.
+  std::size_t idle = 0;
+  while (stats_.bytes > options_.byte_budget && !index_.empty() && idle <= 2 * slots_.size()) {
+    if (hand_ >= slots_.size()) hand_ = 0;
+    const std::size_t index = hand_++;
+    Slot& slot = slots_[index];
+    if (!slot.used || slot.compressing) {
+      ++idle;
+      continue;
+    }
+    if (slot.referenced) {
+      slot.referenced = false;
+      ++idle;
+      continue;
+    }
+    idle = 0;
+    if (!options_.compress_cold || !slot.raw) {
+      release_(index);
+      ++stats_.evictions;
+      continue;
+    }
+
+    // Compress outside the lock; like a promotion in lookup(), the result only replaces the
+    // entry if it still holds the same frame.
+    const OutputKey key = slot.key;
+    const std::shared_ptr<const Frame> raw = slot.raw;
+    slot.compressing = true;
+    const auto unchanged = [&]() -> Slot* {
+      auto it = index_.find(key);
+      return it != index_.end() && slots_[it->second].raw == raw ? &slots_[it->second] : nullptr;
+    };
+    std::shared_ptr<const Packed> packed;
+    lock.unlock();
+    try {
+      packed = std::make_shared<const Packed>(encode(*raw));
+    } catch (...) {
+      lock.lock();
+      if (Slot* s = unchanged()) s->compressing = false;
+      throw;
+    }
+    lock.lock();
+    Slot* s = unchanged();
+    if (!s) continue;
+    s->compressing = false;
+    if (packed->size() < slot_bytes_(*s)) {
+      stats_.bytes -= slot_bytes_(*s);
+      s->raw.reset();
+      s->packed = std::move(packed);
+      stats_.bytes += slot_bytes_(*s);
+      ++stats_.compressions;
+      ++stats_.compressed_entries;
+    } else {
+      release_(static_cast<std::size_t>(s - slots_.data()));
+      ++stats_.evictions;
+    }
+  }
+}
+
+}  // namespace minfi
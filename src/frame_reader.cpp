@@ -0,0 +1,602 @@
+#include "minfi/frame_reader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "minfi/memory.hpp"
+
+namespace minfi {
+
+namespace {
+
+constexpr std::size_t kDirectAlign = 4096;
+
+std::size_t align_up(std::size_t n) { return (n + kDirectAlign - 1) & ~(kDirectAlign - 1); }
+
+struct ReadRequest {
+  std::size_t slot;
+  int fd;
+  std::uint64_t offset;
+  std::size_t length;
+  std::byte* dst;
+};
+
+struct ReadCompletion {
+  std::size_t slot;
+  long result;  // bytes read, or -errno
+};
+
+class Engine {
+ public:
+  virtual ~Engine() = default;
+  virtual void submit(const ReadRequest& req) = 0;
+  // Blocks for the next completion of a submitted request.
+  virtual ReadCompletion wait() = 0;
+  // A completion that has already landed, without blocking.
+  virtual std::optional<ReadCompletion> poll() = 0;
+};
+
+// ---- pread worker pool ----
+
+class ThreadEngine final : public Engine {
+ public:
+  explicit ThreadEngine(std::size_t threads) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, threads); ++i) {
+      workers_.emplace_back([this] { run_(); });
+    }
+  }
+
+  ~ThreadEngine() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    jobs_cv_.notify_all();
+    for (auto& w : workers_) w.join();
+  }
+
+  void submit(const ReadRequest& req) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(req);
+    }
+    jobs_cv_.notify_one();
+  }
+
+  std::optional<ReadCompletion> poll() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (done_.empty()) return std::nullopt;
+    ReadCompletion c = done_.front();
+    done_.pop_front();
+    return c;
+  }
+
+  ReadCompletion wait() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return !done_.empty(); });
+    ReadCompletion c = done_.front();
+    done_.pop_front();
+    return c;
+  }
+
+ private:
+  void run_() {
+    for (;;) {
+      ReadRequest req;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobs_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) return;
+        req = jobs_.front();
+        jobs_.pop_front();
+      }
+      const ssize_t n = ::pread(req.fd, req.dst, req.length, static_cast<off_t>(req.offset));
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.push_back({req.slot, n < 0 ? -static_cast<long>(errno) : static_cast<long>(n)});
+      }
+      done_cv_.notify_one();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable jobs_cv_;
+  std::condition_variable done_cv_;
+  std::deque<ReadRequest> jobs_;
+  std::deque<ReadCompletion> done_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// ---- io_uring ----
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+class UringEngine final : public Engine {
+ public:
+  // nullptr when io_uring is unavailable (old kernel, seccomp, disabled by sysctl).
+  static std::unique_ptr<UringEngine> create(unsigned entries) {
+    io_uring_params p{};
+    const long fd = ::syscall(__NR_io_uring_setup, entries, &p);
+    if (fd < 0) return nullptr;
+    auto e = std::unique_ptr<UringEngine>(new UringEngine());
+    e->fd_ = static_cast<int>(fd);
+    if (!e->map_(p)) return nullptr;
+    return e;
+  }
+
+  ~UringEngine() override {
+    if (sqes_) ::munmap(sqes_, sqes_bytes_);
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_bytes_);
+    if (sq_ptr_) ::munmap(sq_ptr_, sq_bytes_);
+    if (fd_ >= 0) ::close(fd_);
+  }
+
+  void submit(const ReadRequest& req) override {
+    const unsigned tail = *sq_tail_;
+    const unsigned idx = tail & *sq_mask_;
+    io_uring_sqe& sqe = sqes_[idx];
+    std::memset(&sqe, 0, sizeof sqe);
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = req.fd;
+    sqe.off = req.offset;
+    sqe.addr = reinterpret_cast<std::uint64_t>(req.dst);
+    sqe.len = static_cast<std::uint32_t>(req.length);
+    sqe.user_data = req.slot;
+    sq_array_[idx] = idx;
+    std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+    for (;;) {
+      const long r = ::syscall(__NR_io_uring_enter, fd_, 1, 0, 0, nullptr, 0);
+      if (r >= 0) break;
+      if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        throw std::runtime_error("RawFrameReader: io_uring_enter failed: " +
+                                 std::string(std::strerror(errno)));
+      }
+    }
+  }
+
+  std::optional<ReadCompletion> poll() override {
+    const unsigned head = std::atomic_ref<unsigned>(*cq_head_).load(std::memory_order_relaxed);
+    const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+    if (head == tail) return std::nullopt;
+    const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+    const ReadCompletion c{static_cast<std::size_t>(cqe.user_data), cqe.res};
+    std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release);
+    return c;
+  }
+
+  ReadCompletion wait() override {
+    for (;;) {
+      if (auto c = poll()) return *c;
+      const long r =
+          ::syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (r < 0 && errno != EINTR) {
+        throw std::runtime_error("RawFrameReader: io_uring wait failed: " +
+                                 std::string(std::strerror(errno)));
+      }
+    }
+  }
+
+ private:
+  UringEngine() = default;
+
+  bool map_(const io_uring_params& p) {
+    sq_bytes_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_bytes_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single) sq_bytes_ = cq_bytes_ = std::max(sq_bytes_, cq_bytes_);
+    sq_ptr_ = ::mmap(nullptr, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                     IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED) {
+      sq_ptr_ = nullptr;
+      return false;
+    }
+    if (single) {
+      cq_ptr_ = sq_ptr_;
+    } else {
+      cq_ptr_ = ::mmap(nullptr, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd_, IORING_OFF_CQ_RING);
+      if (cq_ptr_ == MAP_FAILED) {
+        cq_ptr_ = nullptr;
+        return false;
+      }
+    }
+    sqes_bytes_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<std::byte*>(sq_ptr_);
+    auto* cq = static_cast<std::byte*>(cq_ptr_);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+  }
+
+  int fd_ = -1;
+  void* sq_ptr_ = nullptr;
+  void* cq_ptr_ = nullptr;
+  std::size_t sq_bytes_ = 0;
+  std::size_t cq_bytes_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  std::size_t sqes_bytes_ = 0;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+#endif
+
+// Opens read-only, with O_DIRECT when requested and accepted by the filesystem.
+int open_frame_file(const std::string& path, bool& direct) {
+#if defined(O_DIRECT)
+  if (direct) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    if (fd >= 0) return fd;
+    if (errno != EINVAL) {
+      throw std::runtime_error("RawFrameReader: cannot open '" + path + "': " +
+                               std::strerror(errno));
+    }
+  }
+#endif
+  direct = false;
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("RawFrameReader: cannot open '" + path + "': " +
+                             std::strerror(errno));
+  }
+  return fd;
+}
+
+// One request reads a whole frame and io_uring lengths are 32-bit.
+void check_frame_bytes(std::size_t frame_bytes) {
+  if (frame_bytes == 0) throw std::invalid_argument("RawFrameReader: frame_bytes must be > 0");
+  if (align_up(frame_bytes) > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("RawFrameReader: frames of 4 GiB or more are not supported");
+  }
+}
+
+}  // namespace
+
+const char* to_string(ReadBackend backend) {
+  switch (backend) {
+    case ReadBackend::Auto:
+      return "auto";
+    case ReadBackend::IoUring:
+      return "io_uring";
+    case ReadBackend::Threads:
+      return "threads";
+  }
+  return "unknown";
+}
+
+struct RawFrameReader::Buffer::Owner {
+  virtual ~Owner() = default;
+  virtual void release(std::size_t slot) = 0;
+};
+
+struct RawFrameReader::Impl final : RawFrameReader::Buffer::Owner {
+  enum class State : std::uint8_t { Free, InFlight, Ready, Held };
+
+  struct Slot {
+    std::byte* data = nullptr;
+    State state = State::Free;
+    std::size_t frame = 0;
+    int fd = -1;  // per-frame files: open while the read is in flight
+    std::size_t done = 0;
+    int error = 0;
+  };
+
+  std::vector<std::string> paths;  // one per frame, or a single file
+  bool single_file = true;
+  int file_fd = -1;
+  std::size_t count = 0;
+  std::size_t frame_bytes = 0;
+  std::size_t read_bytes = 0;  // per request: frame_bytes, rounded up under O_DIRECT
+  std::size_t header_bytes = 0;
+  std::size_t readahead = 0;
+  bool direct = false;
+  ReadBackend backend = ReadBackend::Threads;
+  std::unique_ptr<Engine> engine;
+
+  std::mutex mutex;  // guards slot states against Buffer releases from other threads
+  std::vector<Slot> slots;
+  std::deque<std::size_t> pending;  // submitted, not yet delivered, in frame order
+  std::size_t submitted = 0;
+  std::size_t delivered = 0;
+  std::size_t in_flight = 0;
+  std::string failure;  // first read error; every later next() reports it again
+  Stats stats;
+
+  // Sizes the slot pool and picks the engine once the files are open.
+  void start(std::size_t bytes, const FrameReaderOptions& o) {
+    frame_bytes = bytes;
+    read_bytes = direct ? align_up(bytes) : bytes;
+    readahead = std::max<std::size_t>(1, o.readahead);
+    slots.resize(readahead + 2);
+    for (Slot& s : slots) {
+      s.data = static_cast<std::byte*>(
+          tracked_resource(Subsystem::Frames)->allocate(read_bytes, kDirectAlign));
+    }
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    if (o.backend != ReadBackend::Threads) {
+      engine = UringEngine::create(static_cast<unsigned>(std::bit_ceil(readahead)));
+      if (engine) backend = ReadBackend::IoUring;
+    }
+#endif
+    if (!engine) {
+      if (o.backend == ReadBackend::IoUring) {
+        throw std::runtime_error("RawFrameReader: io_uring is not available");
+      }
+      engine = std::make_unique<ThreadEngine>(o.threads);
+      backend = ReadBackend::Threads;
+    }
+  }
+
+  ~Impl() override {
+    // Reads still in flight target slot memory; let them land before freeing it.
+    try {
+      while (in_flight > 0) complete_(engine->wait());
+    } catch (...) {
+    }
+    engine.reset();
+    for (Slot& s : slots) {
+      if (s.fd >= 0) ::close(s.fd);
+      if (s.data) tracked_resource(Subsystem::Frames)->deallocate(s.data, read_bytes,
+                                                                  kDirectAlign);
+    }
+    if (file_fd >= 0) ::close(file_fd);
+  }
+
+  void release(std::size_t slot) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    slots[slot].state = State::Free;
+  }
+
+  void submit_(std::size_t slot, std::size_t offset_in_frame) {
+    Slot& s = slots[slot];
+    const int fd = single_file ? file_fd : s.fd;
+    const std::uint64_t base = single_file ? header_bytes + std::uint64_t{s.frame} * frame_bytes
+                                           : 0;
+    engine->submit({slot, fd, base + offset_in_frame, read_bytes - offset_in_frame,
+                    s.data + offset_in_frame});
+    ++in_flight;
+  }
+
+  // Reads the rest of a short O_DIRECT read synchronously through the page cache.
+  void finish_buffered_(Slot& s) {
+    const std::string& path = paths[single_file ? 0 : s.frame];
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      s.error = errno;
+      return;
+    }
+    const std::uint64_t base = single_file ? header_bytes + std::uint64_t{s.frame} * frame_bytes
+                                           : 0;
+    while (s.done < frame_bytes) {
+      const ssize_t n = ::pread(fd, s.data + s.done, frame_bytes - s.done,
+                                static_cast<off_t>(base + s.done));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) {
+        s.error = n < 0 ? errno : -1;  // -1: truncated
+        break;
+      }
+      s.done += static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+  }
+
+  void fill_() {
+    while (submitted < count && pending.size() < readahead) {
+      std::size_t slot = slots.size();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+          if (slots[i].state == State::Free) {
+            slot = i;
+            slots[i].state = State::InFlight;
+            break;
+          }
+        }
+      }
+      if (slot == slots.size()) return;
+      Slot& s = slots[slot];
+      if (!single_file) {
+        // A failed open leaves `submitted` alone, so a retry reports the same frame again.
+        bool d = direct;
+        try {
+          s.fd = open_frame_file(paths[submitted], d);
+        } catch (...) {
+          release(slot);
+          throw;
+        }
+      }
+      s.frame = submitted++;
+      s.done = 0;
+      s.error = 0;
+      submit_(slot, 0);
+      pending.push_back(slot);
+    }
+  }
+
+  void complete_(const ReadCompletion& c) {
+    --in_flight;
+    Slot& s = slots[c.slot];
+    if (c.result == -EINTR || c.result == -EAGAIN) {
+      submit_(c.slot, s.done);
+      return;
+    }
+    if (c.result < 0) {
+      s.error = static_cast<int>(-c.result);
+    } else if (c.result == 0) {
+      if (s.done < frame_bytes) s.error = -1;  // truncated
+    } else {
+      s.done += static_cast<std::size_t>(c.result);
+      if (s.done < frame_bytes && !direct) {
+        submit_(c.slot, s.done);
+        return;
+      }
+      // O_DIRECT cannot resume at an unaligned offset; finish the frame with buffered reads.
+      if (s.done < frame_bytes) finish_buffered_(s);
+    }
+    if (!single_file && s.fd >= 0) {
+      ::close(s.fd);
+      s.fd = -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    s.state = State::Ready;
+  }
+};
+
+RawFrameReader::Buffer::Buffer(Buffer&& other) noexcept
+    : owner_(std::move(other.owner_)),
+      slot_(other.slot_),
+      index_(other.index_),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+RawFrameReader::Buffer& RawFrameReader::Buffer::operator=(Buffer&& other) noexcept {
+  Buffer tmp(std::move(other));
+  std::swap(owner_, tmp.owner_);
+  std::swap(slot_, tmp.slot_);
+  std::swap(index_, tmp.index_);
+  std::swap(data_, tmp.data_);
+  std::swap(size_, tmp.size_);
+  return *this;
+}
+
+RawFrameReader::Buffer::~Buffer() {
+  if (owner_) owner_->release(slot_);
+}
+
+RawFrameReader::RawFrameReader(std::shared_ptr<Impl> impl) : impl_(std::move(impl)) {}
+RawFrameReader::RawFrameReader(RawFrameReader&&) noexcept = default;
+RawFrameReader& RawFrameReader::operator=(RawFrameReader&&) noexcept = default;
+RawFrameReader::~RawFrameReader() = default;
+
+RawFrameReader RawFrameReader::open(const std::string& path, std::size_t frame_bytes,
+                                    const FrameReaderOptions& options) {
+  check_frame_bytes(frame_bytes);
+  auto impl = std::make_shared<Impl>();
+  impl->paths = {path};
+  impl->header_bytes = options.header_bytes;
+  // O_DIRECT needs file offsets, lengths and buffers aligned to the logical block size.
+  impl->direct = options.direct_io && frame_bytes % kDirectAlign == 0 &&
+                 options.header_bytes % kDirectAlign == 0;
+  impl->file_fd = open_frame_file(path, impl->direct);
+  struct stat st {};
+  if (::fstat(impl->file_fd, &st) != 0) {
+    throw std::runtime_error("RawFrameReader: cannot stat '" + path + "'");
+  }
+  const auto size = static_cast<std::size_t>(st.st_size);
+  impl->count = size > options.header_bytes ? (size - options.header_bytes) / frame_bytes : 0;
+  impl->start(frame_bytes, options);
+  return RawFrameReader(std::move(impl));
+}
+
+RawFrameReader RawFrameReader::open(std::vector<std::string> paths, std::size_t frame_bytes,
+                                    const FrameReaderOptions& options) {
+  check_frame_bytes(frame_bytes);
+  auto impl = std::make_shared<Impl>();
+  impl->single_file = false;
+  impl->count = paths.size();
+  impl->paths = std::move(paths);
+  // Each file is read from offset 0 with the length rounded up, so only the buffer needs
+  // aligning; a short final block simply ends the read early.
+  impl->direct = options.direct_io;
+  impl->start(frame_bytes, options);
+  return RawFrameReader(std::move(impl));
+}
+
+std::size_t RawFrameReader::frame_count() const { return impl_->count; }
+std::size_t RawFrameReader::frame_bytes() const { return impl_->frame_bytes; }
+ReadBackend RawFrameReader::backend() const { return impl_->backend; }
+bool RawFrameReader::direct_io() const { return impl_->direct; }
+RawFrameReader::Stats RawFrameReader::stats() const { return impl_->stats; }
+
+std::optional<RawFrameReader::Buffer> RawFrameReader::next() {
+  Impl& im = *impl_;
+  if (!im.failure.empty()) throw std::runtime_error(im.failure);
+  if (im.delivered >= im.count) return std::nullopt;
+  im.fill_();
+  if (im.pending.empty()) {
+    throw std::logic_error("RawFrameReader: every buffer is held by the caller");
+  }
+  const std::size_t slot = im.pending.front();
+  const auto ready = [&] {
+    std::lock_guard<std::mutex> lock(im.mutex);
+    return im.slots[slot].state == Impl::State::Ready;
+  };
+  // Reap whatever has landed; only a still-missing head frame counts as a stall.
+  while (auto c = im.engine->poll()) im.complete_(*c);
+  if (!ready()) {
+    const auto t0 = std::chrono::steady_clock::now();
+    do {
+      im.complete_(im.engine->wait());
+    } while (!ready());
+    ++im.stats.stalls;
+    im.stats.stall_ns += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             t0)
+            .count());
+  }
+  im.pending.pop_front();
+  Impl::Slot& s = im.slots[slot];
+  if (s.error != 0) {
+    const std::string what = s.error < 0 ? "truncated frame " + std::to_string(s.frame)
+                                         : "read of frame " + std::to_string(s.frame) +
+                                               " failed: " + std::strerror(s.error);
+    im.release(slot);
+    im.failure = "RawFrameReader: " + what;
+    throw std::runtime_error(im.failure);
+  }
+  {
+    std::lock_guard<std::mutex> lock(im.mutex);
+    s.state = Impl::State::Held;
+  }
+  Buffer buf;
+  buf.owner_ = impl_;
+  buf.slot_ = slot;
+  buf.index_ = s.frame;
+  buf.data_ = s.data;
+  buf.size_ = im.frame_bytes;
+  ++im.delivered;
+  ++im.stats.frames;
+  im.stats.bytes += im.frame_bytes;
+  // Keep the pipeline full while the caller works on this frame.
+  im.fill_();
+  return buf;
+}
+
+}  // namespace minfi
@@ -0,0 +1,228 @@
+#include "minfi/frame_source.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace minfi {
+
+MutablePackedImageView DecodeTarget::reshape(std::size_t width, std::size_t height,
+                                             PixelFormat format) {
+  pixels_.resize(width * height * bytes_per_pixel(format));
+  width_ = width;
+  height_ = height;
+  format_ = format;
+  return {pixels_.data(), width, height, format};
+}
+
+struct ParallelFrameSource::Frame::Owner {
+  virtual ~Owner() = default;
+  virtual void release(std::size_t slot) = 0;
+};
+
+struct ParallelFrameSource::Impl final : ParallelFrameSource::Frame::Owner {
+  enum class State : std::uint8_t { Free, Decoding, Ready, Held };
+
+  struct Slot {
+    State state = State::Free;
+    std::size_t index = 0;
+    DecodeTarget target;
+    std::exception_ptr error;
+  };
+
+  DecodeFn decode;
+  std::size_t window = 0;
+
+  mutable std::mutex mutex;
+  std::condition_variable work_cv;   // a slot freed, the window moved, or stopping
+  std::condition_variable ready_cv;  // a decode finished
+  std::vector<Slot> slots;
+  std::size_t end = kUnknownCount;  // first index past the stream
+  std::size_t dispatched = 0;       // next index to hand to a decode thread
+  std::size_t delivered = 0;        // next index next() returns
+  bool stopping = false;
+  Stats stats;
+  std::vector<std::thread> workers;
+
+  void release(std::size_t slot) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      slots[slot].state = State::Free;
+      slots[slot].error = nullptr;
+    }
+    work_cv.notify_one();
+  }
+
+  // Requires the lock.
+  Slot* find_free_() {
+    for (Slot& s : slots) {
+      if (s.state == State::Free) return &s;
+    }
+    return nullptr;
+  }
+
+  Slot* find_ready_(std::size_t index) {
+    for (Slot& s : slots) {
+      if (s.state == State::Ready && s.index == index) return &s;
+    }
+    return nullptr;
+  }
+
+  bool can_dispatch_() {
+    return dispatched < end && dispatched < delivered + window && find_free_() != nullptr;
+  }
+
+  void run_() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      work_cv.wait(lock, [this] { return stopping || can_dispatch_(); });
+      if (stopping) return;
+      Slot& slot = *find_free_();
+      slot.state = State::Decoding;
+      slot.index = dispatched++;
+      lock.unlock();
+
+      bool ok = true;
+      std::exception_ptr error;
+      try {
+        ok = decode(slot.index, slot.target);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      lock.lock();
+      if (!ok) {
+        end = std::min(end, slot.index);
+        slot.state = State::Free;
+        // Frames decoded past a newly found end are dropped.
+        for (Slot& s : slots) {
+          if (s.state == State::Ready && s.index >= end) s.state = State::Free;
+        }
+        work_cv.notify_all();
+      } else if (slot.index >= end) {
+        slot.state = State::Free;
+      } else {
+        slot.state = State::Ready;
+        slot.error = error;
+        if (!error) ++stats.decoded;
+      }
+      ready_cv.notify_all();
+    }
+  }
+
+  void stop_() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto& w : workers) w.join();
+    workers.clear();
+  }
+};
+
+ParallelFrameSource::Frame::Frame(Frame&& other) noexcept
+    : owner_(std::move(other.owner_)),
+      slot_(other.slot_),
+      index_(other.index_),
+      target_(std::exchange(other.target_, nullptr)) {}
+
+ParallelFrameSource::Frame& ParallelFrameSource::Frame::operator=(Frame&& other) noexcept {
+  Frame tmp(std::move(other));
+  std::swap(owner_, tmp.owner_);
+  std::swap(slot_, tmp.slot_);
+  std::swap(index_, tmp.index_);
+  std::swap(target_, tmp.target_);
+  return *this;
+}
+
+ParallelFrameSource::Frame::~Frame() {
+  if (owner_) owner_->release(slot_);
+}
+
+ParallelFrameSource::ParallelFrameSource(std::size_t count, DecodeFn decode,
+                                         const FrameSourceOptions& options)
+    : impl_(std::make_shared<Impl>()) {
+  if (!decode) throw std::invalid_argument("ParallelFrameSource: empty decode function");
+  if (options.window == 0) throw std::invalid_argument("ParallelFrameSource: window must be > 0");
+  impl_->decode = std::move(decode);
+  impl_->window = options.window;
+  impl_->end = count;
+  // The window plus the pair the consumer typically holds.
+  impl_->slots = std::vector<Impl::Slot>(options.window + 2);
+  std::size_t threads = options.threads;
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  for (std::size_t i = 0; i < threads; ++i) {
+    impl_->workers.emplace_back([impl = impl_.get()] { impl->run_(); });
+  }
+}
+
+ParallelFrameSource::~ParallelFrameSource() { impl_->stop_(); }
+
+std::optional<ParallelFrameSource::Frame> ParallelFrameSource::next() {
+  Impl& im = *impl_;
+  std::unique_lock<std::mutex> lock(im.mutex);
+  Impl::Slot* slot = nullptr;
+  const auto arrived = [&] {
+    slot = im.delivered < im.end ? im.find_ready_(im.delivered) : nullptr;
+    return slot != nullptr || im.delivered >= im.end;
+  };
+  if (!arrived()) {
+    const bool in_progress = im.dispatched > im.delivered;
+    if (!in_progress && im.find_free_() == nullptr) {
+      throw std::logic_error("ParallelFrameSource: every buffer is held by the caller");
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    im.ready_cv.wait(lock, arrived);
+    ++im.stats.stalls;
+    im.stats.stall_ns += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             t0)
+            .count());
+  }
+  if (!slot) return std::nullopt;
+
+  std::size_t ahead = 0;
+  for (const Impl::Slot& s : im.slots) {
+    if (s.state == Impl::State::Ready && s.index > im.delivered) ++ahead;
+  }
+  im.stats.max_reorder = std::max(im.stats.max_reorder, ahead);
+  ++im.delivered;
+  if (slot->error) {
+    std::exception_ptr error = std::exchange(slot->error, nullptr);
+    slot->state = Impl::State::Free;
+    lock.unlock();
+    im.work_cv.notify_all();
+    std::rethrow_exception(error);
+  }
+  slot->state = Impl::State::Held;
+  Frame frame;
+  frame.owner_ = impl_;
+  frame.slot_ = static_cast<std::size_t>(slot - im.slots.data());
+  frame.index_ = slot->index;
+  frame.target_ = &slot->target;
+  lock.unlock();
+  // The window moved forward by one.
+  im.work_cv.notify_all();
+  return frame;
+}
+
+std::size_t ParallelFrameSource::frame_count() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return impl_->end;
+}
+
+std::size_t ParallelFrameSource::thread_count() const { return impl_->workers.size(); }
+
+ParallelFrameSource::Stats ParallelFrameSource::stats() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return impl_->stats;
+}
+
+}  // namespace minfi
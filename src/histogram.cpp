@@ -0,0 +1,95 @@
+#include "minfi/histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace minfi {
+
+// Layout: indices [0, sub_count) hold values 0 .. sub_count - 1 exactly. Above that, bucket
+// b >= 1 covers [2^(bits - 1 + b), 2^(bits + b)) with half = sub_count / 2 slots of width 2^b.
+
+LatencyHistogram::LatencyHistogram(unsigned precision_bits)
+    : bits_(precision_bits), sub_count_(std::uint64_t{1} << precision_bits) {
+  if (precision_bits < 2 || precision_bits > 16) {
+    throw std::invalid_argument("LatencyHistogram: precision_bits must be in [2, 16]");
+  }
+  const std::uint64_t half = sub_count_ / 2;
+  counts_.assign(static_cast<std::size_t>(sub_count_ + (64 - bits_) * half), 0);
+}
+
+std::size_t LatencyHistogram::index_of_(std::uint64_t value) const {
+  if (value < sub_count_) return static_cast<std::size_t>(value);
+  const unsigned msb = 63u - static_cast<unsigned>(std::countl_zero(value));
+  const unsigned b = msb - (bits_ - 1);  // >= 1
+  const std::uint64_t half = sub_count_ / 2;
+  return static_cast<std::size_t>(sub_count_ + (b - 1) * half + ((value >> b) - half));
+}
+
+std::uint64_t LatencyHistogram::lowest_of_(std::size_t index) const {
+  if (index < sub_count_) return index;
+  const std::uint64_t half = sub_count_ / 2;
+  const std::uint64_t rel = index - sub_count_;
+  const unsigned b = static_cast<unsigned>(rel / half) + 1;
+  return (half + rel % half) << b;
+}
+
+std::uint64_t LatencyHistogram::highest_of_(std::size_t index) const {
+  if (index < sub_count_) return index;
+  const unsigned b = static_cast<unsigned>((index - sub_count_) / (sub_count_ / 2)) + 1;
+  return lowest_of_(index) + ((std::uint64_t{1} << b) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t value, std::uint64_t count) {
+  if (count == 0) return;
+  counts_[index_of_(value)] += count;
+  total_ += count;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  sum_ += static_cast<long double>(value) * static_cast<long double>(count);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.bits_ != bits_) {
+    throw std::invalid_argument("LatencyHistogram: cannot merge different precisions");
+  }
+  for (std::size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+  total_ += other.total_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+}
+
+void LatencyHistogram::reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  total_ = 0;
+  min_ = UINT64_MAX;
+  max_ = 0;
+  sum_ = 0;
+}
+
+double LatencyHistogram::mean() const {
+  return total_ ? static_cast<double>(sum_ / static_cast<long double>(total_)) : 0.0;
+}
+
+std::uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+  if (total_ == 0) return 0;
+  const double p = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total_))));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) return std::min(highest_of_(i), max_);
+  }
+  return max_;
+}
+
+std::uint64_t LatencyHistogram::count_above(std::uint64_t value) const {
+  std::uint64_t n = 0;
+  for (std::size_t i = index_of_(value) + 1; i < counts_.size(); ++i) n += counts_[i];
+  return n;
+}
+
+}  // namespace minfi
@@ -1,28 +1,22 @@
 #include "minfi/interpolate.hpp"
 
-#include <algorithm>
+#include <span>
 #include <stdexcept>
 
-namespace minfi {
+#include "minfi/tuning.hpp"
 
-namespace {
-inline float clamp01(float x) {
-  if (x < 0.0f) return 0.0f;
-  if (x > 1.0f) return 1.0f;
-  return x;
-}
-}  // namespace
+namespace minfi {
 
 Frame interpolate(const Frame& a, const Frame& b, float t) {
   if (a.size() != b.size()) {
     throw std::invalid_argument("interpolate: frame size mismatch");
   }
-  const float u = clamp01(t);
   Frame out;
   out.resize(a.size());
-  for (size_t i = 0; i < a.size(); ++i) {
-    out[i] = a[i] * (1.0f - u) + b[i] * u;
-  }
+  // Tile size, threads and kernel come from the calibrated config (serial by default).
+  interpolate_tuned_into(std::span<const float>(a), std::span<const float>(b),
+                         std::span<float>(out), t,
+                         detail::cached_active_tuning().select(a.size()));
   return out;
 }
 
@@ -0,0 +1,80 @@
+#include "minfi/lazy.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+LazyInterpolation::LazyInterpolation(std::span<const float> a, std::span<const float> b,
+                                     FrameShape shape, float t, std::size_t cached_rows)
+    : a_(a), b_(b), shape_(shape), t_(t), cache_(std::max<std::size_t>(1, cached_rows)) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if (a.size() != shape.elems()) {
+    throw std::invalid_argument("LazyInterpolation: frame size does not match shape");
+  }
+}
+
+void LazyInterpolation::compute_(std::size_t y, std::size_t x0, std::size_t n, float* dst) const {
+  const std::size_t off = y * shape_.row_elems() + x0;
+  interpolate_into<float>(a_.subspan(off, n), b_.subspan(off, n), std::span<float>(dst, n), t_);
+}
+
+std::span<const float> LazyInterpolation::row(std::size_t y) {
+  if (y >= shape_.height) {
+    throw std::out_of_range("LazyInterpolation: row out of range");
+  }
+  for (const auto& c : cache_) {
+    if (c.y == y) return c.data;
+  }
+  CachedRow& slot = cache_[next_slot_];
+  next_slot_ = (next_slot_ + 1) % cache_.size();
+  slot.data.resize(shape_.row_elems());
+  compute_(y, 0, shape_.row_elems(), slot.data.data());
+  slot.y = y;
+  ++rows_computed_;
+  return slot.data;
+}
+
+void LazyInterpolation::read_rows(std::size_t y0, std::size_t count, std::span<float> dst) const {
+  if (y0 > shape_.height || count > shape_.height - y0) {
+    throw std::out_of_range("LazyInterpolation: rows out of range");
+  }
+  const std::size_t row_elems = shape_.row_elems();
+  if (dst.size() < count * row_elems) {
+    throw std::invalid_argument("LazyInterpolation: destination too small");
+  }
+  // Rows are contiguous in the source, so a run of rows is a single kernel call.
+  const std::size_t off = y0 * row_elems;
+  const std::size_t n = count * row_elems;
+  interpolate_into<float>(a_.subspan(off, n), b_.subspan(off, n), dst.first(n), t_);
+  rows_computed_ += count;
+}
+
+void LazyInterpolation::read_tile(std::size_t x0, std::size_t y0, std::size_t w, std::size_t h,
+                                  std::span<float> dst, std::size_t dst_stride) const {
+  if (x0 > shape_.width || w > shape_.width - x0 || y0 > shape_.height ||
+      h > shape_.height - y0) {
+    throw std::out_of_range("LazyInterpolation: tile out of range");
+  }
+  const std::size_t tile_row = w * shape_.channels;
+  if (dst_stride == 0) dst_stride = tile_row;
+  if (dst_stride < tile_row || (h > 0 && dst.size() < (h - 1) * dst_stride + tile_row)) {
+    throw std::invalid_argument("LazyInterpolation: destination too small");
+  }
+  for (std::size_t r = 0; r < h; ++r) {
+    compute_(y0 + r, x0 * shape_.channels, tile_row, dst.data() + r * dst_stride);
+  }
+  rows_computed_ += h;
+}
+
+Frame LazyInterpolation::materialize() const {
+  Frame out(shape_.elems());
+  read_rows(0, shape_.height, out);
+  return out;
+}
+
+}  // namespace minfi
@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -6,6 +7,10 @@
 #include <vector>
 
 #include "minfi/interpolate.hpp"
+#include "minfi/tuning.hpp"
+#if defined(MINFI_WITH_CLUSTER)
+#include "cluster.hpp"
+#endif
 #if defined(MINFI_WITH_VIEWER)
 #include "viewer/viewer.hpp"
 #endif
@@ -18,11 +23,87 @@ static void print_usage(const char* argv0) {
   cout << "\nUsage:\n";
   cout << "  " << argv0 << " <t>\n\n";
   cout << "Where <t> is interpolation factor in [0,1].\n";
+  cout << "\nCalibration:\n";
+  cout << "  " << argv0 << " --calibrate [config path]\n";
+  cout << "      Benchmarks tile size, thread count and kernel for typical frame sizes and\n";
+  cout << "      writes the winners to the config loaded at startup (MINFI_TUNING_FILE, or\n";
+  cout << "      ~/.config/minfi/tuning.conf).\n";
+#if defined(MINFI_WITH_CLUSTER)
+  cout << "\nMulti-process mode:\n";
+  cout << "  " << argv0 << " --coordinator [--input <raw f32>] [--frame-elems N]\n";
+  cout << "      [--synthetic F] [--factor K] [--workers W] [--segment S]\n";
+  cout << "      [--endpoint unix:<path>|tcp:<ip>:<port>]\n";
+  cout << "      [--output <raw f32>] [--timeout-ms MS] [--verify] [--inject-failure]\n";
+  cout << "  " << argv0 << " --worker --connect <endpoint> [--crash-after N]\n";
+#endif
   cout << "\nOptions (CMake):\n";
   cout << "  -DMINFI_WITH_VIEWER=ON to enable on-screen rendering (default ON).\n";
 }
 
+#if defined(MINFI_WITH_CLUSTER)
+static int run_cluster_mode(int argc, char** argv) {
+  const string mode = argv[1];
+  minfi::cluster::CoordinatorOptions co;
+  minfi::cluster::WorkerOptions wo;
+  co.self_exe = argv[0];
+  for (int i = 2; i < argc; ++i) {
+    const string arg = argv[i];
+    const auto value = [&]() -> string {
+      if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+      return argv[++i];
+    };
+    if (arg == "--input") co.input = value();
+    else if (arg == "--frame-elems") co.frame_elems = std::stoul(value());
+    else if (arg == "--synthetic") co.synthetic_frames = std::stoul(value());
+    else if (arg == "--factor") co.factor = std::stoul(value());
+    else if (arg == "--workers") co.workers = std::stoul(value());
+    else if (arg == "--segment") co.segment_frames = std::stoul(value());
+    else if (arg == "--endpoint") co.endpoint = value();
+    else if (arg == "--output") co.output = value();
+    else if (arg == "--timeout-ms") co.job_timeout_ms = std::stoi(value());
+    else if (arg == "--verify") co.verify = true;
+    else if (arg == "--inject-failure") co.inject_failure = true;
+    else if (arg == "--connect") wo.endpoint = value();
+    else if (arg == "--crash-after") wo.crash_after = std::stoi(value());
+    else throw std::invalid_argument("unknown option " + arg);
+  }
+  return mode == "--worker" ? minfi::cluster::run_worker(wo) : minfi::cluster::run_coordinator(co);
+}
+#endif
+
+static int run_calibration(const std::filesystem::path& path) {
+  if (path.empty()) throw std::invalid_argument("no config path (set HOME or pass one)");
+  cout << "Calibrating..." << std::endl;
+  const minfi::TuningConfig config = minfi::calibrate();
+  minfi::save_tuning(config, path);
+  for (const auto& e : config.entries) {
+    cout << "  >= " << e.min_elems << " elems: tile " << e.tile_elems << ", threads " << e.threads
+         << ", kernel " << minfi::to_string(e.kernel) << "\n";
+  }
+  cout << "Wrote " << path.string() << "\n";
+  return EXIT_SUCCESS;
+}
+
 int main(int argc, char** argv) {
+#if defined(MINFI_WITH_CLUSTER)
+  if (argc >= 2 && (string(argv[1]) == "--coordinator" || string(argv[1]) == "--worker")) {
+    try {
+      return run_cluster_mode(argc, argv);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n\n";
+      print_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  if (argc >= 2 && string(argv[1]) == "--calibrate") {
+    try {
+      return run_calibration(argc >= 3 ? argv[2] : minfi::default_tuning_path());
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+      return EXIT_FAILURE;
+    }
+  }
   if (argc != 2) {
     print_usage(argv[0]);
     return argc == 1 ? EXIT_SUCCESS : EXIT_FAILURE;
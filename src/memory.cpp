@@ -0,0 +1,118 @@
+#include "minfi/memory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace minfi {
+
+namespace {
+
+// Each block is prefixed with the upstream resource it came from, so deallocation returns it
+// there even if set_memory_resource() switched upstreams in between.
+constexpr std::size_t kPrefix = alignof(std::max_align_t);
+
+struct Counters {
+  std::atomic<std::uint64_t> current{0};
+  std::atomic<std::uint64_t> peak{0};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> deallocations{0};
+  std::atomic<std::pmr::memory_resource*> upstream{nullptr};
+};
+
+class TrackingResource final : public std::pmr::memory_resource {
+ public:
+  Counters counters;
+
+ private:
+  static std::size_t prefix_for(std::size_t alignment) { return std::max(kPrefix, alignment); }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    std::pmr::memory_resource* up = counters.upstream.load(std::memory_order_acquire);
+    if (!up) up = std::pmr::new_delete_resource();
+    const std::size_t prefix = prefix_for(alignment);
+    auto* base = static_cast<std::byte*>(up->allocate(bytes + prefix, prefix));
+    std::memcpy(base + prefix - sizeof(up), &up, sizeof(up));
+
+    const std::uint64_t now =
+        counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::uint64_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (now > peak &&
+           !counters.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    return base + prefix;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    const std::size_t prefix = prefix_for(alignment);
+    auto* base = static_cast<std::byte*>(p) - prefix;
+    std::pmr::memory_resource* up = nullptr;
+    std::memcpy(&up, base + prefix - sizeof(up), sizeof(up));
+    up->deallocate(base, bytes + prefix, prefix);
+    counters.current.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TrackingResource& resource_for(Subsystem s) {
+  // Never destroyed: blocks held by static objects may be freed during exit.
+  static auto* resources = new std::array<TrackingResource, kSubsystems>();
+  return (*resources)[static_cast<std::size_t>(s)];
+}
+
+}  // namespace
+
+const char* to_string(Subsystem subsystem) {
+  switch (subsystem) {
+    case Subsystem::Frames:
+      return "frames";
+    case Subsystem::Motion:
+      return "motion";
+    case Subsystem::Scratch:
+      return "scratch";
+    case Subsystem::Upload:
+      return "upload";
+  }
+  return "unknown";
+}
+
+std::pmr::memory_resource* tracked_resource(Subsystem subsystem) {
+  return &resource_for(subsystem);
+}
+
+MemoryStats memory_stats(Subsystem subsystem) {
+  const Counters& c = resource_for(subsystem).counters;
+  MemoryStats s;
+  s.current_bytes = c.current.load(std::memory_order_relaxed);
+  s.peak_bytes = c.peak.load(std::memory_order_relaxed);
+  s.allocations = c.allocations.load(std::memory_order_relaxed);
+  s.deallocations = c.deallocations.load(std::memory_order_relaxed);
+  return s;
+}
+
+std::array<MemoryStats, kSubsystems> memory_stats() {
+  std::array<MemoryStats, kSubsystems> all;
+  for (std::size_t i = 0; i < kSubsystems; ++i) all[i] = memory_stats(static_cast<Subsystem>(i));
+  return all;
+}
+
+void reset_memory_peaks() {
+  for (std::size_t i = 0; i < kSubsystems; ++i) {
+    Counters& c = resource_for(static_cast<Subsystem>(i)).counters;
+    c.peak.store(c.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+std::pmr::memory_resource* set_memory_resource(Subsystem subsystem,
+                                               std::pmr::memory_resource* resource) {
+  std::pmr::memory_resource* prev =
+      resource_for(subsystem).counters.upstream.exchange(resource, std::memory_order_acq_rel);
+  return prev ? prev : std::pmr::new_delete_resource();
+}
+
+}  // namespace minfi
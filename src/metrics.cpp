@@ -0,0 +1,342 @@
+#include "minfi/metrics.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "minfi/executor.hpp"
+#include "minfi/frame_cache.hpp"
+#include "minfi/memory.hpp"
+
+namespace minfi {
+
+namespace {
+
+std::int64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool valid_name(const std::string& name, bool allow_colon) {
+  if (name.empty()) return false;
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+                       (allow_colon && c == ':');
+    if (!alpha && !(i > 0 && c >= '0' && c <= '9')) return false;
+  }
+  return true;
+}
+
+void append_double(std::string& out, double v) {
+  if (std::isnan(v)) {
+    out += "NaN";
+  } else if (std::isinf(v)) {
+    out += v > 0 ? "+Inf" : "-Inf";
+  } else {
+    char buf[32];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, r.ptr);
+  }
+}
+
+void append_escaped(std::string& out, const std::string& s, bool quote) {
+  for (const char c : s) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (quote && c == '"') {
+      out += "\\\"";
+    } else {
+      out += c;
+    }
+  }
+}
+
+// Divides by the exact inverse when `scale` is a unit fraction (1e-9, 1e-3), so 4000 ns renders
+// as 4e-06 rather than 4.000000000000001e-06.
+double apply_scale(double v, double scale) {
+  const double inverse = std::round(1.0 / scale);
+  return (scale < 1.0 && inverse * scale == 1.0) ? v / inverse : v * scale;
+}
+
+// {a="x",b="y"} with an optional extra label (le for histogram buckets); nothing if empty.
+void append_labels(std::string& out, const MetricLabels& labels, const char* extra_name = nullptr,
+                   const std::string& extra_value = {}) {
+  if (labels.empty() && !extra_name) return;
+  out += '{';
+  bool first = true;
+  const auto add = [&](const std::string& k, const std::string& v) {
+    if (!first) out += ',';
+    first = false;
+    out += k;
+    out += "=\"";
+    append_escaped(out, v, true);
+    out += '"';
+  };
+  for (const auto& [k, v] : labels) add(k, v);
+  if (extra_name) add(extra_name, extra_value);
+  out += '}';
+}
+
+}  // namespace
+
+Histogram::Histogram(std::vector<std::uint64_t> bounds) : bounds_(std::move(bounds)) {
+  if (bounds_.empty()) throw std::invalid_argument("Histogram: no bucket bounds");
+  for (std::size_t i = 1; i < bounds_.size(); ++i) {
+    if (bounds_[i] <= bounds_[i - 1]) {
+      throw std::invalid_argument("Histogram: bucket bounds must be strictly ascending");
+    }
+  }
+  counts_ = std::make_unique<std::atomic<std::uint64_t>[]>(bounds_.size() + 1);
+}
+
+std::vector<std::uint64_t> Histogram::exponential_bounds(std::uint64_t start, double factor,
+                                                         std::size_t count) {
+  if (start == 0 || !(factor > 1.0) || count == 0) {
+    throw std::invalid_argument("Histogram: exponential bounds need start > 0, factor > 1");
+  }
+  std::vector<std::uint64_t> bounds;
+  double v = static_cast<double>(start);
+  for (std::size_t i = 0; i < count; ++i, v *= factor) {
+    const auto b = static_cast<std::uint64_t>(std::llround(v));
+    bounds.push_back(bounds.empty() ? b : std::max(b, bounds.back() + 1));
+  }
+  return bounds;
+}
+
+std::vector<std::uint64_t> Histogram::latency_bounds_ns() {
+  return exponential_bounds(1000, 2.0, 24);
+}
+
+void Histogram::record(std::uint64_t value) {
+  const auto it = std::lower_bound(bounds_.begin(), bounds_.end(), value);
+  counts_[static_cast<std::size_t>(it - bounds_.begin())].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<std::uint64_t> Histogram::counts() const {
+  std::vector<std::uint64_t> out(bounds_.size() + 1);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = counts_[i].load(std::memory_order_relaxed);
+  }
+  return out;
+}
+
+ScopedTimer::ScopedTimer(Histogram& histogram) : histogram_(histogram), start_ns_(steady_ns()) {}
+
+ScopedTimer::~ScopedTimer() {
+  const std::int64_t elapsed = steady_ns() - start_ns_;
+  histogram_.record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed)));
+}
+
+const char* MetricsRegistry::type_name_(Type type) {
+  switch (type) {
+    case Type::Counter:
+      return "counter";
+    case Type::Gauge:
+      return "gauge";
+    case Type::Histogram:
+      return "histogram";
+  }
+  return "untyped";
+}
+
+MetricsRegistry::Series& MetricsRegistry::series_(const std::string& name, const std::string& help,
+                                                  Type type, const MetricLabels& labels,
+                                                  bool& created) {
+  if (!valid_name(name, true)) {
+    throw std::invalid_argument("MetricsRegistry: invalid metric name '" + name + "'");
+  }
+  for (const auto& [k, v] : labels) {
+    if (!valid_name(k, false) || k.starts_with("__") || k == "le") {
+      throw std::invalid_argument("MetricsRegistry: invalid label name '" + k + "'");
+    }
+  }
+  auto family = std::find_if(families_.begin(), families_.end(),
+                             [&](const Family& f) { return f.name == name; });
+  if (family == families_.end()) {
+    families_.push_back({name, help, type, {}});
+    family = std::prev(families_.end());
+  } else if (family->type != type) {
+    throw std::invalid_argument("MetricsRegistry: '" + name +
+                                "' is already registered as a " +
+                                type_name_(family->type));
+  }
+  for (Series& s : family->series) {
+    if (s.labels == labels) {
+      created = false;
+      return s;
+    }
+  }
+  created = true;
+  family->series.push_back({});
+  family->series.back().labels = labels;
+  return family->series.back();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool created = false;
+  Series& s = series_(name, help, Type::Counter, labels, created);
+  if (!s.counter) {
+    if (!created) throw std::invalid_argument("MetricsRegistry: '" + name + "' is computed");
+    s.counter = std::make_unique<Counter>();
+  }
+  return *s.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool created = false;
+  Series& s = series_(name, help, Type::Gauge, labels, created);
+  if (!s.gauge) {
+    if (!created) throw std::invalid_argument("MetricsRegistry: '" + name + "' is computed");
+    s.gauge = std::make_unique<Gauge>();
+  }
+  return *s.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const MetricLabels& labels,
+                                      std::vector<std::uint64_t> bounds, double scale) {
+  // Built first so invalid bounds throw before anything is registered.
+  auto fresh = std::make_unique<Histogram>(std::move(bounds));
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool created = false;
+  Series& s = series_(name, help, Type::Histogram, labels, created);
+  if (created) {
+    s.histogram = std::move(fresh);
+    s.scale = scale;
+  }
+  return *s.histogram;
+}
+
+void MetricsRegistry::gauge_fn(const std::string& name, const std::string& help,
+                               const MetricLabels& labels, std::function<double()> read) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool created = false;
+  Series& s = series_(name, help, Type::Gauge, labels, created);
+  if (s.gauge) throw std::invalid_argument("MetricsRegistry: '" + name + "' is not computed");
+  s.read = std::move(read);
+}
+
+void MetricsRegistry::counter_fn(const std::string& name, const std::string& help,
+                                 const MetricLabels& labels, std::function<double()> read) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool created = false;
+  Series& s = series_(name, help, Type::Counter, labels, created);
+  if (s.counter) throw std::invalid_argument("MetricsRegistry: '" + name + "' is not computed");
+  s.read = std::move(read);
+}
+
+std::string MetricsRegistry::render() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string out;
+  for (const Family& f : families_) {
+    out += "# HELP ";
+    out += f.name;
+    out += ' ';
+    append_escaped(out, f.help, false);
+    out += "\n# TYPE ";
+    out += f.name;
+    out += ' ';
+    out += type_name_(f.type);
+    out += '\n';
+    for (const Series& s : f.series) {
+      if (s.histogram) {
+        // Cumulative buckets from one read of the counts, so _count always matches +Inf.
+        const auto counts = s.histogram->counts();
+        const auto& bounds = s.histogram->bounds();
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+          cumulative += counts[i];
+          std::string le;
+          append_double(le, i < bounds.size() ? apply_scale(static_cast<double>(bounds[i]), s.scale)
+                                              : std::numeric_limits<double>::infinity());
+          out += f.name;
+          out += "_bucket";
+          append_labels(out, s.labels, "le", le);
+          out += ' ';
+          out += std::to_string(cumulative);
+          out += '\n';
+        }
+        out += f.name;
+        out += "_sum";
+        append_labels(out, s.labels);
+        out += ' ';
+        append_double(out, apply_scale(static_cast<double>(s.histogram->sum()), s.scale));
+        out += '\n';
+        out += f.name;
+        out += "_count";
+        append_labels(out, s.labels);
+        out += ' ';
+        out += std::to_string(cumulative);
+        out += '\n';
+        continue;
+      }
+      out += f.name;
+      append_labels(out, s.labels);
+      out += ' ';
+      if (s.counter) {
+        out += std::to_string(s.counter->value());
+      } else if (s.gauge) {
+        out += std::to_string(s.gauge->value());
+      } else {
+        append_double(out, s.read ? s.read() : 0.0);
+      }
+      out += '\n';
+    }
+  }
+  return out;
+}
+
+void register_memory_metrics(MetricsRegistry& registry) {
+  for (std::size_t i = 0; i < kSubsystems; ++i) {
+    const auto subsystem = static_cast<Subsystem>(i);
+    const MetricLabels labels{{"subsystem", to_string(subsystem)}};
+    registry.gauge_fn("minfi_memory_bytes", "Bytes currently allocated by minfi.", labels,
+                      [subsystem] {
+                        return static_cast<double>(memory_stats(subsystem).current_bytes);
+                      });
+    registry.gauge_fn("minfi_memory_peak_bytes", "Peak bytes allocated by minfi.", labels,
+                      [subsystem] {
+                        return static_cast<double>(memory_stats(subsystem).peak_bytes);
+                      });
+  }
+}
+
+void register_executor_metrics(MetricsRegistry& registry, const Executor& executor,
+                               const std::string& name) {
+  const MetricLabels labels{{"executor", name}};
+  const Executor* e = &executor;
+  registry.gauge_fn("minfi_executor_threads", "Worker threads of the executor.", labels,
+                    [e] { return static_cast<double>(e->thread_count()); });
+  registry.gauge_fn("minfi_executor_queue_depth", "Tasks submitted but not yet started.", labels,
+                    [e] { return static_cast<double>(e->pending()); });
+}
+
+void register_frame_cache_metrics(MetricsRegistry& registry, const FrameCache& cache,
+                                  const std::string& name) {
+  const MetricLabels labels{{"cache", name}};
+  const FrameCache* c = &cache;
+  registry.gauge_fn("minfi_frame_cache_bytes", "Bytes stored in the output frame cache.", labels,
+                    [c] { return static_cast<double>(c->stats().bytes); });
+  registry.gauge_fn("minfi_frame_cache_entries", "Frames stored in the output frame cache.",
+                    labels, [c] { return static_cast<double>(c->stats().entries); });
+  registry.counter_fn("minfi_frame_cache_hits_total", "Output frame cache hits.", labels,
+                      [c] { return static_cast<double>(c->stats().hits); });
+  registry.counter_fn("minfi_frame_cache_misses_total", "Output frame cache misses.", labels,
+                      [c] { return static_cast<double>(c->stats().misses); });
+  registry.counter_fn("minfi_frame_cache_evictions_total", "Output frame cache evictions.",
+                      labels, [c] { return static_cast<double>(c->stats().evictions); });
+}
+
+}  // namespace minfi
@@ -0,0 +1,190 @@
+#include "minfi/metrics_server.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace minfi {
+
+namespace {
+
+constexpr std::size_t kMaxRequest = 8192;
+constexpr int kClientTimeoutMs = 2000;
+
+[[noreturn]] void socket_error(const std::string& what) {
+  throw std::runtime_error("MetricsServer: " + what + ": " + std::strerror(errno));
+}
+
+void set_cloexec(int fd) { ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC); }
+
+// Never raises SIGPIPE: MSG_NOSIGNAL on Linux, SO_NOSIGPIPE on the socket elsewhere.
+void write_all(int fd, const std::string& data) {
+  std::size_t off = 0;
+  while (off < data.size()) {
+#if defined(MSG_NOSIGNAL)
+    const ssize_t n = ::send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+#else
+    const ssize_t n = ::send(fd, data.data() + off, data.size() - off, 0);
+#endif
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return;  // client went away or stopped reading (SO_SNDTIMEO)
+    off += static_cast<std::size_t>(n);
+  }
+}
+
+// Removes a stale socket at `path`; anything else there is left for bind() to report.
+void unlink_socket(const std::string& path) {
+  struct stat st {};
+  if (::lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) ::unlink(path.c_str());
+}
+
+std::string response(const char* status, const char* type, const std::string& body) {
+  return std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + type +
+         "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" +
+         body;
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry, Options options)
+    : registry_(registry), options_(std::move(options)) {
+  if (options_.unix_path.empty()) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options_.port);
+    if (::inet_pton(AF_INET, options_.address.c_str(), &addr.sin_addr) != 1) {
+      throw std::invalid_argument("MetricsServer: invalid IPv4 address '" + options_.address +
+                                  "'");
+    }
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) socket_error("socket");
+    set_cloexec(listen_fd_);
+    const int one = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      const int err = errno;
+      ::close(listen_fd_);
+      errno = err;
+      socket_error("cannot bind " + options_.address + ":" + std::to_string(options_.port));
+    }
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+  } else {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (options_.unix_path.size() >= sizeof(addr.sun_path)) {
+      throw std::invalid_argument("MetricsServer: Unix socket path too long");
+    }
+    std::memcpy(addr.sun_path, options_.unix_path.c_str(), options_.unix_path.size() + 1);
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) socket_error("socket");
+    set_cloexec(listen_fd_);
+    unlink_socket(options_.unix_path);
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      const int err = errno;
+      ::close(listen_fd_);
+      errno = err;
+      socket_error("cannot bind " + options_.unix_path);
+    }
+  }
+  if (::listen(listen_fd_, 16) != 0 || ::pipe(wake_pipe_) != 0) {
+    const int err = errno;
+    ::close(listen_fd_);
+    errno = err;
+    socket_error("listen");
+  }
+  set_cloexec(wake_pipe_[0]);
+  set_cloexec(wake_pipe_[1]);
+  thread_ = std::thread([this] { run_(); });
+}
+
+MetricsServer::~MetricsServer() {
+  const char byte = 1;
+  [[maybe_unused]] const ssize_t n = ::write(wake_pipe_[1], &byte, 1);
+  if (thread_.joinable()) thread_.join();
+  ::close(listen_fd_);
+  ::close(wake_pipe_[0]);
+  ::close(wake_pipe_[1]);
+  if (!options_.unix_path.empty()) unlink_socket(options_.unix_path);
+}
+
+void MetricsServer::run_() {
+  for (;;) {
+    pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+    if (::poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    if (fds[1].revents) return;
+    if (!(fds[0].revents & POLLIN)) continue;
+    const int client = ::accept(listen_fd_, nullptr, nullptr);
+    if (client < 0) continue;
+    set_cloexec(client);
+    // A client that stops reading must not stall the server thread in send().
+    const timeval timeout{kClientTimeoutMs / 1000, (kClientTimeoutMs % 1000) * 1000};
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#if defined(SO_NOSIGPIPE)
+    const int one = 1;
+    ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    try {
+      serve_(client);
+    } catch (...) {
+      // Out of memory outside render(): drop this connection and keep serving.
+    }
+    ::close(client);
+  }
+}
+
+void MetricsServer::serve_(int client) {
+  // Read until the end of the request headers. One deadline covers the whole request, so a
+  // client trickling bytes cannot hold the single server thread.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(kClientTimeoutMs);
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequest) {
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    pollfd pfd{client, POLLIN, 0};
+    if (left.count() <= 0 || ::poll(&pfd, 1, static_cast<int>(left.count())) <= 0) return;
+    const ssize_t n = ::recv(client, buf, sizeof(buf), 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) break;
+    request.append(buf, static_cast<std::size_t>(n));
+  }
+  const std::string line = request.substr(0, request.find("\r\n"));
+  const bool get = line.starts_with("GET ");
+  const std::string path = get ? line.substr(4, line.find(' ', 4) - 4) : std::string();
+  if (!get) {
+    write_all(client, response("405 Method Not Allowed", "text/plain", "GET only\n"));
+  } else if (path == "/metrics" || path == "/") {
+    // render() runs caller callbacks; their failures must not take down the server thread.
+    std::string body;
+    try {
+      body = registry_.render();
+    } catch (...) {
+      write_all(client, response("500 Internal Server Error", "text/plain", "render failed\n"));
+      return;
+    }
+    write_all(client, response("200 OK", "text/plain; version=0.0.4; charset=utf-8", body));
+  } else {
+    write_all(client, response("404 Not Found", "text/plain", "try /metrics\n"));
+  }
+}
+
+}  // namespace minfi
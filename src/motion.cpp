@@ -0,0 +1,208 @@
+#include "minfi/motion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+namespace {
+
+void check_frames(std::size_t a, std::size_t b, const FrameShape& shape) {
+  if (a != b) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if (a != shape.elems() || shape.channels == 0) {
+    throw std::invalid_argument("motion: frame size does not match shape");
+  }
+}
+
+// Channel mean, the plane that block matching runs on.
+Vector<float, Subsystem::Scratch> luma_plane(std::span<const float> f, const FrameShape& shape) {
+  const std::size_t pixels = shape.width * shape.height;
+  if (shape.channels == 1) return {f.begin(), f.end()};
+  Vector<float, Subsystem::Scratch> out(pixels);
+  const float inv = 1.0f / static_cast<float>(shape.channels);
+  for (std::size_t p = 0; p < pixels; ++p) {
+    float sum = 0.f;
+    for (std::size_t c = 0; c < shape.channels; ++c) sum += f[p * shape.channels + c];
+    out[p] = sum * inv;
+  }
+  return out;
+}
+
+// SAD of the w x h block at (x0, y0) in `a` against (x0 + dx, y0 + dy) in `b`; stops early
+// once the partial sum exceeds `limit`.
+float block_sad(const float* a, const float* b, std::size_t stride, std::size_t x0,
+                std::size_t y0, std::size_t w, std::size_t h, int dx, int dy, float limit) {
+  float sad = 0.f;
+  for (std::size_t y = 0; y < h; ++y) {
+    const float* ra = a + (y0 + y) * stride + x0;
+    const float* rb = b + static_cast<std::size_t>(static_cast<std::ptrdiff_t>(y0 + y) + dy) *
+                              stride +
+                      static_cast<std::size_t>(static_cast<std::ptrdiff_t>(x0) + dx);
+    for (std::size_t x = 0; x < w; ++x) sad += std::fabs(ra[x] - rb[x]);
+    if (sad > limit) return sad;
+  }
+  return sad;
+}
+
+struct Sample {
+  std::size_t i00, i01, i10, i11;  // element offsets of the four neighbours
+  float w00, w01, w10, w11;
+};
+
+Sample bilinear(float x, float y, const FrameShape& s) {
+  const float maxx = static_cast<float>(s.width - 1);
+  const float maxy = static_cast<float>(s.height - 1);
+  x = std::clamp(x, 0.f, maxx);
+  y = std::clamp(y, 0.f, maxy);
+  const auto x0 = static_cast<std::size_t>(x);
+  const auto y0 = static_cast<std::size_t>(y);
+  const std::size_t x1 = std::min(x0 + 1, s.width - 1);
+  const std::size_t y1 = std::min(y0 + 1, s.height - 1);
+  const float fx = x - static_cast<float>(x0);
+  const float fy = y - static_cast<float>(y0);
+  const std::size_t row = s.row_elems();
+  return {y0 * row + x0 * s.channels,
+          y0 * row + x1 * s.channels,
+          y1 * row + x0 * s.channels,
+          y1 * row + x1 * s.channels,
+          (1.f - fx) * (1.f - fy),
+          fx * (1.f - fy),
+          (1.f - fx) * fy,
+          fx * fy};
+}
+
+}  // namespace
+
+void sample_motion(const MotionFieldView& f, std::size_t x, std::size_t y, MotionSampling sampling,
+                   float& vx, float& vy) {
+  constexpr float inv = 1.0f / kMotionScale;
+  if (sampling == MotionSampling::Block) {
+    const MotionVector& v =
+        f.at(std::min(x / f.block, f.cols - 1), std::min(y / f.block, f.rows - 1));
+    vx = v.dx * inv;
+    vy = v.dy * inv;
+    return;
+  }
+  const float b = static_cast<float>(f.block);
+  const float gx = std::clamp((static_cast<float>(x) + 0.5f) / b - 0.5f, 0.f,
+                              static_cast<float>(f.cols - 1));
+  const float gy = std::clamp((static_cast<float>(y) + 0.5f) / b - 0.5f, 0.f,
+                              static_cast<float>(f.rows - 1));
+  const auto bx0 = static_cast<std::size_t>(gx);
+  const auto by0 = static_cast<std::size_t>(gy);
+  const std::size_t bx1 = std::min(bx0 + 1, f.cols - 1);
+  const std::size_t by1 = std::min(by0 + 1, f.rows - 1);
+  const float wx = gx - static_cast<float>(bx0);
+  const float wy = gy - static_cast<float>(by0);
+  const auto mix = [&](auto get) {
+    return ((1.f - wx) * get(f.at(bx0, by0)) + wx * get(f.at(bx1, by0))) * (1.f - wy) +
+           ((1.f - wx) * get(f.at(bx0, by1)) + wx * get(f.at(bx1, by1))) * wy;
+  };
+  vx = mix([](const MotionVector& v) { return static_cast<float>(v.dx); }) * inv;
+  vy = mix([](const MotionVector& v) { return static_cast<float>(v.dy); }) * inv;
+}
+
+MotionField estimate_motion(std::span<const float> a, std::span<const float> b,
+                            const FrameShape& shape, const MotionOptions& options) {
+  check_frames(a.size(), b.size(), shape);
+  if (options.block == 0 || options.search < 0 || options.search * kMotionScale > 32767) {
+    throw std::invalid_argument("estimate_motion: invalid block size or search radius");
+  }
+  const auto la = luma_plane(a, shape);
+  const auto lb = luma_plane(b, shape);
+  const std::size_t W = shape.width;
+  const std::size_t H = shape.height;
+  const std::size_t B = options.block;
+  const int S = options.search;
+
+  MotionField field;
+  field.block = B;
+  field.cols = (W + B - 1) / B;
+  field.rows = (H + B - 1) / B;
+  field.vectors.resize(field.cols * field.rows);
+
+  for (std::size_t by = 0; by < field.rows; ++by) {
+    for (std::size_t bx = 0; bx < field.cols; ++bx) {
+      const std::size_t x0 = bx * B;
+      const std::size_t y0 = by * B;
+      const std::size_t w = std::min(B, W - x0);
+      const std::size_t h = std::min(B, H - y0);
+      float best = block_sad(la.data(), lb.data(), W, x0, y0, w, h, 0, 0,
+                             std::numeric_limits<float>::infinity());
+      int best_dx = 0;
+      int best_dy = 0;
+      for (int dy = -S; dy <= S && best > 0.f; ++dy) {
+        const auto ty = static_cast<std::ptrdiff_t>(y0) + dy;
+        if (ty < 0 || ty + static_cast<std::ptrdiff_t>(h) > static_cast<std::ptrdiff_t>(H)) {
+          continue;
+        }
+        for (int dx = -S; dx <= S; ++dx) {
+          const auto tx = static_cast<std::ptrdiff_t>(x0) + dx;
+          if (tx < 0 || tx + static_cast<std::ptrdiff_t>(w) > static_cast<std::ptrdiff_t>(W)) {
+            continue;
+          }
+          const float sad = block_sad(la.data(), lb.data(), W, x0, y0, w, h, dx, dy, best);
+          // Strictly better, or equally good and shorter: keeps flat regions at zero motion.
+          const bool shorter = dx * dx + dy * dy < best_dx * best_dx + best_dy * best_dy;
+          if (sad < best || (sad == best && shorter)) {
+            best = sad;
+            best_dx = dx;
+            best_dy = dy;
+          }
+        }
+      }
+      field.vectors[by * field.cols + bx] = {static_cast<std::int16_t>(best_dx * kMotionScale),
+                                             static_cast<std::int16_t>(best_dy * kMotionScale)};
+    }
+  }
+  return field;
+}
+
+void interpolate_motion_into(std::span<const float> a, std::span<const float> b,
+                             const FrameShape& shape, const MotionFieldView& field, float t,
+                             std::span<float> out, MotionSampling sampling) {
+  check_frames(a.size(), b.size(), shape);
+  if (out.size() != a.size()) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if (field.block == 0 || field.cols * field.block < shape.width ||
+      field.rows * field.block < shape.height || !field.vectors) {
+    throw std::invalid_argument("interpolate_motion: motion field does not cover the frame");
+  }
+  const float u = detail::clamp01(t);
+  const std::size_t C = shape.channels;
+  for (std::size_t y = 0; y < shape.height; ++y) {
+    for (std::size_t x = 0; x < shape.width; ++x) {
+      float vx = 0.f;
+      float vy = 0.f;
+      sample_motion(field, x, y, sampling, vx, vy);
+      const float fx = static_cast<float>(x);
+      const float fy = static_cast<float>(y);
+      const Sample sa = bilinear(fx - u * vx, fy - u * vy, shape);
+      const Sample sb = bilinear(fx + (1.f - u) * vx, fy + (1.f - u) * vy, shape);
+      float* dst = out.data() + y * shape.row_elems() + x * C;
+      for (std::size_t c = 0; c < C; ++c) {
+        const float va = sa.w00 * a[sa.i00 + c] + sa.w01 * a[sa.i01 + c] +
+                         sa.w10 * a[sa.i10 + c] + sa.w11 * a[sa.i11 + c];
+        const float vb = sb.w00 * b[sb.i00 + c] + sb.w01 * b[sb.i01 + c] +
+                         sb.w10 * b[sb.i10 + c] + sb.w11 * b[sb.i11 + c];
+        dst[c] = va * (1.f - u) + vb * u;
+      }
+    }
+  }
+}
+
+Frame interpolate_motion(const Frame& a, const Frame& b, const FrameShape& shape,
+                         const MotionFieldView& field, float t, MotionSampling sampling) {
+  Frame out(a.size());
+  interpolate_motion_into(a, b, shape, field, t, out, sampling);
+  return out;
+}
+
+}  // namespace minfi
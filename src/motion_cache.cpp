@@ -0,0 +1,101 @@
+#include "minfi/motion_cache.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace minfi {
+
+std::uint64_t frame_id(std::span<const float> frame) {
+  std::uint64_t h = 0xcbf29ce484222325ull;
+  const auto* p = reinterpret_cast<const unsigned char*>(frame.data());
+  for (std::size_t i = 0; i < frame.size_bytes(); ++i) {
+    h ^= p[i];
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+MotionCache::MotionCache(std::size_t byte_budget) : budget_(byte_budget) {}
+
+std::shared_ptr<const MotionField> MotionCache::find(const FramePairKey& key,
+                                                     const MotionOptions& options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end() || !(it->second->options == options)) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  ++stats_.hits;
+  return it->second->field;
+}
+
+bool MotionCache::contains(const FramePairKey& key, const MotionOptions& options) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  return it != index_.end() && it->second->options == options;
+}
+
+std::shared_ptr<const MotionField> MotionCache::insert(const FramePairKey& key, MotionField field,
+                                                       const MotionOptions& options) {
+  auto shared = std::make_shared<const MotionField>(std::move(field));
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    stats_.bytes -= it->second->field->bytes();
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+  if (shared->bytes() > budget_) return shared;
+  lru_.push_front({key, options, shared});
+  index_[key] = lru_.begin();
+  stats_.bytes += shared->bytes();
+  evict_to_budget_();
+  return shared;
+}
+
+std::shared_ptr<const MotionField> MotionCache::get_or_estimate(const FramePairKey& key,
+                                                                std::span<const float> a,
+                                                                std::span<const float> b,
+                                                                const FrameShape& shape,
+                                                                const MotionOptions& options) {
+  if (auto hit = find(key, options)) return hit;
+  // Estimate without holding the lock so other pairs stay servable meanwhile.
+  return insert(key, estimate_motion(a, b, shape, options), options);
+}
+
+void MotionCache::set_budget(std::size_t byte_budget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = byte_budget;
+  evict_to_budget_();
+}
+
+std::size_t MotionCache::budget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+void MotionCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  stats_.bytes = 0;
+}
+
+MotionCache::Stats MotionCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats s = stats_;
+  s.entries = lru_.size();
+  return s;
+}
+
+void MotionCache::evict_to_budget_() {
+  while (stats_.bytes > budget_ && !lru_.empty()) {
+    const Entry& victim = lru_.back();
+    stats_.bytes -= victim.field->bytes();
+    index_.erase(victim.key);
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace minfi
@@ -0,0 +1,338 @@
+#include "minfi/motion_sidecar.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MINFI_SIDECAR_MMAP 1
+#endif
+#if defined(MINFI_WITH_LZ4)
+#include <lz4.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace minfi {
+
+namespace {
+
+constexpr std::uint64_t kSidecarMagic = 0x4353564d4946494dull;  // "MIFIMVSC"
+constexpr std::uint32_t kSidecarVersion = 1;
+constexpr std::size_t kAlign = 64;
+constexpr std::uint64_t kMaxSide = 1u << 16;  // pixels a stored field may cover per side
+constexpr std::uint64_t kLz4MaxRatio = 255;    // LZ4 expands a block by at most this much
+
+struct FileHeader {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t header_bytes;
+  std::uint64_t count;
+  std::uint64_t index_offset;
+  std::uint64_t reserved[4];
+};
+static_assert(sizeof(FileHeader) == kAlign);
+
+void require_little_endian(const char* who) {
+  if constexpr (std::endian::native != std::endian::little) {
+    throw std::runtime_error(std::string(who) + ": sidecar files are little-endian only");
+  }
+}
+
+}  // namespace
+
+struct detail::SidecarIndexEntry {
+  std::uint64_t a;
+  std::uint64_t b;
+  std::uint32_t block;
+  std::int32_t search;
+  std::uint32_t cols;
+  std::uint32_t rows;
+  std::uint64_t offset;
+  std::uint64_t stored_bytes;
+  std::uint32_t codec;
+  std::uint32_t reserved0;
+  std::uint64_t reserved1;
+};
+static_assert(sizeof(detail::SidecarIndexEntry) == kAlign);
+
+namespace {
+
+using IndexEntry = detail::SidecarIndexEntry;
+
+auto order_key(const IndexEntry& e) { return std::tie(e.a, e.b, e.block, e.search); }
+
+}  // namespace
+
+// ---- writer ----
+
+MotionSidecarWriter::MotionSidecarWriter(const std::string& path, SidecarCodec codec)
+    : path_(path), codec_(codec) {
+  require_little_endian("MotionSidecarWriter");
+  if (!supports(codec)) {
+    throw std::invalid_argument("MotionSidecarWriter: codec not available in this build");
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) throw std::runtime_error("MotionSidecarWriter: cannot create '" + path + "'");
+  const FileHeader placeholder{};
+  out_.write(reinterpret_cast<const char*>(&placeholder), sizeof placeholder);
+  offset_ = sizeof placeholder;
+}
+
+MotionSidecarWriter::~MotionSidecarWriter() {
+  if (finished_) return;
+  try {
+    finish();
+  } catch (...) {
+  }
+}
+
+bool MotionSidecarWriter::supports(SidecarCodec codec) {
+  switch (codec) {
+    case SidecarCodec::None:
+      return true;
+    case SidecarCodec::Lz4:
+#if defined(MINFI_WITH_LZ4)
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+void MotionSidecarWriter::add(const FramePairKey& key, const MotionFieldView& field,
+                              const MotionOptions& options) {
+  if (finished_) throw std::logic_error("MotionSidecarWriter: add after finish");
+  if (field.cols > UINT32_MAX || field.rows > UINT32_MAX || options.block > UINT32_MAX ||
+      (field.cols * field.rows != 0 && !field.vectors)) {
+    throw std::invalid_argument("MotionSidecarWriter: unrepresentable motion field");
+  }
+  const char* payload = reinterpret_cast<const char*>(field.vectors);
+  std::size_t stored = field.cols * field.rows * sizeof(MotionVector);
+  SidecarCodec codec = SidecarCodec::None;
+#if defined(MINFI_WITH_LZ4)
+  std::vector<char> packed;
+  if (codec_ == SidecarCodec::Lz4 && stored > 0 &&
+      stored <= static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+    packed.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(stored))));
+    const int n = LZ4_compress_default(payload, packed.data(), static_cast<int>(stored),
+                                       static_cast<int>(packed.size()));
+    if (n > 0 && static_cast<std::size_t>(n) < stored) {
+      payload = packed.data();
+      stored = static_cast<std::size_t>(n);
+      codec = SidecarCodec::Lz4;
+    }
+  }
+#endif
+
+  const std::uint64_t pad = (kAlign - offset_ % kAlign) % kAlign;
+  static const char zeros[kAlign] = {};
+  out_.write(zeros, static_cast<std::streamsize>(pad));
+  out_.write(payload, static_cast<std::streamsize>(stored));
+  if (!out_) throw std::runtime_error("MotionSidecarWriter: write failed");
+  index_.push_back({key.a, key.b, static_cast<std::uint32_t>(options.block), options.search,
+                    static_cast<std::uint32_t>(field.cols), static_cast<std::uint32_t>(field.rows),
+                    offset_ + pad, stored, static_cast<std::uint32_t>(codec), 0, 0});
+  offset_ += pad + stored;
+}
+
+void MotionSidecarWriter::finish() {
+  if (finished_) return;
+  finished_ = true;
+  std::sort(index_.begin(), index_.end(),
+            [](const IndexEntry& l, const IndexEntry& r) { return order_key(l) < order_key(r); });
+  const auto dup = std::adjacent_find(
+      index_.begin(), index_.end(),
+      [](const IndexEntry& l, const IndexEntry& r) { return order_key(l) == order_key(r); });
+  if (dup != index_.end()) {
+    out_.close();
+    throw std::invalid_argument("MotionSidecarWriter: duplicate entry for frame pair");
+  }
+
+  const std::uint64_t pad = (kAlign - offset_ % kAlign) % kAlign;
+  static const char zeros[kAlign] = {};
+  out_.write(zeros, static_cast<std::streamsize>(pad));
+  out_.write(reinterpret_cast<const char*>(index_.data()),
+             static_cast<std::streamsize>(index_.size() * sizeof(IndexEntry)));
+
+  FileHeader header{};
+  header.magic = kSidecarMagic;
+  header.version = kSidecarVersion;
+  header.header_bytes = sizeof(FileHeader);
+  header.count = index_.size();
+  header.index_offset = offset_ + pad;
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char*>(&header), sizeof header);
+  out_.close();
+  if (out_.fail()) {
+    throw std::runtime_error("MotionSidecarWriter: write failed for '" + path_ + "'");
+  }
+}
+
+// ---- reader ----
+
+MotionSidecar MotionSidecar::open(const std::string& path) {
+  require_little_endian("MotionSidecar");
+  const std::byte* base = nullptr;
+  std::size_t bytes = 0;
+  bool mapped = false;
+#if defined(MINFI_SIDECAR_MMAP)
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw std::runtime_error("MotionSidecar: cannot open '" + path + "'");
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("MotionSidecar: '" + path + "' is too small");
+  }
+  bytes = static_cast<std::size_t>(st.st_size);
+  void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) throw std::runtime_error("MotionSidecar: mmap failed");
+  base = static_cast<const std::byte*>(p);
+  mapped = true;
+#else
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) throw std::runtime_error("MotionSidecar: cannot open '" + path + "'");
+  bytes = static_cast<std::size_t>(in.tellg());
+  if (bytes < sizeof(FileHeader)) throw std::runtime_error("MotionSidecar: file too small");
+  auto* buf = new std::byte[bytes];
+  in.seekg(0);
+  if (!in.read(reinterpret_cast<char*>(buf), static_cast<std::streamsize>(bytes))) {
+    delete[] buf;
+    throw std::runtime_error("MotionSidecar: read failed");
+  }
+  base = buf;
+#endif
+  MotionSidecar sidecar(base, bytes, mapped);  // owns the buffer from here on
+  if (const char* why = sidecar.validate_()) {
+    throw std::runtime_error("MotionSidecar: '" + path + "': " + why);
+  }
+  return sidecar;
+}
+
+MotionSidecar::MotionSidecar(const std::byte* base, std::size_t bytes, bool mapped)
+    : base_(base), bytes_(bytes), mapped_(mapped) {}
+
+const char* MotionSidecar::validate_() {
+  const auto* h = reinterpret_cast<const FileHeader*>(base_);
+  if (h->magic != kSidecarMagic) return "not a motion sidecar";
+  if (h->version != kSidecarVersion) return "unsupported sidecar version";
+  if (h->index_offset % kAlign != 0 || h->index_offset > bytes_ ||
+      h->count > (bytes_ - h->index_offset) / sizeof(IndexEntry)) {
+    return "truncated index";
+  }
+  const auto* index = reinterpret_cast<const IndexEntry*>(base_ + h->index_offset);
+  const auto count = static_cast<std::size_t>(h->count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const IndexEntry& e = index[i];
+    // Fields cover at most kMaxSide pixels a side, and LZ4 cannot expand stored bytes by more
+    // than kLz4MaxRatio, so a decoded field never needs an unbounded allocation.
+    const std::uint64_t raw = std::uint64_t{e.cols} * e.rows * sizeof(MotionVector);
+    const bool codec_ok = e.codec == static_cast<std::uint32_t>(SidecarCodec::None)
+                              ? e.stored_bytes == raw
+                              : e.codec == static_cast<std::uint32_t>(SidecarCodec::Lz4) &&
+                                    raw <= e.stored_bytes * kLz4MaxRatio;
+    if (!codec_ok || e.offset % kAlign != 0 || e.offset > h->index_offset ||
+        e.stored_bytes > h->index_offset - e.offset || e.block == 0 || e.block > kMaxSide ||
+        std::uint64_t{e.cols} * e.block > kMaxSide || std::uint64_t{e.rows} * e.block > kMaxSide) {
+      return "corrupt index entry";
+    }
+    if (i > 0 && !(order_key(index[i - 1]) < order_key(e))) return "index is not sorted";
+  }
+  index_ = index;
+  count_ = count;
+  return nullptr;
+}
+
+MotionSidecar::MotionSidecar(MotionSidecar&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)),
+      mapped_(std::exchange(other.mapped_, false)),
+      index_(std::exchange(other.index_, nullptr)),
+      count_(std::exchange(other.count_, 0)) {}
+
+MotionSidecar& MotionSidecar::operator=(MotionSidecar&& other) noexcept {
+  MotionSidecar tmp(std::move(other));
+  std::swap(base_, tmp.base_);
+  std::swap(bytes_, tmp.bytes_);
+  std::swap(mapped_, tmp.mapped_);
+  std::swap(index_, tmp.index_);
+  std::swap(count_, tmp.count_);
+  return *this;
+}
+
+MotionSidecar::~MotionSidecar() {
+  if (!base_) return;
+#if defined(MINFI_SIDECAR_MMAP)
+  if (mapped_) {
+    ::munmap(const_cast<std::byte*>(base_), bytes_);
+    base_ = nullptr;
+    return;
+  }
+#endif
+  delete[] base_;
+  base_ = nullptr;
+}
+
+const MotionSidecar::IndexEntry* MotionSidecar::find_(const FramePairKey& key,
+                                                      const MotionOptions& options) const {
+  if (options.block > UINT32_MAX) return nullptr;
+  IndexEntry probe{};
+  probe.a = key.a;
+  probe.b = key.b;
+  probe.block = static_cast<std::uint32_t>(options.block);
+  probe.search = options.search;
+  const IndexEntry* end = index_ + count_;
+  const IndexEntry* it = std::lower_bound(index_, end, probe, [](const auto& l, const auto& r) {
+    return order_key(l) < order_key(r);
+  });
+  return it != end && order_key(*it) == order_key(probe) ? it : nullptr;
+}
+
+bool MotionSidecar::contains(const FramePairKey& key, const MotionOptions& options) const {
+  return find_(key, options) != nullptr;
+}
+
+std::optional<MotionFieldView> MotionSidecar::view(const FramePairKey& key,
+                                                   const MotionOptions& options) const {
+  const IndexEntry* e = find_(key, options);
+  if (!e || e->codec != static_cast<std::uint32_t>(SidecarCodec::None)) return std::nullopt;
+  return MotionFieldView{e->cols, e->rows, e->block,
+                         reinterpret_cast<const MotionVector*>(base_ + e->offset)};
+}
+
+std::shared_ptr<const MotionField> MotionSidecar::load(const FramePairKey& key,
+                                                       const MotionOptions& options) const {
+  const IndexEntry* e = find_(key, options);
+  if (!e) return nullptr;
+  auto field = std::make_shared<MotionField>();
+  field->cols = e->cols;
+  field->rows = e->rows;
+  field->block = e->block;
+  field->vectors.resize(std::size_t{e->cols} * e->rows);
+  const auto* src = reinterpret_cast<const char*>(base_ + e->offset);
+  if (e->codec == static_cast<std::uint32_t>(SidecarCodec::None)) {
+    std::memcpy(field->vectors.data(), src, field->bytes());
+    return field;
+  }
+#if defined(MINFI_WITH_LZ4)
+  const int n = LZ4_decompress_safe(src, reinterpret_cast<char*>(field->vectors.data()),
+                                    static_cast<int>(e->stored_bytes),
+                                    static_cast<int>(field->bytes()));
+  if (n < 0 || static_cast<std::size_t>(n) != field->bytes()) {
+    throw std::runtime_error("MotionSidecar: corrupt LZ4 payload");
+  }
+  return field;
+#else
+  throw std::runtime_error("MotionSidecar: entry is LZ4-compressed but LZ4 is not built in");
+#endif
+}
+
+}  // namespace minfi
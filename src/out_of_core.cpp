@@ -0,0 +1,341 @@
+#include "minfi/out_of_core.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minfi/memory.hpp"
+#include "minfi/tuning.hpp"
+
+namespace minfi {
+
+namespace {
+
+constexpr std::size_t kChunkAlign = 4096;
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t elapsed_ns(Clock::time_point since) {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+}
+
+[[noreturn]] void io_error(const std::string& what, const std::string& path) {
+  throw std::runtime_error("interpolate_files: " + what + " '" + path + "': " +
+                           std::strerror(errno));
+}
+
+class Fd {
+ public:
+  explicit Fd(int fd) : fd_(fd) {}
+  Fd(const Fd&) = delete;
+  Fd& operator=(const Fd&) = delete;
+  ~Fd() {
+    if (fd_ >= 0) ::close(fd_);
+  }
+  int get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+std::size_t file_size(const std::string& path) {
+  struct stat st {};
+  if (::stat(path.c_str(), &st) != 0) io_error("cannot stat", path);
+  return static_cast<std::size_t>(st.st_size);
+}
+
+void pread_all(int fd, std::byte* dst, std::size_t bytes, std::uint64_t offset,
+               const std::string& path) {
+  while (bytes > 0) {
+    const ssize_t n = ::pread(fd, dst, bytes, static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) {
+      if (n == 0) errno = EIO;
+      io_error("cannot read", path);
+    }
+    dst += n;
+    bytes -= static_cast<std::size_t>(n);
+    offset += static_cast<std::uint64_t>(n);
+  }
+}
+
+// Writes output chunks on its own thread from a fixed set of buffers, so computing chunk k
+// overlaps writing chunk k - 1.
+class ChunkWriter {
+ public:
+  ChunkWriter(int fd, std::string path, std::size_t chunk_elems, std::size_t buffers)
+      : fd_(fd), path_(std::move(path)) {
+    buffers_.resize(buffers);
+    for (auto& b : buffers_) {
+      b.resize(chunk_elems);
+      free_.push_back(b.data());
+    }
+    thread_ = std::thread([this] { run_(); });
+  }
+
+  ChunkWriter(const ChunkWriter&) = delete;
+  ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+  ~ChunkWriter() { stop_(); }
+
+  // A buffer to fill; blocks while every buffer is queued or being written.
+  float* acquire(std::uint64_t& wait_ns) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+      const auto t0 = Clock::now();
+      cv_.wait(lock, [this] { return !free_.empty() || error_; });
+      wait_ns += elapsed_ns(t0);
+    }
+    if (error_) std::rethrow_exception(error_);
+    float* buffer = free_.front();
+    free_.pop_front();
+    return buffer;
+  }
+
+  void submit(float* buffer, std::size_t elems, std::uint64_t offset) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back({buffer, elems * sizeof(float), offset});
+    }
+    cv_.notify_all();
+  }
+
+  // Waits for every queued chunk to reach the file; rethrows a write error.
+  void finish() {
+    stop_();
+    if (error_) std::rethrow_exception(error_);
+  }
+
+ private:
+  struct Job {
+    float* buffer;
+    std::size_t bytes;
+    std::uint64_t offset;
+  };
+
+  void stop_() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+  }
+
+  void run_() {
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) return;  // stopping and drained
+        job = queue_.front();
+        queue_.pop_front();
+      }
+      if (!failed_) {
+        try {
+          write_(job);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          error_ = std::current_exception();
+          failed_ = true;
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(job.buffer);
+      }
+      cv_.notify_all();
+    }
+  }
+
+  void write_(const Job& job) {
+    const auto* src = reinterpret_cast<const std::byte*>(job.buffer);
+    std::size_t left = job.bytes;
+    std::uint64_t offset = job.offset;
+    while (left > 0) {
+      const ssize_t n = ::pwrite(fd_, src, left, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) {
+        if (n == 0) errno = EIO;
+        io_error("cannot write", path_);
+      }
+      src += n;
+      left -= static_cast<std::size_t>(n);
+      offset += static_cast<std::uint64_t>(n);
+    }
+  }
+
+  int fd_;
+  std::string path_;
+  std::vector<Vector<float, Subsystem::Frames>> buffers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<float*> free_;
+  std::deque<Job> queue_;
+  bool stopping_ = false;
+  bool failed_ = false;  // writer thread only
+  std::exception_ptr error_;
+  std::thread thread_;
+};
+
+// Read-only mapping of a whole input file.
+class Mapping {
+ public:
+  Mapping(const std::string& path, std::size_t bytes) : bytes_(bytes) {
+    if (bytes_ == 0) return;
+    Fd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) io_error("cannot open", path);
+    void* p = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd.get(), 0);
+    if (p == MAP_FAILED) io_error("cannot map", path);
+    base_ = static_cast<const std::byte*>(p);
+    ::madvise(const_cast<std::byte*>(base_), bytes_, MADV_SEQUENTIAL);
+  }
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+  ~Mapping() {
+    if (base_) ::munmap(const_cast<std::byte*>(base_), bytes_);
+  }
+
+  const std::byte* data() const { return base_; }
+
+  // madvise over [offset, offset + length), widened to whole pages.
+  void advise(std::size_t offset, std::size_t length, int advice) const {
+    if (!base_ || length == 0 || offset >= bytes_) return;
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t begin = offset / page * page;
+    const std::size_t end = std::min(bytes_, offset + length);
+    ::madvise(const_cast<std::byte*>(base_) + begin, end - begin, advice);
+  }
+
+ private:
+  const std::byte* base_ = nullptr;
+  std::size_t bytes_;
+};
+
+}  // namespace
+
+OutOfCoreStats interpolate_files(const std::string& a_path, const std::string& b_path,
+                                 const std::string& out_path, float t,
+                                 const OutOfCoreOptions& options) {
+  const std::size_t a_size = file_size(a_path);
+  const std::size_t b_size = file_size(b_path);
+  const std::size_t offset = options.input_offset;
+  if (a_size < offset || b_size < offset || a_size - offset != b_size - offset) {
+    throw std::invalid_argument("interpolate_files: inputs hold different sample counts");
+  }
+  if (offset % sizeof(float) != 0) {
+    throw std::invalid_argument("interpolate_files: input_offset is not a multiple of 4");
+  }
+  const std::size_t total = a_size - offset;
+  if (total % sizeof(float) != 0) {
+    throw std::invalid_argument("interpolate_files: input size is not a whole number of floats");
+  }
+
+  // Every buffer that can be alive at once, in chunks.
+  const bool mmap_input = options.input == OutOfCoreInput::Mmap;
+  const std::size_t write_buffers = std::max<std::size_t>(2, options.write_buffers);
+  const std::size_t readahead = std::max<std::size_t>(1, options.reader.readahead);
+  const std::size_t input_chunks = mmap_input ? 2 * 2 : 2 * (readahead + 2);
+  const std::size_t units = input_chunks + write_buffers;
+  std::size_t chunk = options.chunk_bytes;
+  if (chunk == 0) chunk = options.memory_limit / units / kChunkAlign * kChunkAlign;
+  if (chunk == 0 || chunk % kChunkAlign != 0 || chunk * units > options.memory_limit) {
+    throw std::invalid_argument(
+        "interpolate_files: memory_limit does not fit the buffers (need chunk_bytes * " +
+        std::to_string(units) + ", chunk_bytes a nonzero multiple of 4096)");
+  }
+
+  OutOfCoreStats stats;
+  stats.chunk_bytes = chunk;
+  stats.buffer_bytes = chunk * units;
+
+  Fd out_fd(::open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+  if (out_fd.get() < 0) io_error("cannot create", out_path);
+  if (::ftruncate(out_fd.get(), static_cast<off_t>(total)) != 0) io_error("cannot size", out_path);
+
+  const std::size_t chunk_elems = chunk / sizeof(float);
+  const TuningEntry config = detail::cached_active_tuning().select(chunk_elems);
+  ChunkWriter writer(out_fd.get(), out_path, chunk_elems, write_buffers);
+  const auto compute = [&](const float* a, const float* b, std::size_t elems,
+                           std::uint64_t out_offset) {
+    float* dst = writer.acquire(stats.write_wait_ns);
+    const auto t0 = Clock::now();
+    interpolate_tuned_into({a, elems}, {b, elems}, {dst, elems}, t, config);
+    stats.compute_ns += elapsed_ns(t0);
+    writer.submit(dst, elems, out_offset);
+    ++stats.chunks;
+    stats.bytes += elems * sizeof(float);
+  };
+
+  if (mmap_input) {
+    const Mapping a(a_path, a_size), b(b_path, b_size);
+    for (std::size_t off = 0; off < total; off += chunk) {
+      const std::size_t bytes = std::min(chunk, total - off);
+      // Drop the previous chunk before this one is computed and start paging in the next, so
+      // at most two chunks per input are resident.
+      if (off >= chunk) {
+        a.advise(offset + off - chunk, chunk, MADV_DONTNEED);
+        b.advise(offset + off - chunk, chunk, MADV_DONTNEED);
+      }
+      a.advise(offset + off + chunk, chunk, MADV_WILLNEED);
+      b.advise(offset + off + chunk, chunk, MADV_WILLNEED);
+      // Page faults on not-yet-resident input land in compute_ns.
+      const auto* pa = reinterpret_cast<const float*>(a.data() + offset + off);
+      const auto* pb = reinterpret_cast<const float*>(b.data() + offset + off);
+      compute(pa, pb, bytes / sizeof(float), off);
+    }
+  } else {
+    std::size_t off = 0;
+    {
+      FrameReaderOptions ro = options.reader;
+      ro.readahead = readahead;
+      ro.header_bytes = offset;
+      RawFrameReader ra = RawFrameReader::open(a_path, chunk, ro);
+      RawFrameReader rb = RawFrameReader::open(b_path, chunk, ro);
+      for (;;) {
+        const auto t0 = Clock::now();
+        auto ca = ra.next();
+        auto cb = rb.next();
+        stats.read_wait_ns += elapsed_ns(t0);
+        if (!ca || !cb) break;
+        compute(ca->floats().data(), cb->floats().data(), chunk_elems, off);
+        off += chunk;
+      }
+    }
+    // The readers only return whole chunks; the remainder is read directly once their buffers
+    // are gone, so it stays within the limit.
+    if (off < total) {
+      const std::size_t bytes = total - off;
+      Vector<float, Subsystem::Scratch> ta(bytes / sizeof(float)), tb(bytes / sizeof(float));
+      Fd fa(::open(a_path.c_str(), O_RDONLY | O_CLOEXEC));
+      Fd fb(::open(b_path.c_str(), O_RDONLY | O_CLOEXEC));
+      if (fa.get() < 0) io_error("cannot open", a_path);
+      if (fb.get() < 0) io_error("cannot open", b_path);
+      pread_all(fa.get(), reinterpret_cast<std::byte*>(ta.data()), bytes, offset + off, a_path);
+      pread_all(fb.get(), reinterpret_cast<std::byte*>(tb.data()), bytes, offset + off, b_path);
+      compute(ta.data(), tb.data(), ta.size(), off);
+    }
+  }
+  writer.finish();
+  return stats;
+}
+
+}  // namespace minfi
@@ -0,0 +1,91 @@
+#include "minfi/packed.hpp"
+
+#include <stdexcept>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+namespace {
+
+void check_view(const auto& v) {
+  if (v.width > 0 && v.height > 0 && !v.data) {
+    throw std::invalid_argument("interpolate_packed: null image data");
+  }
+  if (v.stride != 0 && v.stride < v.width * bytes_per_pixel(v.format)) {
+    throw std::invalid_argument("interpolate_packed: stride is smaller than a row");
+  }
+}
+
+// One output row. InC / OutC are the source and destination bytes per pixel; the body is fully
+// unrolled per pixel so the loop auto-vectorizes.
+template <std::size_t InC, std::size_t OutC>
+void blend_row(const std::uint8_t* a, const std::uint8_t* b, std::uint8_t* out,
+               std::size_t width, float w) {
+  constexpr std::size_t kColor = 3;
+  for (std::size_t x = 0; x < width; ++x) {
+    const std::uint8_t* pa = a + x * InC;
+    const std::uint8_t* pb = b + x * InC;
+    std::uint8_t* po = out + x * OutC;
+    for (std::size_t c = 0; c < kColor; ++c) po[c] = detail::blend(pa[c], pb[c], w);
+    if constexpr (OutC == 4) {
+      po[3] = InC == 4 ? detail::blend(pa[3], pb[3], w) : std::uint8_t{255};
+    }
+  }
+}
+
+template <std::size_t InC, std::size_t OutC>
+void blend_rows(const PackedImageView& a, const PackedImageView& b,
+                const MutablePackedImageView& out, float w, std::size_t y0, std::size_t rows) {
+  for (std::size_t r = 0; r < rows; ++r) {
+    blend_row<InC, OutC>(a.row(y0 + r), b.row(y0 + r), out.row(r), a.width, w);
+  }
+}
+
+}  // namespace
+
+void interpolate_packed_rows(const PackedImageView& a, const PackedImageView& b,
+                             const MutablePackedImageView& out, float t, std::size_t y0,
+                             std::size_t rows) {
+  check_view(a);
+  check_view(b);
+  check_view(out);
+  if (a.width != b.width || a.height != b.height || a.format != b.format) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  if (out.width != a.width || out.height < rows) {
+    throw std::invalid_argument("interpolate_packed: output size mismatch");
+  }
+  if (y0 > a.height || rows > a.height - y0) {
+    throw std::out_of_range("interpolate_packed: row range outside the image");
+  }
+  const float w = detail::clamp01(t);
+  const bool in4 = a.format == PixelFormat::Rgba8;
+  const bool out4 = out.format == PixelFormat::Rgba8;
+  if (in4 && out4) {
+    blend_rows<4, 4>(a, b, out, w, y0, rows);
+  } else if (in4) {
+    blend_rows<4, 3>(a, b, out, w, y0, rows);
+  } else if (out4) {
+    blend_rows<3, 4>(a, b, out, w, y0, rows);
+  } else {
+    blend_rows<3, 3>(a, b, out, w, y0, rows);
+  }
+}
+
+void interpolate_packed_into(const PackedImageView& a, const PackedImageView& b,
+                             const MutablePackedImageView& out, float t) {
+  if (out.height != a.height) {
+    throw std::invalid_argument("interpolate_packed: output size mismatch");
+  }
+  interpolate_packed_rows(a, b, out, t, 0, a.height);
+}
+
+std::vector<std::uint8_t> interpolate_packed(const PackedImageView& a, const PackedImageView& b,
+                                             PixelFormat out_format, float t) {
+  std::vector<std::uint8_t> out(a.width * a.height * bytes_per_pixel(out_format));
+  interpolate_packed_into(a, b, {out.data(), a.width, a.height, out_format}, t);
+  return out;
+}
+
+}  // namespace minfi
@@ -0,0 +1,169 @@
+#include "minfi/perf_counters.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace minfi {
+
+namespace {
+
+std::uint64_t now_ns() {
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now().time_since_epoch())
+                                        .count());
+}
+
+#if defined(__linux__)
+struct EventConfig {
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+constexpr std::uint64_t cache_read_miss(std::uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by PerfEvent.
+constexpr EventConfig kEvents[kPerfEventCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB)},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+// User-space only, so the default perf_event_paranoid level (2) allows it unprivileged.
+int open_event(const EventConfig& event) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  const long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+  return fd < 0 ? -1 : static_cast<int>(fd);
+}
+
+// Counter value scaled up for the time it was multiplexed off the PMU.
+bool read_event(int fd, std::uint64_t& value) {
+  std::uint64_t buf[3] = {};  // value, time enabled, time running
+  if (::read(fd, buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) return false;
+  value = buf[0];
+  if (buf[2] > 0 && buf[2] < buf[1]) {
+    value = static_cast<std::uint64_t>(static_cast<double>(buf[0]) * static_cast<double>(buf[1]) /
+                                       static_cast<double>(buf[2]));
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
+std::string_view to_string(PerfEvent event) {
+  switch (event) {
+    case PerfEvent::Cycles:
+      return "cycles";
+    case PerfEvent::Instructions:
+      return "instructions";
+    case PerfEvent::LlcMisses:
+      return "llc-misses";
+    case PerfEvent::DtlbMisses:
+      return "dtlb-misses";
+    case PerfEvent::PageFaults:
+      return "page-faults";
+  }
+  return "unknown";
+}
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+#if defined(__linux__)
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) fds_[i] = open_event(kEvents[i]);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+  for (const int fd : fds_) {
+    if (fd >= 0) ::close(fd);
+  }
+#endif
+}
+
+bool PerfCounters::any_available() const {
+  for (const int fd : fds_) {
+    if (fd >= 0) return true;
+  }
+  return false;
+}
+
+PerfSample PerfCounters::read() const {
+  PerfSample s;
+#if defined(__linux__)
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    if (fds_[i] >= 0) s.valid[i] = read_event(fds_[i], s.values[i]);
+  }
+#endif
+  s.time_ns = now_ns();
+  return s;
+}
+
+void PerfStats::add(const PerfSample& begin, const PerfSample& end) {
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    // Scaled multiplexed counters can step backwards slightly; clamp rather than wrap.
+    const bool ok = begin.valid[i] && end.valid[i];
+    valid_[i] = (calls_ == 0 || valid_[i]) && ok;
+    if (ok && end.values[i] > begin.values[i]) totals_[i] += end.values[i] - begin.values[i];
+  }
+  if (end.time_ns > begin.time_ns) time_ns_ += end.time_ns - begin.time_ns;
+  ++calls_;
+}
+
+double PerfStats::per_call(PerfEvent e) const { return per_unit(e, 1.0); }
+
+double PerfStats::per_unit(PerfEvent e, double units_per_call) const {
+  if (!has(e) || units_per_call <= 0) return 0.0;
+  return static_cast<double>(total(e)) / (static_cast<double>(calls_) * units_per_call);
+}
+
+double PerfStats::ipc() const {
+  if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions)) return 0.0;
+  const std::uint64_t cycles = total(PerfEvent::Cycles);
+  return cycles ? static_cast<double>(total(PerfEvent::Instructions)) / cycles : 0.0;
+}
+
+void PerfStats::report(std::ostream& os, double elems_per_call, double bytes_per_call) const {
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+  bool any_missing = false;
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    const auto e = static_cast<PerfEvent>(i);
+    if (!has(e)) {
+      os << (any_missing ? ", " : "  unavailable: ") << to_string(e);
+      any_missing = true;
+    }
+  }
+  if (any_missing) os << "\n";
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    const auto e = static_cast<PerfEvent>(i);
+    if (!has(e)) continue;
+    // Ratios per element and per byte span many magnitudes, so they print in general format.
+    os << "  " << std::left << std::setw(13) << to_string(e) << std::right
+       << " total=" << total(e) << std::fixed << std::setprecision(1) << " per call=" << per_call(e)
+       << std::defaultfloat << std::setprecision(4) << " per elem=" << per_unit(e, elems_per_call)
+       << " per byte=" << per_unit(e, bytes_per_call) << "\n";
+  }
+  if (ipc() > 0) os << "  ipc=" << std::fixed << std::setprecision(2) << ipc() << "\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+}  // namespace minfi
@@ -0,0 +1,87 @@
+#include "minfi/present.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace minfi {
+
+FrameMailbox::FrameMailbox(std::size_t frame_bytes) : frame_bytes_(frame_bytes) {
+  if (frame_bytes == 0) throw std::invalid_argument("FrameMailbox: frame_bytes must be > 0");
+  for (Buffer& b : buffers_) b.resize(frame_bytes);
+}
+
+void FrameMailbox::publish() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(back_, middle_);
+    if (fresh_) ++stats_.dropped;
+    fresh_ = true;
+    ++stats_.published;
+  }
+  cv_.notify_all();
+}
+
+std::optional<std::span<const std::uint8_t>> FrameMailbox::take(
+    std::chrono::nanoseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!cv_.wait_for(lock, timeout, [this] { return fresh_ || closed_; }) || closed_) {
+    return std::nullopt;
+  }
+  std::swap(front_, middle_);
+  fresh_ = false;
+  return std::span<const std::uint8_t>(front_->data(), frame_bytes_);
+}
+
+void FrameMailbox::done() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.presented;
+  }
+  cv_.notify_all();
+}
+
+void FrameMailbox::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  cv_.notify_all();
+}
+
+bool FrameMailbox::wait_presented(std::chrono::nanoseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return cv_.wait_for(lock, timeout, [this] {
+    return stats_.presented + stats_.dropped >= stats_.published;
+  });
+}
+
+bool FrameMailbox::closed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_;
+}
+
+PresentStats FrameMailbox::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+Presenter::Presenter(PresentSink& sink, std::size_t frame_bytes)
+    : sink_(sink), mailbox_(frame_bytes), thread_([this] { run_(); }) {}
+
+Presenter::~Presenter() {
+  mailbox_.close();
+  thread_.join();
+}
+
+void Presenter::run_() {
+  for (;;) {
+    if (auto frame = mailbox_.take(std::chrono::seconds(1))) {
+      sink_.present(*frame);
+      mailbox_.done();
+    } else if (mailbox_.closed()) {
+      return;
+    }
+  }
+}
+
+}  // namespace minfi
@@ -0,0 +1,157 @@
+#include "minfi/quality.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINFI_HAVE_SSE2 1
+#endif
+
+#include "minfi/memory.hpp"
+
+namespace minfi {
+
+namespace {
+
+// Float lanes are flushed into the double total every block, bounding rounding error on
+// large frames while keeping the inner loop four-wide.
+constexpr std::size_t kFlushBlock = 4096;
+
+#if defined(MINFI_HAVE_SSE2)
+double horizontal_sum(__m128 v) {
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, v);
+  return (static_cast<double>(lanes[0]) + lanes[1]) + (static_cast<double>(lanes[2]) + lanes[3]);
+}
+#endif
+
+double squared_error(const float* a, const float* b, std::size_t n) {
+  double total = 0.0;
+  std::size_t i = 0;
+#if defined(MINFI_HAVE_SSE2)
+  while (i + 4 <= n) {
+    const std::size_t end = std::min(n, i + kFlushBlock) & ~std::size_t{3};
+    __m128 acc = _mm_setzero_ps();
+    for (; i < end; i += 4) {
+      const __m128 d = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+      acc = _mm_add_ps(acc, _mm_mul_ps(d, d));
+    }
+    total += horizontal_sum(acc);
+  }
+#endif
+  for (; i < n; ++i) {
+    const double d = static_cast<double>(a[i]) - b[i];
+    total += d * d;
+  }
+  return total;
+}
+
+// Running sums of x, y, x^2, y^2 and xy over one window.
+struct WindowSums {
+  double x = 0, y = 0, xx = 0, yy = 0, xy = 0;
+};
+
+// Adds one window row of n contiguous samples to `s`.
+void accumulate_row(const float* x, const float* y, std::size_t n, WindowSums& s) {
+  std::size_t i = 0;
+#if defined(MINFI_HAVE_SSE2)
+  __m128 sx = _mm_setzero_ps(), sy = _mm_setzero_ps();
+  __m128 sxx = _mm_setzero_ps(), syy = _mm_setzero_ps(), sxy = _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    const __m128 vx = _mm_loadu_ps(x + i);
+    const __m128 vy = _mm_loadu_ps(y + i);
+    sx = _mm_add_ps(sx, vx);
+    sy = _mm_add_ps(sy, vy);
+    sxx = _mm_add_ps(sxx, _mm_mul_ps(vx, vx));
+    syy = _mm_add_ps(syy, _mm_mul_ps(vy, vy));
+    sxy = _mm_add_ps(sxy, _mm_mul_ps(vx, vy));
+  }
+  s.x += horizontal_sum(sx);
+  s.y += horizontal_sum(sy);
+  s.xx += horizontal_sum(sxx);
+  s.yy += horizontal_sum(syy);
+  s.xy += horizontal_sum(sxy);
+#endif
+  for (; i < n; ++i) {
+    const double vx = x[i], vy = y[i];
+    s.x += vx;
+    s.y += vy;
+    s.xx += vx * vx;
+    s.yy += vy * vy;
+    s.xy += vx * vy;
+  }
+}
+
+// Mean SSIM of one channel plane (width x height, contiguous rows).
+double plane_ssim(const float* a, const float* b, std::size_t width, std::size_t height,
+                  const SsimOptions& o, double& windows) {
+  const std::size_t win_w = std::min(o.window, width);
+  const std::size_t win_h = std::min(o.window, height);
+  const double n = static_cast<double>(win_w * win_h);
+  const double c1 = (0.01 * o.peak) * (0.01 * o.peak);
+  const double c2 = (0.03 * o.peak) * (0.03 * o.peak);
+  double total = 0.0;
+  for (std::size_t y0 = 0; y0 + win_h <= height; y0 += o.stride) {
+    for (std::size_t x0 = 0; x0 + win_w <= width; x0 += o.stride) {
+      WindowSums s;
+      for (std::size_t y = y0; y < y0 + win_h; ++y) {
+        accumulate_row(a + y * width + x0, b + y * width + x0, win_w, s);
+      }
+      const double mx = s.x / n, my = s.y / n;
+      const double vx = std::max(0.0, s.xx / n - mx * mx);
+      const double vy = std::max(0.0, s.yy / n - my * my);
+      const double cxy = s.xy / n - mx * my;
+      total += ((2 * mx * my + c1) * (2 * cxy + c2)) / ((mx * mx + my * my + c1) * (vx + vy + c2));
+      windows += 1;
+    }
+  }
+  return total;
+}
+
+}  // namespace
+
+double mse(std::span<const float> a, std::span<const float> b) {
+  if (a.size() != b.size()) throw std::invalid_argument("mse: size mismatch");
+  if (a.empty()) return 0.0;
+  return squared_error(a.data(), b.data(), a.size()) / static_cast<double>(a.size());
+}
+
+double psnr(std::span<const float> a, std::span<const float> b, float peak) {
+  if (a.size() != b.size()) throw std::invalid_argument("psnr: size mismatch");
+  if (!(peak > 0.0f)) throw std::invalid_argument("psnr: peak must be positive");
+  const double e = mse(a, b);
+  if (e == 0.0) return std::numeric_limits<double>::infinity();
+  return 10.0 * std::log10(static_cast<double>(peak) * peak / e);
+}
+
+double ssim(std::span<const float> a, std::span<const float> b, const FrameShape& shape,
+            const SsimOptions& options) {
+  if (shape.elems() == 0 || a.size() != shape.elems() || b.size() != shape.elems()) {
+    throw std::invalid_argument("ssim: frames do not match the shape");
+  }
+  if (options.window == 0 || options.stride == 0 || !(options.peak > 0.0f)) {
+    throw std::invalid_argument("ssim: window, stride and peak must be positive");
+  }
+  double total = 0.0;
+  double windows = 0.0;
+  if (shape.channels == 1) {
+    total = plane_ssim(a.data(), b.data(), shape.width, shape.height, options, windows);
+  } else {
+    // Deinterleave one channel at a time so window rows are contiguous for the SIMD sums.
+    const std::size_t pixels = shape.width * shape.height;
+    Vector<float, Subsystem::Scratch> pa(pixels), pb(pixels);
+    for (std::size_t c = 0; c < shape.channels; ++c) {
+      for (std::size_t p = 0; p < pixels; ++p) {
+        pa[p] = a[p * shape.channels + c];
+        pb[p] = b[p * shape.channels + c];
+      }
+      total += plane_ssim(pa.data(), pb.data(), shape.width, shape.height, options, windows);
+    }
+  }
+  return total / windows;
+}
+
+}  // namespace minfi
@@ -0,0 +1,62 @@
+// Feeds synthetic frames into a minfi shared-memory ring, standing in for a capture process.
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "minfi/shm_ring.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+static void usage(const char* argv0) {
+  std::cout << "minfi_shm_producer — write synthetic frames into a shared-memory ring\n\n";
+  std::cout << "Usage: " << argv0 << " <name> [frame_elems] [frames] [fps] [slots]\n";
+  std::cout << "  name       : shm segment name, e.g. minfi-capture\n";
+  std::cout << "  frame_elems: floats per frame (default 1920*1080*3)\n";
+  std::cout << "  frames     : frames to publish (default 600)\n";
+  std::cout << "  fps        : publish rate, 0 = as fast as the consumer allows (default 60)\n";
+  std::cout << "  slots      : ring capacity (default 8)\n";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2 || std::string(argv[1]) == "--help") {
+    usage(argv[0]);
+    return argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+  const std::string name = argv[1];
+  const std::size_t elems = argc >= 3 ? std::stoul(argv[2]) : 1920u * 1080u * 3u;
+  const std::size_t frames = argc >= 4 ? std::stoul(argv[3]) : 600;
+  const double fps = argc >= 5 ? std::stod(argv[4]) : 60.0;
+  const std::size_t slots = argc >= 6 ? std::stoul(argv[5]) : 8;
+
+  try {
+    auto ring = minfi::ShmFrameRing::create(name, slots, elems);
+    std::cout << "producing " << frames << " frames of " << elems << " floats into /" << name
+              << " (" << ring.slots() << " slots)\n";
+    const auto period = fps > 0 ? std::chrono::duration<double>(1.0 / fps)
+                                : std::chrono::duration<double>(0);
+    auto next = clock_type::now();
+    for (std::size_t f = 0; f < frames; ++f) {
+      auto slot = ring.acquire_write();
+      const float phase = 0.05f * static_cast<float>(f);
+      for (std::size_t i = 0; i < slot.size(); ++i) {
+        slot[i] = 0.5f + 0.5f * std::sin(phase + 0.001f * static_cast<float>(i % 4096));
+      }
+      if (period.count() > 0) {
+        next += std::chrono::duration_cast<clock_type::duration>(period);
+        std::this_thread::sleep_until(next);
+      }
+      ring.publish(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       clock_type::now().time_since_epoch())
+                       .count());
+    }
+    // Keep the segment alive until the consumer has drained it.
+    while (ring.readable() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+#include "minfi/shm_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace minfi {
+
+namespace {
+
+constexpr std::uint64_t kRingMagic = 0x474e49524946494dull;  // "MIFIRING"
+constexpr std::uint32_t kRingVersion = 1;
+constexpr std::size_t kAlign = 64;
+
+using Counter = std::atomic<std::uint32_t>;
+static_assert(Counter::is_always_lock_free, "shared-memory counters must be lock-free");
+
+constexpr std::size_t align_up(std::size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+std::string shm_name(const std::string& name) {
+  return name.rfind('/', 0) == 0 ? name : "/" + name;
+}
+
+// Blocks while *word == expected, for at most `timeout` (negative: forever).
+void wait_on(Counter& word, std::uint32_t expected, std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+  timespec ts{};
+  timespec* tsp = nullptr;
+  if (timeout.count() >= 0) {
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    tsp = &ts;
+  }
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, tsp,
+            nullptr, 0);
+#else
+  (void) timeout;
+  if (word.load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+#endif
+}
+
+void wake(Counter& word) {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr,
+            0);
+#else
+  (void) word;
+#endif
+}
+
+}  // namespace
+
+struct ShmFrameRing::Header {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t slots;  // power of two
+  std::uint64_t frame_elems;
+  std::uint64_t slot_bytes;  // SlotMeta + payload, 64-byte aligned
+  // Publish / release counts. They wrap at 2^32; with a power-of-two slot count the slot index
+  // (counter & (slots - 1)) and the fill level (head - tail) stay correct across the wrap.
+  alignas(kAlign) Counter head;
+  Counter consumer_waiting;
+  alignas(kAlign) Counter tail;
+  Counter producer_waiting;
+};
+
+ShmFrameRing ShmFrameRing::create(const std::string& name, std::size_t slots,
+                                  std::size_t frame_elems) {
+  std::size_t n = 1;
+  while (n < slots) n <<= 1;
+  if (n > (1u << 30) || frame_elems == 0) {
+    throw std::invalid_argument("ShmFrameRing: bad slot count or frame size");
+  }
+  const std::size_t header_bytes = align_up(sizeof(Header));
+  const std::size_t slot_bytes = align_up(kAlign + frame_elems * sizeof(float));
+  const std::size_t bytes = header_bytes + n * slot_bytes;
+
+  const std::string path = shm_name(name);
+  ::shm_unlink(path.c_str());
+  const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("ShmFrameRing: shm_open failed: " + std::string(strerror(errno)));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    throw std::runtime_error("ShmFrameRing: ftruncate failed");
+  }
+  void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    throw std::runtime_error("ShmFrameRing: mmap failed");
+  }
+
+  auto* h = new (base) Header{};
+  h->version = kRingVersion;
+  h->slots = static_cast<std::uint32_t>(n);
+  h->frame_elems = frame_elems;
+  h->slot_bytes = slot_bytes;
+  // Publish the magic last so a concurrent open() never sees a half-initialized header.
+  std::atomic_ref<std::uint64_t>(h->magic).store(kRingMagic, std::memory_order_release);
+  return ShmFrameRing(path, base, bytes, true);
+}
+
+ShmFrameRing ShmFrameRing::open(const std::string& name) {
+  const std::string path = shm_name(name);
+  const int fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+  if (fd < 0) throw std::runtime_error("ShmFrameRing: cannot open '" + path + "'");
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error("ShmFrameRing: segment too small");
+  }
+  const auto bytes = static_cast<std::size_t>(st.st_size);
+  void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) throw std::runtime_error("ShmFrameRing: mmap failed");
+  auto* h = static_cast<Header*>(base);
+  // Pairs with the release store in create(); the header is trusted only after this load.
+  const std::uint64_t magic =
+      std::atomic_ref<std::uint64_t>(h->magic).load(std::memory_order_acquire);
+  const std::size_t header_bytes = align_up(sizeof(Header));
+  // Slot indexing masks counters with slots - 1, and every slot must lie inside the mapping.
+  if (magic != kRingMagic || h->version != kRingVersion || h->slots == 0 ||
+      (h->slots & (h->slots - 1)) != 0 || bytes < header_bytes || h->frame_elems == 0 ||
+      h->frame_elems > bytes / sizeof(float) ||
+      h->slot_bytes < kAlign + h->frame_elems * sizeof(float) ||
+      h->slot_bytes > (bytes - header_bytes) / h->slots) {
+    ::munmap(base, bytes);
+    throw std::runtime_error("ShmFrameRing: not a compatible frame ring");
+  }
+  return ShmFrameRing(path, base, bytes, false);
+}
+
+ShmFrameRing::ShmFrameRing(std::string name, void* base, std::size_t bytes, bool owner)
+    : name_(std::move(name)),
+      base_(base),
+      bytes_(bytes),
+      owner_(owner),
+      header_(static_cast<Header*>(base)) {}
+
+ShmFrameRing::ShmFrameRing(ShmFrameRing&& other) noexcept
+    : name_(std::move(other.name_)),
+      base_(std::exchange(other.base_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)),
+      owner_(std::exchange(other.owner_, false)),
+      header_(std::exchange(other.header_, nullptr)) {}
+
+ShmFrameRing& ShmFrameRing::operator=(ShmFrameRing&& other) noexcept {
+  ShmFrameRing tmp(std::move(other));
+  std::swap(name_, tmp.name_);
+  std::swap(base_, tmp.base_);
+  std::swap(bytes_, tmp.bytes_);
+  std::swap(owner_, tmp.owner_);
+  std::swap(header_, tmp.header_);
+  return *this;
+}
+
+ShmFrameRing::~ShmFrameRing() {
+  if (base_) ::munmap(base_, bytes_);
+  if (owner_) ::shm_unlink(name_.c_str());
+}
+
+std::size_t ShmFrameRing::slots() const { return header_->slots; }
+std::size_t ShmFrameRing::frame_elems() const { return header_->frame_elems; }
+
+std::byte* ShmFrameRing::slot_(std::uint32_t counter) const {
+  auto* first = static_cast<std::byte*>(base_) + align_up(sizeof(Header));
+  return first + static_cast<std::size_t>(counter & (header_->slots - 1)) * header_->slot_bytes;
+}
+
+std::span<float> ShmFrameRing::try_acquire_write() {
+  const std::uint32_t head = header_->head.load(std::memory_order_relaxed);
+  const std::uint32_t tail = header_->tail.load(std::memory_order_acquire);
+  if (head - tail >= header_->slots) return {};
+  return {reinterpret_cast<float*>(slot_(head) + kAlign), header_->frame_elems};
+}
+
+std::span<float> ShmFrameRing::acquire_write(std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;) {
+    if (auto s = try_acquire_write(); !s.empty()) return s;
+    std::chrono::nanoseconds left{-1};
+    if (timeout.count() >= 0) {
+      left = deadline - std::chrono::steady_clock::now();
+      if (left.count() <= 0) return {};
+    }
+    header_->producer_waiting.store(1, std::memory_order_seq_cst);
+    const std::uint32_t tail = header_->tail.load(std::memory_order_seq_cst);
+    if (header_->head.load(std::memory_order_relaxed) - tail >= header_->slots) {
+      wait_on(header_->tail, tail, left);
+    }
+    header_->producer_waiting.store(0, std::memory_order_relaxed);
+  }
+}
+
+void ShmFrameRing::publish(std::int64_t timestamp_ns) {
+  const std::uint32_t head = header_->head.load(std::memory_order_relaxed);
+  auto* meta = reinterpret_cast<SlotMeta*>(slot_(head));
+  meta->sequence = head;
+  meta->timestamp_ns = timestamp_ns;
+  header_->head.store(head + 1, std::memory_order_seq_cst);
+  if (header_->consumer_waiting.load(std::memory_order_seq_cst)) wake(header_->head);
+}
+
+std::size_t ShmFrameRing::readable() const {
+  return header_->head.load(std::memory_order_acquire) -
+         header_->tail.load(std::memory_order_relaxed);
+}
+
+bool ShmFrameRing::wait_readable(std::size_t n, std::chrono::milliseconds timeout) {
+  if (n > header_->slots) throw std::invalid_argument("ShmFrameRing: wait exceeds capacity");
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;) {
+    if (readable() >= n) return true;
+    std::chrono::nanoseconds left{-1};
+    if (timeout.count() >= 0) {
+      left = deadline - std::chrono::steady_clock::now();
+      if (left.count() <= 0) return false;
+    }
+    header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+    const std::uint32_t head = header_->head.load(std::memory_order_seq_cst);
+    if (head - header_->tail.load(std::memory_order_relaxed) < n) {
+      wait_on(header_->head, head, left);
+    }
+    header_->consumer_waiting.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::span<const float> ShmFrameRing::read(std::size_t i) const {
+  if (i >= readable()) throw std::out_of_range("ShmFrameRing: read past the readable frames");
+  const std::uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+  return {reinterpret_cast<const float*>(slot_(tail + static_cast<std::uint32_t>(i)) + kAlign),
+          header_->frame_elems};
+}
+
+const ShmFrameRing::SlotMeta& ShmFrameRing::meta(std::size_t i) const {
+  if (i >= readable()) throw std::out_of_range("ShmFrameRing: meta past the readable frames");
+  const std::uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+  return *reinterpret_cast<const SlotMeta*>(slot_(tail + static_cast<std::uint32_t>(i)));
+}
+
+void ShmFrameRing::release(std::size_t n) {
+  // Moving tail past head would corrupt the shared counters for both processes.
+  if (n > readable()) throw std::invalid_argument("ShmFrameRing: release exceeds readable()");
+  const std::uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+  header_->tail.store(tail + static_cast<std::uint32_t>(n), std::memory_order_seq_cst);
+  if (header_->producer_waiting.load(std::memory_order_seq_cst)) wake(header_->tail);
+}
+
+}  // namespace minfi
@@ -0,0 +1,358 @@
+#include "minfi/tuning.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINFI_HAVE_SSE2 1
+#endif
+
+#include "minfi/executor.hpp"
+#include "minfi/kernels.hpp"
+#include "minfi/memory.hpp"
+
+namespace minfi {
+
+namespace {
+
+// Same arithmetic as detail::blend<float>, with stores that do not allocate cache lines: on
+// frames larger than the last-level cache this avoids reading the output before writing it.
+void blend_streaming(const float* a, const float* b, float* out, std::size_t n, float w) {
+  const float wa = 1.0f - w;
+  std::size_t i = 0;
+#if defined(MINFI_HAVE_SSE2)
+  for (; i < n && (reinterpret_cast<std::uintptr_t>(out + i) & 15) != 0; ++i) {
+    out[i] = a[i] * wa + b[i] * w;
+  }
+  const __m128 va = _mm_set1_ps(wa);
+  const __m128 vb = _mm_set1_ps(w);
+  for (; i + 4 <= n; i += 4) {
+    const __m128 x = _mm_mul_ps(_mm_loadu_ps(a + i), va);
+    const __m128 y = _mm_mul_ps(_mm_loadu_ps(b + i), vb);
+    _mm_stream_ps(out + i, _mm_add_ps(x, y));
+  }
+  _mm_sfence();
+#endif
+  for (; i < n; ++i) out[i] = a[i] * wa + b[i] * w;
+}
+
+// Shared with helper tasks, which may start after the caller has returned; they then find no
+// tile left and exit without calling the body.
+struct TileJob {
+  std::function<void(std::size_t)> body;
+  std::size_t tiles = 0;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> done{0};
+
+  void work() {
+    for (;;) {
+      const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= tiles) return;
+      body(i);
+      if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == tiles) done.notify_all();
+    }
+  }
+};
+
+// Readers keep a per-thread copy of the config and only take the mutex after set_active_tuning()
+// bumps the generation, so the interpolate() hot path is one acquire load.
+struct ActiveTuning {
+  std::once_flag loaded;
+  std::mutex mutex;
+  std::shared_ptr<const TuningConfig> config;
+  std::atomic<std::uint64_t> generation{0};
+};
+
+ActiveTuning& active_state() {
+  static ActiveTuning state;
+  return state;
+}
+
+std::shared_ptr<const TuningConfig> load_startup_tuning() {
+  const std::filesystem::path path = default_tuning_path();
+  std::error_code ec;
+  if (!path.empty() && std::filesystem::exists(path, ec)) {
+    try {
+      return std::make_shared<const TuningConfig>(load_tuning(path));
+    } catch (const std::exception&) {
+      // Fall through to the defaults; load_tuning() reports the problem when called directly.
+    }
+  }
+  return std::make_shared<const TuningConfig>();
+}
+
+[[noreturn]] void parse_error(const std::filesystem::path& path, std::size_t line,
+                              const std::string& what) {
+  throw std::runtime_error("load_tuning: " + path.string() + ":" + std::to_string(line) + ": " +
+                           what);
+}
+
+std::vector<std::size_t> default_thread_candidates() {
+  const std::size_t hw = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  std::vector<std::size_t> threads;
+  for (std::size_t n = 1; n < hw; n *= 2) threads.push_back(n);
+  threads.push_back(hw);
+  return threads;
+}
+
+}  // namespace
+
+namespace detail {
+
+void blend_range(KernelVariant kernel, const float* a, const float* b, float* out,
+                 std::size_t n, float w) {
+  if (kernel == KernelVariant::Streaming) {
+    blend_streaming(a, b, out, n, w);
+  } else {
+    for_each_pixel<float, 0>(a, b, out, n, [w](float x, float y) { return blend(x, y, w); });
+  }
+}
+
+void run_tiles(std::size_t count, std::size_t threads,
+               const std::function<void(std::size_t)>& body) {
+  const std::size_t helpers = std::min(std::max<std::size_t>(1, threads), count);
+  if (helpers <= 1) {
+    for (std::size_t i = 0; i < count; ++i) body(i);
+    return;
+  }
+  auto job = std::make_shared<TileJob>();
+  job->body = body;
+  job->tiles = count;
+  Executor& executor = default_executor();
+  for (std::size_t i = 1; i < helpers; ++i) executor.submit([job] { job->work(); });
+  job->work();
+  // Every tile is claimed by now; wait only for those still being written by helpers.
+  for (std::size_t d = job->done.load(std::memory_order_acquire); d != count;
+       d = job->done.load(std::memory_order_acquire)) {
+    job->done.wait(d, std::memory_order_acquire);
+  }
+}
+
+}  // namespace detail
+
+const char* to_string(KernelVariant kernel) {
+  switch (kernel) {
+    case KernelVariant::Flat:
+      return "flat";
+    case KernelVariant::Streaming:
+      return "streaming";
+  }
+  return "unknown";
+}
+
+std::optional<KernelVariant> parse_kernel_variant(std::string_view name) {
+  if (name == "flat") return KernelVariant::Flat;
+  if (name == "streaming") return KernelVariant::Streaming;
+  return std::nullopt;
+}
+
+TuningEntry TuningConfig::select(std::size_t elems) const {
+  TuningEntry best;
+  bool found = false;
+  for (const TuningEntry& e : entries) {
+    if (e.min_elems <= elems && (!found || e.min_elems >= best.min_elems)) {
+      best = e;
+      found = true;
+    }
+  }
+  return best;
+}
+
+TuningConfig load_tuning(const std::filesystem::path& path) {
+  std::ifstream in(path);
+  if (!in) throw std::runtime_error("load_tuning: cannot open " + path.string());
+  TuningConfig config;
+  bool header = false;
+  std::string line;
+  for (std::size_t lineno = 1; std::getline(in, line); ++lineno) {
+    if (const auto hash = line.find('#'); hash != std::string::npos) line.resize(hash);
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first)) continue;
+    if (!header) {
+      int version = 0;
+      if (first != "minfi-tuning" || !(fields >> version) || version != 1) {
+        parse_error(path, lineno, "expected 'minfi-tuning 1'");
+      }
+      header = true;
+      continue;
+    }
+    TuningEntry e;
+    std::string kernel, extra;
+    std::istringstream number(first);
+    if (!(number >> e.min_elems) || !(fields >> e.tile_elems >> e.threads >> kernel) ||
+        (fields >> extra)) {
+      parse_error(path, lineno, "expected '<min_elems> <tile_elems> <threads> <kernel>'");
+    }
+    if (e.threads == 0) parse_error(path, lineno, "threads must be > 0");
+    const auto variant = parse_kernel_variant(kernel);
+    if (!variant) parse_error(path, lineno, "unknown kernel '" + kernel + "'");
+    e.kernel = *variant;
+    config.entries.push_back(e);
+  }
+  if (!header) throw std::runtime_error("load_tuning: " + path.string() + ": empty file");
+  std::sort(config.entries.begin(), config.entries.end(),
+            [](const TuningEntry& x, const TuningEntry& y) { return x.min_elems < y.min_elems; });
+  return config;
+}
+
+void save_tuning(const TuningConfig& config, const std::filesystem::path& path) {
+  if (path.has_parent_path()) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) throw std::runtime_error("save_tuning: cannot open " + path.string());
+  out << "minfi-tuning 1\n";
+  out << "# min_elems tile_elems threads kernel\n";
+  for (const TuningEntry& e : config.entries) {
+    out << e.min_elems << ' ' << e.tile_elems << ' ' << e.threads << ' ' << to_string(e.kernel)
+        << '\n';
+  }
+  out.flush();
+  if (!out) throw std::runtime_error("save_tuning: cannot write " + path.string());
+}
+
+std::filesystem::path default_tuning_path() {
+  if (const char* file = std::getenv("MINFI_TUNING_FILE")) return file;
+  if (const char* xdg = std::getenv("XDG_CONFIG_HOME"); xdg && *xdg) {
+    return std::filesystem::path(xdg) / "minfi" / "tuning.conf";
+  }
+  if (const char* home = std::getenv("HOME"); home && *home) {
+    return std::filesystem::path(home) / ".config" / "minfi" / "tuning.conf";
+  }
+  return {};
+}
+
+namespace {
+
+void publish(ActiveTuning& state, std::shared_ptr<const TuningConfig> config) {
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.config = std::move(config);
+  state.generation.fetch_add(1, std::memory_order_release);
+}
+
+// This thread's copy of the active config, refreshed when the generation has moved on.
+const std::shared_ptr<const TuningConfig>& current_tuning() {
+  ActiveTuning& state = active_state();
+  std::call_once(state.loaded, [&] { publish(state, load_startup_tuning()); });
+  thread_local std::shared_ptr<const TuningConfig> cached;
+  thread_local std::uint64_t seen = 0;
+  if (state.generation.load(std::memory_order_acquire) != seen) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    cached = state.config;
+    seen = state.generation.load(std::memory_order_relaxed);
+  }
+  return cached;
+}
+
+}  // namespace
+
+const TuningConfig& detail::cached_active_tuning() { return *current_tuning(); }
+
+std::shared_ptr<const TuningConfig> active_tuning() { return current_tuning(); }
+
+void set_active_tuning(TuningConfig config) {
+  auto shared = std::make_shared<const TuningConfig>(std::move(config));
+  ActiveTuning& state = active_state();
+  std::call_once(state.loaded, [] {});  // an explicit config replaces the startup file
+  publish(state, std::move(shared));
+}
+
+void interpolate_tuned_into(std::span<const float> a, std::span<const float> b,
+                            std::span<float> out, float t, const TuningEntry& config) {
+  detail::check_sizes<0>(a.size(), b.size(), out.size());
+  const float w = detail::clamp01(t);
+  const std::size_t n = a.size();
+  const std::size_t threads = std::max<std::size_t>(1, config.threads);
+  if (threads == 1) {
+    detail::blend_range(config.kernel, a.data(), b.data(), out.data(), n, w);
+    return;
+  }
+  const std::size_t tile =
+      std::max<std::size_t>(1, config.tile_elems ? config.tile_elems : (n + threads - 1) / threads);
+  const std::size_t tiles = (n + tile - 1) / tile;
+  const float* pa = a.data();
+  const float* pb = b.data();
+  float* po = out.data();
+  detail::run_tiles(tiles, threads, [&](std::size_t i) {
+    const std::size_t off = i * tile;
+    detail::blend_range(config.kernel, pa + off, pb + off, po + off, std::min(tile, n - off), w);
+  });
+}
+
+TuningConfig calibrate(const CalibrationOptions& options) {
+  if (options.frame_elems.empty() || options.kernels.empty() || options.repeats < 1) {
+    throw std::invalid_argument("calibrate: need frame sizes, kernels and repeats >= 1");
+  }
+  if (options.tile_elems.empty()) throw std::invalid_argument("calibrate: need tile sizes");
+  std::vector<std::size_t> sizes = options.frame_elems;
+  std::sort(sizes.begin(), sizes.end());
+  sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+  const std::vector<std::size_t> thread_candidates =
+      options.threads.empty() ? default_thread_candidates() : options.threads;
+
+  std::vector<TuningEntry> candidates;
+  for (const KernelVariant kernel : options.kernels) {
+    for (const std::size_t threads : thread_candidates) {
+      if (threads <= 1) {
+        // Tile size is irrelevant when a single thread does all the work.
+        candidates.push_back({0, 0, 1, kernel});
+        continue;
+      }
+      for (const std::size_t tile : options.tile_elems) {
+        candidates.push_back({0, tile, threads, kernel});
+      }
+    }
+  }
+
+  using Clock = std::chrono::steady_clock;
+  TuningConfig config;
+  for (std::size_t s = 0; s < sizes.size(); ++s) {
+    const std::size_t n = sizes[s];
+    Vector<float, Subsystem::Scratch> a(n), b(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      a[i] = static_cast<float>(i % 251) / 251.0f;
+      b[i] = static_cast<float>(i % 241) / 241.0f;
+    }
+
+    TuningEntry best;
+    double best_ns = std::numeric_limits<double>::infinity();
+    for (const TuningEntry& candidate : candidates) {
+      interpolate_tuned_into(a, b, out, 0.37f, candidate);  // warm-up
+      double fastest = std::numeric_limits<double>::infinity();
+      for (int r = 0; r < options.repeats; ++r) {
+        const auto start = Clock::now();
+        interpolate_tuned_into(a, b, out, 0.37f, candidate);
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        fastest = std::min(fastest, elapsed.count());
+      }
+      if (fastest < best_ns) {
+        best_ns = fastest;
+        best = candidate;
+      }
+    }
+    best.min_elems =
+        s == 0 ? 0
+               : static_cast<std::size_t>(std::sqrt(static_cast<double>(sizes[s - 1]) *
+                                                    static_cast<double>(n)));
+    config.entries.push_back(best);
+  }
+  return config;
+}
+
+}  // namespace minfi
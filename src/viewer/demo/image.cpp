@@ -1,4 +1,5 @@
 // Show an image with OpenCV + Viewer
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
@@ -8,6 +9,9 @@
 #include <vector>
 
 #include "../viewer.hpp"
+#include "minfi/frame_source.hpp"
+#include "minfi/opencv_source.hpp"
+#include "minfi/packed.hpp"
 
 namespace {
 
@@ -45,11 +49,60 @@ static std::string expandUserPath(std::string path) {
   return path;
 }
 
+// Plays every image in `dir` (sorted by name), inserting kSteps - 1 interpolated frames
+// between consecutive images. Decoding runs on a thread pool ahead of playback, so the render
+// loop only blends rows into the upload buffer.
+static int playSequence(const fs::path& dir, uint32_t W, uint32_t H) {
+  std::vector<std::string> paths;
+  for (const auto& entry : fs::directory_iterator(dir)) {
+    const auto ext = entry.path().extension().string();
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".PNG" || ext == ".JPG") {
+      paths.push_back(entry.path().string());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  if (paths.size() < 2) {
+    std::cerr << "Error: need at least two images in '" << dir.string() << "'.\n";
+    return 1;
+  }
+
+  Viewer viewer(W, H);
+  constexpr int kSteps = 4;
+  for (;;) {
+    minfi::ParallelFrameSource source(
+        paths.size(),
+        minfi::image_sequence_decoder(paths, {minfi::PixelFormat::Rgb8, W, H}));
+    auto prev = source.next();
+    while (auto cur = source.next()) {
+      for (int step = 0; step < kSteps; ++step) {
+        const float t = static_cast<float>(step) / kSteps;
+        viewer.renderRows([&](uint32_t y, std::uint8_t* rgba) {
+          minfi::interpolate_packed_rows(prev->view(), cur->view(),
+                                         {rgba, W, 1, minfi::PixelFormat::Rgba8}, t, y, 1);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+      }
+      prev = std::move(cur);
+    }
+    if (std::getenv("MINFI_VIEWER_VERBOSE")) {
+      const auto st = source.stats();
+      std::cout << "decoded " << st.decoded << " frames on " << source.thread_count()
+                << " threads, " << st.stalls << " stalls\n";
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   using std::cout;
   constexpr uint32_t W = 1024;
   constexpr uint32_t H = 1024;
 
+  if (argc > 1) {
+    std::error_code ec;
+    const fs::path dir = expandUserPath(argv[1]);
+    if (fs::is_directory(dir, ec)) return playSequence(dir, W, H);
+  }
+
   // Load source image with OpenCV
   cv::Mat bgr;
   std::string path;
@@ -99,6 +152,30 @@ int main(int argc, char** argv) {
     cout << "Start image demo via Viewer (" << path << ")\n";
   }
 
+  // Optional second image: cross-fade between the two. The fused packed kernel blends the RGB8
+  // sources and writes each RGBA8 row straight into the viewer's frame slot, so no float
+  // frames or full-size RGBA copies are created.
+  if (argc > 2) {
+    cv::Mat bgr2 = cv::imread(expandUserPath(argv[2]), cv::IMREAD_COLOR);
+    if (bgr2.empty()) {
+      std::cerr << "Error: failed to load image at '" << argv[2] << "'.\n";
+      return 1;
+    }
+    cv::Mat rgb2;
+    cv::cvtColor(bgr2, rgb2, cv::COLOR_BGR2RGB);
+    cv::resize(rgb2, rgb2, cv::Size(W, H), 0, 0, cv::INTER_LINEAR);
+    const minfi::PackedImageView a{rgb.data, W, H, minfi::PixelFormat::Rgb8, rgb.step[0]};
+    const minfi::PackedImageView b{rgb2.data, W, H, minfi::PixelFormat::Rgb8, rgb2.step[0]};
+    for (uint32_t frame = 0;; ++frame) {
+      const float phase = static_cast<float>(frame % 240) / 120.f;
+      const float t = phase <= 1.f ? phase : 2.f - phase;
+      viewer.renderRows([&](uint32_t y, std::uint8_t* rgba) {
+        minfi::interpolate_packed_rows(a, b, {rgba, W, 1, minfi::PixelFormat::Rgba8}, t, y, 1);
+      });
+      std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+  }
+
   // Convert once and keep presenting to pump events
   auto frame = matToNestedRGB(rgb);
   while (true) {
@@ -1,10 +1,12 @@
 // ---------- bindings ----------
-@group(0) @binding(0) var tex : texture_2d<f32>;
-@group(0) @binding(1) var texSampler : sampler;
+@group(0) @binding(0) var texImg : texture_2d<f32>;
+@group(0) @binding(1) var texSmp : sampler;
 
 // ---------- fragment ----------
+struct FSIn { @location(0) uv : vec2<f32>, };
+
 @fragment
-fn fs_main(@location(0) uv : vec2<f32>) -> @location(0) vec4<f32> {
+fn fs(in : FSIn) -> @location(0) vec4<f32> {
   // sRGBテクスチャを使う場合は書き込みターゲット側をsRGBにする（通常のWebGPU設定）
-  return textureSample(tex, texSampler, uv);
+  return textureSample(texImg, texSmp, in.uv);
 }
@@ -1,6 +1,7 @@
 #include "gpu_device.h"
 #include <webgpu/webgpu.h>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <vector>
 
@@ -25,6 +26,12 @@ static void onDevice(WGPURequestDeviceStatus status, WGPUDevice device, WGPUStri
   ctx->done = true;
 }
 
+using StartupClock = std::chrono::steady_clock;
+
+inline double msSince(StartupClock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(StartupClock::now() - t0).count();
+}
+
 inline WGPUInstance createInstance() {
   WGPUInstanceDescriptor desc{};
   return wgpuCreateInstance(&desc);
@@ -46,10 +53,13 @@ WgpuInitResult CreateWgpuDevice(std::optional<WGPUSurface> surfaceOpt, WGPUBacke
                                 bool highPerformance, const char* label) {
   WgpuInitResult out{};
 
+  auto t0 = StartupClock::now();
   out.instance = createInstance();
   assert(out.instance);
+  out.instanceMs = msSince(t0);
 
   // Adapter
+  t0 = StartupClock::now();
   CbCtx a{};
   WGPURequestAdapterOptions opt = makeAdapterOptions(surfaceOpt, backend, highPerformance);
   WGPURequestAdapterCallbackInfo acb{};
@@ -64,8 +74,10 @@ WgpuInitResult CreateWgpuDevice(std::optional<WGPUSurface> surfaceOpt, WGPUBacke
   }
   assert(a.adapter);
   out.adapter = a.adapter;
+  out.adapterMs = msSince(t0);
 
   // Device
+  t0 = StartupClock::now();
   CbCtx d{};
   WGPUDeviceDescriptor devDesc{};
   WGPUStringView labelStringView;
@@ -87,6 +99,7 @@ WgpuInitResult CreateWgpuDevice(std::optional<WGPUSurface> surfaceOpt, WGPUBacke
 
   out.queue = wgpuDeviceGetQueue(out.device);
   assert(out.queue);
+  out.deviceMs = msSince(t0);
 
   return out;
 }
@@ -9,6 +9,10 @@ struct WgpuInitResult {
   WGPUAdapter adapter{};
   WGPUDevice device{};
   WGPUQueue queue{};
+  // Wall time of each startup phase in milliseconds.
+  double instanceMs = 0;
+  double adapterMs = 0;
+  double deviceMs = 0;
 };
 
 // 省略可: 既に作った Surface と互換のアダプタを選びたい場合だけ渡す
@@ -2,19 +2,48 @@
 #include <GLFW/glfw3.h>
 #include <webgpu/webgpu.h>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "./gpu_device.cpp"
 #include "./surface.cpp"
 #include "./util.cpp"
 #include "gpu_device.h"
+#include "minfi/memory.hpp"
+#include "viewer.hpp"
+
+#if defined(MINFI_EMBED_SHADERS)
+#include "minfi_shaders.hpp"
+
+// createPipeline_ binds these entry points and bind-group slots; a shader edit that breaks the
+// contract fails the build instead of pipeline creation at startup.
+namespace shader_contract {
+constexpr bool declares(std::string_view src, std::initializer_list<std::string_view> needles) {
+  for (std::string_view n : needles) {
+    if (src.find(n) == std::string_view::npos) return false;
+  }
+  return true;
+}
+static_assert(declares(minfi_shaders::kTextureVert, {"@vertex", "fn vs(", "@binding(2)"}),
+              "vs.wgsl must declare @vertex fn vs and the contain uniform at binding 2");
+static_assert(declares(minfi_shaders::kTextureFrag,
+                       {"@fragment", "fn fs(", "@binding(0)", "@binding(1)"}),
+              "fs.wgsl must declare @fragment fn fs, the texture (0) and sampler (1)");
+}  // namespace shader_contract
+#endif
 
 class TextureRenderer {
  public:
@@ -27,6 +56,12 @@ class TextureRenderer {
         fsShaderPath_(fsShaderPath),
         texWidth_(textureWidth),
         texHeight_(textureHeight) {
+    using Clock = std::chrono::steady_clock;
+    const auto msSince = [](Clock::time_point t) {
+      return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+    };
+    const auto start = Clock::now();
+
     // まずデバイスを作成（内部で instance も生成）。
     auto init = CreateWgpuDevice({},
 #if defined(__APPLE__)
@@ -39,7 +74,9 @@ class TextureRenderer {
     );
     device_ = init.device;
     queue_ = wgpuDeviceGetQueue(device_);
-    surface_ = Surface{};
+    timings_.instanceMs = init.instanceMs;
+    timings_.adapterMs = init.adapterMs;
+    timings_.deviceMs = init.deviceMs;
 
     // 可能なら同一 instance からサーフェスを取得して画面表示を有効化
     instance_ = init.instance;
@@ -48,6 +85,7 @@ class TextureRenderer {
       height_ = texHeight_;
     }
 
+    auto t0 = Clock::now();
     surface_.ConfigureSurface(init.adapter, device_, instance_, width_, height_);
 
     // Provide a lightweight redraw path for OS-driven refresh (e.g., live-resize on macOS).
@@ -55,10 +93,20 @@ class TextureRenderer {
 
     // Decide color format now, before creating pipeline.
     targetFormat_ = surface_.surface ? WGPUTextureFormat_BGRA8Unorm : WGPUTextureFormat_RGBA8Unorm;
+    timings_.surfaceMs = msSince(t0);
 
-    createTextureResources_();
+    // Pipeline compilation is the slowest step; it runs asynchronously while the texture
+    // resources are created, and is only waited for when the bind group needs it.
+    const auto pipelineStart = Clock::now();
     createPipeline_();
+    t0 = Clock::now();
+    createTextureResources_();
+    timings_.resourcesMs = msSince(t0);
+    waitPipeline_();
+    timings_.pipelineMs = msSince(pipelineStart) - timings_.resourcesMs;
+    t0 = Clock::now();
     createBindGroup_();
+    timings_.resourcesMs += msSince(t0);
 
     if (surface_.surface) {
       WGPUSurfaceConfiguration cfg{};
@@ -71,8 +119,18 @@ class TextureRenderer {
     } else {
       createOffscreenTarget_();
     }
+    timings_.totalMs = msSince(start);
+    if (std::getenv("MINFI_VIEWER_VERBOSE") || std::getenv("MINFI_VIEWER_TIMINGS")) {
+      std::cout << "viewer startup: instance " << timings_.instanceMs << " ms, adapter "
+                << timings_.adapterMs << " ms, device " << timings_.deviceMs << " ms, surface "
+                << timings_.surfaceMs << " ms, resources " << timings_.resourcesMs
+                << " ms, pipeline " << timings_.pipelineMs << " ms, total " << timings_.totalMs
+                << " ms" << std::endl;
+    }
   }
 
+  const ViewerStartupTimings& StartupTimings() const { return timings_; }
+
   ~TextureRenderer() {
     if (bindGroup_) wgpuBindGroupRelease(bindGroup_);
     if (sampler_) wgpuSamplerRelease(sampler_);
@@ -97,39 +155,79 @@ class TextureRenderer {
     assert(data[0][0].size() == 3);  // RGB 前提
 
     upload_ = flattenAndPadAlpha(data);
+    {
+      std::lock_guard<std::mutex> lock(surface_.gpuMutex);
+      writeTextureRows_(0, texHeight_, upload_.data());
+      presentFrame_();
+    }
+    PollEvents();
+  }
+
+  // Streams the texture in bands of kUploadBandRows rows: fillRow(y, rgba) writes row y as
+  // texWidth x RGBA8 into the band buffer, which is uploaded and reused for the next band.
+  // Producers that compute rows on demand never need a full frame in host memory.
+  void UpdateTextureRows(const std::function<void(uint32_t y, uint8_t* rgba)>& fillRow) {
+    const size_t rowBytes = static_cast<size_t>(texWidth_) * 4;
+    upload_.resize(rowBytes * std::min(kUploadBandRows, texHeight_));
+    std::unique_lock<std::mutex> lock(surface_.gpuMutex);
+    for (uint32_t y0 = 0; y0 < texHeight_; y0 += kUploadBandRows) {
+      const uint32_t rows = std::min(kUploadBandRows, texHeight_ - y0);
+      for (uint32_t r = 0; r < rows; ++r) {
+        fillRow(y0 + r, upload_.data() + r * rowBytes);
+      }
+      // WriteTexture copies the data before returning, so the band buffer can be reused.
+      writeTextureRows_(y0, rows, upload_.data());
+    }
+    presentFrame_();
+    lock.unlock();
+    PollEvents();
+  }
+
+  // Uploads a full texWidth x texHeight RGBA8 frame and presents it. Safe to call from a
+  // presentation thread while the main thread keeps calling PollEvents().
+  void PresentFrame(const uint8_t* rgba) {
+    std::lock_guard<std::mutex> lock(surface_.gpuMutex);
+    writeTextureRows_(0, texHeight_, rgba);
+    presentFrame_();
+  }
+
+  // Dispatches window events (resize/refresh callbacks). Main thread only.
+  void PollEvents() { Surface::pollEvents(); }
+
+  uint32_t TextureWidth() const { return texWidth_; }
+  uint32_t TextureHeight() const { return texHeight_; }
+
+ private:
+  static constexpr uint32_t kUploadBandRows = 16;
 
-    // Queue.WriteTexture で GPU
-    // テクスチャへ転送（行ピッチは256バイトアラインが推奨だが、Dawnが内部で処理）
+  // Queue.WriteTexture で GPU
+  // テクスチャへ転送（行ピッチは256バイトアラインが推奨だが、Dawnが内部で処理）
+  void writeTextureRows_(uint32_t y0, uint32_t rows, const uint8_t* rgba) {
     WGPUTexelCopyTextureInfo dst{};
     dst.texture = texture_;
     dst.mipLevel = 0;
-    dst.origin = {0, 0, 0};
+    dst.origin = {0, y0, 0};
     dst.aspect = WGPUTextureAspect_All;
 
     WGPUTexelCopyBufferLayout layout{};
     layout.offset = 0;
     layout.bytesPerRow = texWidth_ * 4;
-    layout.rowsPerImage = texHeight_;
+    layout.rowsPerImage = rows;
 
-    WGPUExtent3D extent{texWidth_, texHeight_, 1};
+    WGPUExtent3D extent{texWidth_, rows, 1};
 
-    wgpuQueueWriteTexture(queue_, &dst, upload_.data(), upload_.size(), &layout, &extent);
+    wgpuQueueWriteTexture(queue_, &dst, rgba, static_cast<size_t>(texWidth_) * 4 * rows, &layout,
+                          &extent);
+  }
 
+  // Requires surface_.gpuMutex. May run off the main thread, so it takes the framebuffer size
+  // tracked by the window callbacks instead of querying GLFW.
+  void presentFrame_() {
     // 画面（サーフェス）へ描画する場合はここでテクスチャを取得して自前で View を作る。
     if (surface_.surface) {
-      // Keep swapchain sized to current framebuffer so we truly render full-window width.
-      int fbw = 0, fbh = 0;
-      glfwGetFramebufferSize(surface_.window, &fbw, &fbh);
-      if (fbw <= 0 || fbh <= 0) {
-        // Minimize doing work when minimized.
-        surface_.present(instance_);
-        return;
-      }
-      if (static_cast<uint32_t>(fbw) != width_ || static_cast<uint32_t>(fbh) != height_) {
-        width_ = static_cast<uint32_t>(fbw);
-        height_ = static_cast<uint32_t>(fbh);
-        surface_.Reconfigure(device_, width_, height_);
-      }
+      // The callbacks already reconfigured the swapchain to this size.
+      width_ = surface_.width;
+      height_ = surface_.height;
 
       // Update contain scale uniform from current window size
       updateContainUniform_();
@@ -166,7 +264,9 @@ class TextureRenderer {
     surface_.present(instance_);
   }
 
-  // Repaint using the existing texture/state. Used by window refresh/live-resize callbacks.
+ public:
+  // Repaint using the existing texture/state. Used by window refresh/live-resize callbacks, which
+  // hold surface_.gpuMutex.
   void Redraw() {
     if (!surface_.surface) return;
 
@@ -282,57 +382,23 @@ class TextureRenderer {
     sampler_ = wgpuDeviceCreateSampler(device_, &sampDesc);
   }
 
+  // Compiles the shader modules and requests the render pipeline asynchronously; waitPipeline_()
+  // collects it.
   void createPipeline_() {
-    // Provide WGSL sources either from embedded header or from assets/shaders on disk.
-    auto readTextFile = [](const std::filesystem::path& path) -> std::string {
-      std::ifstream ifs(path, std::ios::in | std::ios::binary);
-      if (!ifs) {
-        return {};
-      }
-      std::ostringstream oss;
-      oss << ifs.rdbuf();
-      return oss.str();
-    };
-
-    // Vertex shader: draw a centered quad scaled with object-fit: contain.
-    // Uniform carries NDC scale of the quad along X/Y.
-    std::string vsCode = R"WGSL(
-struct Uniforms { scale_ndc : vec2<f32>, _pad : vec2<f32> };
-@group(0) @binding(2) var<uniform> U : Uniforms;
-
-struct VSOut { @builtin(position) pos : vec4<f32>, @location(0) uv : vec2<f32>, };
-
-@vertex
-fn vs(@builtin(vertex_index) vid : u32) -> VSOut {
-  // Two-triangle quad covering [-1,1]^2 before scaling.
-  // Define POS with Y inverted so that mapping to UV via (POS*0.5+0.5)
-  // produces UV.y with top = 0, bottom = 1 without extra flipping.
-  var POS = array<vec2<f32>, 6>(
-    vec2<f32>(-1.0,  1.0), vec2<f32>( 1.0,  1.0), vec2<f32>( 1.0, -1.0),
-    vec2<f32>(-1.0,  1.0), vec2<f32>( 1.0, -1.0), vec2<f32>(-1.0, -1.0)
-  );
-  let p = POS[vid] * U.scale_ndc;              // scale to contained size
-  var o : VSOut;
-  o.pos = vec4<f32>(p, 0.0, 1.0);
-  // Map to UV 0..1, then flip Y to match texture row order
-  let uv_raw = (POS[vid] * 0.5) + vec2<f32>(0.5, 0.5);
-  o.uv = vec2<f32>(uv_raw.x, 1.0 - uv_raw.y);
-  return o;
-}
-)WGSL";
+#if defined(MINFI_EMBED_SHADERS)
+    const std::string_view vsCode = minfi_shaders::kTextureVert;
+    const std::string_view fsCode = minfi_shaders::kTextureFrag;
+#else
+    const std::string vsCode = readTextFile(vsShaderPath_);
+    const std::string fsCode = readTextFile(fsShaderPath_);
+    if (vsCode.empty() || fsCode.empty()) {
+      throw std::runtime_error("Viewer: cannot read shaders " + vsShaderPath_.string() + ", " +
+                               fsShaderPath_.string());
+    }
+#endif
+    // Vertex shader draws a centered quad scaled with object-fit: contain; the fragment shader
+    // samples the uploaded texture.
     vertexShaderModule_ = createShaderModuleFromWGSL(device_, vsCode);
-
-    // Force a fragment shader that samples the received texture.
-    // This replaces any debug/checker shader in assets.
-    std::string fsCode = R"WGSL(
-@group(0) @binding(0) var texImg : texture_2d<f32>;
-@group(0) @binding(1) var texSmp : sampler;
-struct FSIn { @location(0) uv : vec2<f32>, };
-@fragment
-fn fs(in : FSIn) -> @location(0) vec4<f32> {
-  return textureSample(texImg, texSmp, in.uv);
-}
-)WGSL";
     fragmentShaderModule_ = createShaderModuleFromWGSL(device_, fsCode);
 
     // BindGroupLayout: texture + sampler + uniforms
@@ -402,7 +468,34 @@ fn fs(in : FSIn) -> @location(0) vec4<f32> {
     pDesc.multisample.alphaToCoverageEnabled = false;
     pDesc.fragment = &frag;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device_, &pDesc);
+    WGPUCreateRenderPipelineAsyncCallbackInfo cb{};
+    cb.mode = WGPUCallbackMode_AllowProcessEvents;
+    cb.callback = [](WGPUCreatePipelineAsyncStatus status, WGPURenderPipeline pipeline,
+                     WGPUStringView message, void* userdata1, void* /*userdata2*/) {
+      auto* self = static_cast<TextureRenderer*>(userdata1);
+      if (status == WGPUCreatePipelineAsyncStatus_Success) {
+        self->pipeline_ = pipeline;
+      } else {
+        std::cerr << "Viewer: render pipeline creation failed: "
+                  << std::string_view(message.data, message.length == WGPU_STRLEN
+                                                        ? std::strlen(message.data)
+                                                        : message.length)
+                  << std::endl;
+      }
+      self->pipelinePending_ = false;
+    };
+    cb.userdata1 = this;
+    pipelinePending_ = true;
+    wgpuDeviceCreateRenderPipelineAsync(device_, &pDesc, cb);
+  }
+
+  void waitPipeline_() {
+    while (pipelinePending_) {
+      wgpuInstanceProcessEvents(instance_);
+    }
+    if (!pipeline_) {
+      throw std::runtime_error("Viewer: render pipeline creation failed");
+    }
   }
 
   void createBindGroup_() {
@@ -466,12 +559,15 @@ fn fs(in : FSIn) -> @location(0) vec4<f32> {
   WGPUBindGroupLayout bindGroupLayout_{};
   WGPUPipelineLayout pipelineLayout_{};
   WGPURenderPipeline pipeline_{};
+  bool pipelinePending_ = false;
   WGPUBindGroup bindGroup_{};
 
+  ViewerStartupTimings timings_{};
+
   // 一時アップロードバッファ（再利用）
-  std::vector<uint8_t> upload_;
+  minfi::Vector<uint8_t, minfi::Subsystem::Upload> upload_;
 
-  // シェーダーファイルのベースディレクトリ
+  // シェーダーファイル（MINFI_EMBED_SHADERS が無効な場合のみ読み込む）
   std::filesystem::path vsShaderPath_{};
   std::filesystem::path fsShaderPath_{};
 
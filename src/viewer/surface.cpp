@@ -4,6 +4,7 @@
 #include <functional>
 #include <cstdint>
 #include <iostream>
+#include <mutex>
 
 class Surface {
  public:
@@ -14,6 +15,9 @@ class Surface {
   std::uint32_t width{0}, height{0};
   // Optional callback invoked when the OS asks us to redraw (e.g., during live-resize on macOS).
   std::function<void()> on_refresh;
+  // Serializes device/surface use between the presentation thread and the window callbacks,
+  // which run on the main thread inside glfwPollEvents(). on_refresh is called with it held.
+  std::mutex gpuMutex;
 
   void ConfigureSurface(wgpu::Adapter adapter, wgpu::Device device, wgpu::Instance instance,
                         uint32_t width, uint32_t height) {
@@ -59,6 +63,7 @@ class Surface {
       if (!self) return;
       const std::uint32_t nw = static_cast<std::uint32_t>(std::max(1, w));
       const std::uint32_t nh = static_cast<std::uint32_t>(std::max(1, h));
+      std::lock_guard<std::mutex> lock(self->gpuMutex);
       if (nw == self->width && nh == self->height) return;
       self->width = nw;
       self->height = nh;
@@ -76,6 +81,7 @@ class Surface {
       glfwGetWindowContentScale(win, &sx, &sy);
       const std::uint32_t fbw = static_cast<std::uint32_t>(std::max(1, static_cast<int>(std::lround(w * sx))));
       const std::uint32_t fbh = static_cast<std::uint32_t>(std::max(1, static_cast<int>(std::lround(h * sy))));
+      std::lock_guard<std::mutex> lock(self->gpuMutex);
       if (fbw == self->width && fbh == self->height) return;
       self->width = fbw;
       self->height = fbh;
@@ -93,6 +99,7 @@ class Surface {
       glfwGetFramebufferSize(win, &fbw, &fbh);
       const std::uint32_t nw = static_cast<std::uint32_t>(std::max(1, fbw));
       const std::uint32_t nh = static_cast<std::uint32_t>(std::max(1, fbh));
+      std::lock_guard<std::mutex> lock(self->gpuMutex);
       if (nw != self->width || nh != self->height) {
         self->width = nw;
         self->height = nh;
@@ -123,13 +130,16 @@ class Surface {
     surface.Configure(&config);
   }
 
+  // Presents and pumps WebGPU callbacks. Window events are polled separately by pollEvents(),
+  // which must run on the main thread while this may run on the presentation thread.
   void present(wgpu::Instance instance) {
     if (std::getenv("MINFI_VIEWER_VERBOSE")) {
       std::cout << "Surface Present" << std::endl;
     }
 
-    glfwPollEvents();
     surface.Present();
     instance.ProcessEvents();
   }
+
+  static void pollEvents() { glfwPollEvents(); }
 };
@@ -6,8 +6,11 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "minfi/memory.hpp"
+
 inline std::string readTextFile(const std::filesystem::path& path) {
   std::ifstream ifs(path, std::ios::in | std::ios::binary);
   if (!ifs) {
@@ -18,12 +21,12 @@ inline std::string readTextFile(const std::filesystem::path& path) {
   return oss.str();
 }
 
-inline WGPUShaderModule createShaderModuleFromWGSL(WGPUDevice device, const std::string& code) {
+inline WGPUShaderModule createShaderModuleFromWGSL(WGPUDevice device, std::string_view code) {
   WGPUShaderSourceWGSL wgsl{};
   wgsl.chain.sType = WGPUSType_ShaderSourceWGSL;
   WGPUStringView sv{};
-  sv.data = code.c_str();
-  sv.length = WGPU_STRLEN;  // treat as null-terminated
+  sv.data = code.data();
+  sv.length = code.size();  // embedded sources are not null-terminated views
   wgsl.code = sv;
 
   WGPUShaderModuleDescriptor desc{};
@@ -32,9 +35,9 @@ inline WGPUShaderModule createShaderModuleFromWGSL(WGPUDevice device, const std:
   return wgpuDeviceCreateShaderModule(device, &desc);
 }
 
-std::vector<std::uint8_t> flattenAndPadAlpha(
-    std::vector<std::vector<std::vector<std::uint8_t>>> data) {
-  std::vector<std::uint8_t> dest;
+minfi::Vector<std::uint8_t, minfi::Subsystem::Upload> flattenAndPadAlpha(
+    const std::vector<std::vector<std::vector<std::uint8_t>>>& data) {
+  minfi::Vector<std::uint8_t, minfi::Subsystem::Upload> dest;
 
   uint kHeight = data.size();
   uint kWidth = data[0].size();
@@ -1,25 +1,47 @@
 #include <webgpu/webgpu.h>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <vector>
 
 #include "./renderer.cpp"  // Provides TextureRenderer class
+#include "minfi/present.hpp"
 #include "viewer.hpp"
 
 namespace {
+
+// Runs on the presentation thread: upload + encode + present, including any vsync wait.
+class RendererSink : public minfi::PresentSink {
+ public:
+  explicit RendererSink(TextureRenderer& renderer) : renderer_(renderer) {}
+  void present(std::span<const std::uint8_t> rgba) override {
+    renderer_.PresentFrame(rgba.data());
+  }
+
+ private:
+  TextureRenderer& renderer_;
+};
+
 struct Impl {
   explicit Impl(std::uint32_t tw, std::uint32_t th)
-      : renderer(std::filesystem::path("assets/shaders/texture_renderer.vert.wgsl"),
-                 std::filesystem::path("assets/shaders/texture_renderer.frag.wgsl"),
-                 tw, th) {}
+      : renderer(std::filesystem::path(MINFI_SHADER_DIR) / "vs.wgsl",
+                 std::filesystem::path(MINFI_SHADER_DIR) / "fs.wgsl", tw, th),
+        sink(renderer),
+        presenter(sink, static_cast<std::size_t>(tw) * th * 4) {}
+
   TextureRenderer renderer;
+  RendererSink sink;
+  // Declared last so the presentation thread stops before the renderer is destroyed.
+  minfi::Presenter presenter;
 };
 
-// Lazy singleton so existing call sites continue to work.
-Impl* g_impl = nullptr;
+// Lazy singleton so existing call sites continue to work. Destroyed at exit, which stops the
+// presentation thread before the renderer goes away.
+std::unique_ptr<Impl> g_impl;
 
 static Impl& ensureImpl(std::uint32_t tw, std::uint32_t th) {
-  if (!g_impl) g_impl = new Impl(tw, th);
+  if (!g_impl) g_impl = std::make_unique<Impl>(tw, th);
   return *g_impl;
 }
 
@@ -36,5 +58,43 @@ Viewer::Viewer(std::uint32_t textureWidth, std::uint32_t textureHeight) {
 }
 
 void Viewer::render(const std::vector<std::vector<std::vector<std::uint8_t>>>& data) {
-  getImpl().renderer.UpdateTexture(data);
+  Impl& impl = getImpl();
+  const std::uint32_t w = impl.renderer.TextureWidth();
+  const std::uint32_t h = impl.renderer.TextureHeight();
+  assert(data.size() == h && data[0].size() == w && data[0][0].size() == 3);
+  std::uint8_t* dst = impl.presenter.back().data();
+  for (std::uint32_t y = 0; y < h; ++y) {
+    for (std::uint32_t x = 0; x < w; ++x, dst += 4) {
+      dst[0] = data[y][x][0];
+      dst[1] = data[y][x][1];
+      dst[2] = data[y][x][2];
+      dst[3] = 255;
+    }
+  }
+  impl.presenter.publish();
+  impl.renderer.PollEvents();
+}
+
+void Viewer::renderRows(const std::function<void(std::uint32_t y, std::uint8_t* rgba)>& fillRow) {
+  Impl& impl = getImpl();
+  const std::size_t rowBytes = static_cast<std::size_t>(impl.renderer.TextureWidth()) * 4;
+  std::uint8_t* frame = impl.presenter.back().data();
+  for (std::uint32_t y = 0; y < impl.renderer.TextureHeight(); ++y) {
+    fillRow(y, frame + y * rowBytes);
+  }
+  impl.presenter.publish();
+  impl.renderer.PollEvents();
+}
+
+bool Viewer::flush(std::uint32_t timeoutMs) {
+  return getImpl().presenter.flush(std::chrono::milliseconds(timeoutMs));
+}
+
+const ViewerStartupTimings& Viewer::startupTimings() const {
+  return getImpl().renderer.StartupTimings();
+}
+
+ViewerPresentStats Viewer::presentStats() const {
+  const minfi::PresentStats st = getImpl().presenter.stats();
+  return {st.published, st.presented, st.dropped};
 }
@@ -1,14 +1,50 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <vector>
 
+// Wall time of each viewer startup phase in milliseconds. Printed at startup when
+// MINFI_VIEWER_VERBOSE or MINFI_VIEWER_TIMINGS is set.
+struct ViewerStartupTimings {
+  double instanceMs = 0;
+  double adapterMs = 0;
+  double deviceMs = 0;
+  double surfaceMs = 0;    // window + surface configuration
+  double resourcesMs = 0;  // texture, sampler, bind group
+  double pipelineMs = 0;   // shader modules + render pipeline (overlaps resources)
+  double totalMs = 0;
+};
+
+// Frame counters of the presentation thread.
+struct ViewerPresentStats {
+  std::uint64_t published = 0;  // frames handed over by render()/renderRows()
+  std::uint64_t presented = 0;  // frames uploaded and presented
+  std::uint64_t dropped = 0;    // frames replaced by a newer one before presentation
+};
+
 // Lightweight facade over TextureRenderer that hides all WebGPU details.
+//
+// Presentation runs on a thread owned by the viewer: render() and renderRows() write the frame
+// into a triple-buffered latest-frame slot and return without waiting for upload or vsync. If
+// they are called faster than the display refreshes, frames not yet picked up are dropped in
+// favour of the newest one. Call them from the main thread; they also dispatch window events.
 class Viewer {
  public:
-  // Uses default shaders from assets/shaders/.
+  // Uses the shaders embedded at build time (src/viewer/*.wgsl).
   Viewer();
   Viewer(std::uint32_t textureWidth, std::uint32_t textureHeight);
 
-  // Uploads an RGB image (H x W x 3) and triggers a render/present.
+  // Publishes an RGB image (H x W x 3) for presentation.
   void render(const std::vector<std::vector<std::vector<std::uint8_t>>>& data);
+
+  // Pull-based render: fillRow(y, rgba) is called once per texture row to write W x RGBA8
+  // pixels straight into the frame slot the presentation thread uploads from.
+  void renderRows(const std::function<void(std::uint32_t y, std::uint8_t* rgba)>& fillRow);
+
+  // Blocks until the newest frame has been presented (or timeoutMs elapsed); false on timeout.
+  bool flush(std::uint32_t timeoutMs = 1000);
+
+  const ViewerStartupTimings& startupTimings() const;
+  ViewerPresentStats presentStats() const;
 };
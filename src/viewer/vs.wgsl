@@ -1,30 +1,25 @@
 // ---------- bindings ----------
-@group(0) @binding(0) var tex : texture_2d<f32>;
-@group(0) @binding(1) var texSampler : sampler;
+// Uniform carries the NDC half-extent of the quad along X/Y (object-fit: contain).
+struct Uniforms { scale_ndc : vec2<f32>, _pad : vec2<f32> };
+@group(0) @binding(2) var<uniform> U : Uniforms;
 
 // ---------- vertex ----------
-struct VSOut {
-  @builtin(position) pos : vec4<f32>,
-  @location(0) uv : vec2<f32>,
-};
+struct VSOut { @builtin(position) pos : vec4<f32>, @location(0) uv : vec2<f32>, };
 
 @vertex
-fn vs_main(@builtin(vertex_index) vi : u32) -> VSOut {
-  // フルスクリーン三角形（NDC）
-  var positions = array<vec2<f32>, 3>(
-    vec2<f32>(-1.0, -3.0),
-    vec2<f32>(-1.0,  1.0),
-    vec2<f32>( 3.0,  1.0)
+fn vs(@builtin(vertex_index) vid : u32) -> VSOut {
+  // Two-triangle quad covering [-1,1]^2 before scaling.
+  // Define POS with Y inverted so that mapping to UV via (POS*0.5+0.5)
+  // produces UV.y with top = 0, bottom = 1 without extra flipping.
+  var POS = array<vec2<f32>, 6>(
+    vec2<f32>(-1.0,  1.0), vec2<f32>( 1.0,  1.0), vec2<f32>( 1.0, -1.0),
+    vec2<f32>(-1.0,  1.0), vec2<f32>( 1.0, -1.0), vec2<f32>(-1.0, -1.0)
   );
-  // 対応するUV（そのまま貼る）
-  var uvs = array<vec2<f32>, 3>(
-    vec2<f32>(0.0, 2.0),
-    vec2<f32>(0.0, 0.0),
-    vec2<f32>(2.0, 0.0)
-  );
-
+  let p = POS[vid] * U.scale_ndc;              // scale to contained size
   var o : VSOut;
-  o.pos = vec4<f32>(positions[vi], 0.0, 1.0);
-  o.uv  = uvs[vi];
+  o.pos = vec4<f32>(p, 0.0, 1.0);
+  // Map to UV 0..1, then flip Y to match texture row order
+  let uv_raw = (POS[vid] * 0.5) + vec2<f32>(0.5, 0.5);
+  o.uv = vec2<f32>(uv_raw.x, 1.0 - uv_raw.y);
   return o;
 }
@@ -0,0 +1,194 @@
+#include "minfi/yuv.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "minfi/kernels.hpp"
+
+namespace minfi {
+
+namespace {
+
+// One plane of a 4:2:0 frame: rows x cols samples of `channels` interleaved bytes.
+template <typename Byte>
+struct Plane {
+  Byte* data;
+  std::size_t cols;
+  std::size_t rows;
+  std::size_t channels;
+  std::size_t pitch;
+
+  Byte* row(std::size_t y) const { return data + y * pitch; }
+};
+
+template <typename Byte>
+std::size_t plane_count(const BasicYuvImage<Byte>& f) {
+  return f.layout == YuvLayout::NV12 ? 2 : 3;
+}
+
+template <typename Byte>
+Plane<Byte> plane(const BasicYuvImage<Byte>& f, std::size_t i) {
+  if (i == 0) return {f.y, f.width, f.height, 1, f.y_pitch()};
+  const std::size_t channels = f.layout == YuvLayout::NV12 ? 2 : 1;
+  return {i == 1 ? f.u : f.v, f.chroma_width(), f.chroma_height(), channels, f.uv_pitch()};
+}
+
+template <typename Byte>
+void check_frame(const BasicYuvImage<Byte>& f) {
+  const bool empty = f.width == 0 || f.height == 0;
+  if (!empty && (!f.y || !f.u || (f.layout == YuvLayout::I420 && !f.v))) {
+    throw std::invalid_argument("interpolate_yuv: missing plane");
+  }
+  if ((f.y_stride && f.y_stride < f.width) ||
+      (f.uv_stride && f.uv_stride < f.chroma_row_bytes())) {
+    throw std::invalid_argument("interpolate_yuv: stride is smaller than a row");
+  }
+}
+
+void check_frames(const YuvImageView& a, const YuvImageView& b, const MutableYuvImageView& out) {
+  check_frame(a);
+  check_frame(b);
+  check_frame(out);
+  if (a.width != b.width || a.height != b.height || a.layout != b.layout ||
+      out.width != a.width || out.height != a.height || out.layout != a.layout) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+}
+
+float sample(const Plane<const std::uint8_t>& p, float x, float y, std::size_t c) {
+  x = std::clamp(x, 0.f, static_cast<float>(p.cols - 1));
+  y = std::clamp(y, 0.f, static_cast<float>(p.rows - 1));
+  const auto x0 = static_cast<std::size_t>(x);
+  const auto y0 = static_cast<std::size_t>(y);
+  const std::size_t x1 = std::min(x0 + 1, p.cols - 1);
+  const std::size_t y1 = std::min(y0 + 1, p.rows - 1);
+  const float fx = x - static_cast<float>(x0);
+  const float fy = y - static_cast<float>(y0);
+  const std::uint8_t* r0 = p.row(y0);
+  const std::uint8_t* r1 = p.row(y1);
+  const std::size_t C = p.channels;
+  const float top = r0[x0 * C + c] * (1.f - fx) + r0[x1 * C + c] * fx;
+  const float bottom = r1[x0 * C + c] * (1.f - fx) + r1[x1 * C + c] * fx;
+  return top * (1.f - fy) + bottom * fy;
+}
+
+// `scale` converts plane coordinates to luma coordinates (1 for Y, 2 for chroma).
+void warp_plane(const Plane<const std::uint8_t>& a, const Plane<const std::uint8_t>& b,
+                const Plane<std::uint8_t>& out, const MotionFieldView& field, std::size_t scale,
+                const YuvImageView& luma, float u, MotionSampling sampling) {
+  const float inv_scale = 1.f / static_cast<float>(scale);
+  for (std::size_t y = 0; y < out.rows; ++y) {
+    std::uint8_t* dst = out.row(y);
+    const std::size_t ly = std::min(y * scale, luma.height - 1);
+    for (std::size_t x = 0; x < out.cols; ++x) {
+      float vx = 0.f;
+      float vy = 0.f;
+      sample_motion(field, std::min(x * scale, luma.width - 1), ly, sampling, vx, vy);
+      vx *= inv_scale;
+      vy *= inv_scale;
+      const float fx = static_cast<float>(x);
+      const float fy = static_cast<float>(y);
+      for (std::size_t c = 0; c < out.channels; ++c) {
+        const float va = sample(a, fx - u * vx, fy - u * vy, c);
+        const float vb = sample(b, fx + (1.f - u) * vx, fy + (1.f - u) * vy, c);
+        const float v = va * (1.f - u) + vb * u + 0.5f;
+        dst[x * out.channels + c] = static_cast<std::uint8_t>(std::clamp(v, 0.f, 255.f));
+      }
+    }
+  }
+}
+
+template <typename Byte>
+BasicYuvImage<Byte> make_view(YuvLayout layout, Byte* data, std::size_t width,
+                              std::size_t height) {
+  BasicYuvImage<Byte> f;
+  f.layout = layout;
+  f.width = width;
+  f.height = height;
+  f.y = data;
+  f.u = data + width * height;
+  f.v = layout == YuvLayout::I420 ? f.u + f.chroma_width() * f.chroma_height() : nullptr;
+  return f;
+}
+
+}  // namespace
+
+std::size_t yuv420_frame_bytes(std::size_t width, std::size_t height) {
+  return width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+}
+
+YuvImageView yuv420_view(YuvLayout layout, const std::uint8_t* data, std::size_t width,
+                         std::size_t height) {
+  return make_view(layout, data, width, height);
+}
+
+MutableYuvImageView yuv420_view(YuvLayout layout, std::uint8_t* data, std::size_t width,
+                                std::size_t height) {
+  return make_view(layout, data, width, height);
+}
+
+void interpolate_yuv_into(const YuvImageView& a, const YuvImageView& b,
+                          const MutableYuvImageView& out, float t) {
+  check_frames(a, b, out);
+  const float w = detail::clamp01(t);
+  for (std::size_t i = 0; i < plane_count(a); ++i) {
+    const auto pa = plane(a, i);
+    const auto pb = plane(b, i);
+    const auto po = plane(out, i);
+    const std::size_t n = pa.cols * pa.channels;
+    for (std::size_t y = 0; y < pa.rows; ++y) {
+      const std::uint8_t* ra = pa.row(y);
+      const std::uint8_t* rb = pb.row(y);
+      std::uint8_t* ro = po.row(y);
+      for (std::size_t x = 0; x < n; ++x) ro[x] = detail::blend(ra[x], rb[x], w);
+    }
+  }
+}
+
+std::vector<std::uint8_t> interpolate_yuv(YuvLayout layout, const std::vector<std::uint8_t>& a,
+                                          const std::vector<std::uint8_t>& b, std::size_t width,
+                                          std::size_t height, float t) {
+  const std::size_t bytes = yuv420_frame_bytes(width, height);
+  if (a.size() != bytes || b.size() != bytes) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  std::vector<std::uint8_t> out(bytes);
+  interpolate_yuv_into(yuv420_view(layout, a.data(), width, height),
+                       yuv420_view(layout, b.data(), width, height),
+                       yuv420_view(layout, out.data(), width, height), t);
+  return out;
+}
+
+MotionField estimate_motion_yuv(const YuvImageView& a, const YuvImageView& b,
+                                const MotionOptions& options) {
+  check_frame(a);
+  check_frame(b);
+  if (a.width != b.width || a.height != b.height) {
+    throw std::invalid_argument("interpolate: frame size mismatch");
+  }
+  const FrameShape shape{a.width, a.height, 1};
+  Vector<float, Subsystem::Scratch> la(shape.elems());
+  Vector<float, Subsystem::Scratch> lb(shape.elems());
+  for (std::size_t y = 0; y < a.height; ++y) {
+    std::copy_n(a.y + y * a.y_pitch(), a.width, la.begin() + y * a.width);
+    std::copy_n(b.y + y * b.y_pitch(), b.width, lb.begin() + y * b.width);
+  }
+  return estimate_motion(la, lb, shape, options);
+}
+
+void interpolate_yuv_motion_into(const YuvImageView& a, const YuvImageView& b,
+                                 const MutableYuvImageView& out, const MotionFieldView& field,
+                                 float t, MotionSampling sampling) {
+  check_frames(a, b, out);
+  if (field.block == 0 || field.cols * field.block < a.width ||
+      field.rows * field.block < a.height || !field.vectors) {
+    throw std::invalid_argument("interpolate_motion: motion field does not cover the frame");
+  }
+  if (a.width == 0 || a.height == 0) return;
+  const float u = detail::clamp01(t);
+  for (std::size_t i = 0; i < plane_count(a); ++i) {
+    warp_plane(plane(a, i), plane(b, i), plane(out, i), field, i == 0 ? 1 : 2, a, u, sampling);
+  }
+}
+
+}  // namespace minfi
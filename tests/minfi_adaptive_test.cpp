@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "minfi/adaptive.hpp"
+
+using minfi::AdaptiveInterpolator;
+using minfi::AdaptiveOptions;
+using minfi::FrameShape;
+using minfi::QualityTier;
+using Clock = AdaptiveInterpolator::Clock;
+
+namespace {
+minfi::Frame ramp(size_t n, float scale) {
+  minfi::Frame f(n);
+  for (size_t i = 0; i < n; ++i) f[i] = static_cast<float>(i % 97) * scale;
+  return f;
+}
+}  // namespace
+
+TEST(Adaptive, ClimbsToDenseWithAmpleTime) {
+  const FrameShape shape{32, 32, 1};
+  AdaptiveOptions opts;
+  opts.upgrade_after = 2;
+  AdaptiveInterpolator ai(shape, opts);
+  auto a = ramp(shape.elems(), 1.f), b = ramp(shape.elems(), 2.f);
+  minfi::Frame out(shape.elems());
+  const auto far = Clock::now() + std::chrono::hours(1);
+  for (int i = 0; i < 8; ++i) ai.interpolate_into({1, 2}, a, b, 0.25f * (i % 4), out, far);
+
+  const auto& s = ai.stats();
+  EXPECT_EQ(s.ceiling, QualityTier::Dense);
+  EXPECT_EQ(s.upgrades, 2u);
+  EXPECT_EQ(s.deadline_misses, 0u);
+  EXPECT_EQ(s.estimations, 1u);  // one field for the pair, reused for every t
+  EXPECT_GT(s.frames[0], 0u);
+  EXPECT_GT(s.frames[1], 0u);
+  EXPECT_GT(s.frames[2], 0u);
+  EXPECT_EQ(s.frames[0] + s.frames[1] + s.frames[2], 8u);
+  EXPECT_GT(s.tier_cost[2].count(), 0);
+}
+
+TEST(Adaptive, MissedDeadlineDowngrades) {
+  const FrameShape shape{16, 16, 3};
+  AdaptiveOptions opts;
+  opts.upgrade_after = 1;
+  AdaptiveInterpolator ai(shape, opts);
+  auto a = ramp(shape.elems(), 1.f), b = ramp(shape.elems(), 0.5f);
+  minfi::Frame out(shape.elems());
+  const auto far = Clock::now() + std::chrono::hours(1);
+  for (int i = 0; i < 4; ++i) ai.interpolate_into({7, 8}, a, b, 0.5f, out, far);
+  ASSERT_EQ(ai.stats().ceiling, QualityTier::Dense);
+
+  // A deadline that has already passed: the cheapest tier runs and the ceiling drops one step.
+  auto r = ai.interpolate_into({7, 8}, a, b, 0.5f, out, Clock::now() - std::chrono::seconds(1));
+  EXPECT_EQ(r.tier, QualityTier::Linear);
+  EXPECT_FALSE(r.met_deadline);
+  EXPECT_EQ(ai.stats().ceiling, QualityTier::Block);
+  EXPECT_EQ(ai.stats().downgrades, 1u);
+  EXPECT_EQ(ai.stats().deadline_misses, 1u);
+
+  // Linear output matches the plain blend.
+  EXPECT_EQ(out, minfi::interpolate(a, b, 0.5f));
+}
+
+TEST(Adaptive, ChoiceFollowsCostModel) {
+  const FrameShape shape{64, 64, 1};
+  AdaptiveOptions opts;
+  opts.upgrade_after = 1;
+  AdaptiveInterpolator ai(shape, opts);
+  auto a = ramp(shape.elems(), 1.f), b = ramp(shape.elems(), 3.f);
+  minfi::Frame out(shape.elems());
+  const auto far = Clock::now() + std::chrono::hours(1);
+  for (int i = 0; i < 4; ++i) ai.interpolate_into({1, 2}, a, b, 0.5f, out, far);
+  ASSERT_EQ(ai.stats().ceiling, QualityTier::Dense);
+
+  EXPECT_EQ(ai.choose({1, 2}, std::chrono::hours(1)), QualityTier::Dense);
+  EXPECT_EQ(ai.choose({1, 2}, Clock::duration(1)), QualityTier::Linear);
+  // A new pair must also pay for estimation.
+  const auto warp_only = ai.stats().tier_cost[2] + ai.stats().tier_cost[2] / 4;
+  if (ai.stats().estimate_cost > warp_only) {
+    EXPECT_NE(ai.choose({3, 4}, warp_only), QualityTier::Dense);
+  }
+  ai.reset_model();
+  EXPECT_EQ(ai.stats().ceiling, QualityTier::Linear);
+}
+
+TEST(Adaptive, RejectsBadInput) {
+  EXPECT_THROW(AdaptiveInterpolator(FrameShape{0, 4, 1}), std::invalid_argument);
+  AdaptiveOptions bad;
+  bad.headroom = 0.0;
+  EXPECT_THROW(AdaptiveInterpolator(FrameShape{4, 4, 1}, bad), std::invalid_argument);
+  AdaptiveInterpolator ai(FrameShape{4, 4, 1});
+  minfi::Frame a(16), out(15);
+  EXPECT_THROW(ai.interpolate_into({}, a, a, 0.5f, out, Clock::now()), std::invalid_argument);
+}
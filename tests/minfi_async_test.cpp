@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+
+#include "minfi/async.hpp"
+
+using minfi::Frame;
+
+namespace {
+
+// Minimal eager coroutine that reports its result through a std::promise.
+struct Task {
+  struct promise_type {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Task await_once(Frame a, Frame b, std::promise<Frame>& done) {
+  Frame out = co_await minfi::interpolate_awaitable(std::move(a), std::move(b), 0.5f);
+  done.set_value(std::move(out));
+}
+
+}  // namespace
+
+TEST(Async, FutureResultAndCallback) {
+  minfi::Executor executor(2);
+  bool called = false;
+  minfi::AsyncOptions opts;
+  opts.executor = &executor;
+  opts.on_complete = [&](const Frame* out, std::exception_ptr err) {
+    called = out != nullptr && !err && (*out)[0] == 1.f;
+  };
+  auto fut = minfi::interpolate_async(Frame{0.f, 2.f}, Frame{2.f, 0.f}, 0.5f, opts);
+  Frame out = fut.get();
+  EXPECT_FLOAT_EQ(out[0], 1.f);
+  EXPECT_FLOAT_EQ(out[1], 1.f);
+  EXPECT_TRUE(called);
+}
+
+TEST(Async, ThrowingCallbackRunsOnceAndKeepsTheResult) {
+  minfi::Executor executor(1);
+  int calls = 0;
+  minfi::AsyncOptions opts;
+  opts.executor = &executor;
+  opts.on_complete = [&](const Frame*, std::exception_ptr) {
+    ++calls;
+    throw std::runtime_error("callback");
+  };
+  auto fut = minfi::interpolate_async(Frame{0.f}, Frame{2.f}, 0.5f, opts);
+  EXPECT_FLOAT_EQ(fut.get()[0], 1.f);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Async, ExecutorSurvivesThrowingTasksAndDrainsFollowUps) {
+  std::atomic<int> ran{0};
+  {
+    minfi::Executor executor(2);
+    executor.submit([] { throw std::runtime_error("task"); });
+    executor.submit([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      executor.submit([&] { ++ran; });  // may land after shutdown began
+      ++ran;
+    });
+  }
+  EXPECT_EQ(ran, 2);
+}
+
+TEST(Async, ErrorsPropagate) {
+  auto fut = minfi::interpolate_async(Frame{0.f}, Frame{0.f, 1.f}, 0.5f);
+  EXPECT_THROW(fut.get(), std::invalid_argument);
+}
+
+TEST(Async, Cancellation) {
+  minfi::Executor executor(1);
+  std::promise<void> gate;
+  auto opened = gate.get_future().share();
+  executor.submit([opened] { opened.wait(); });  // hold the only worker
+
+  std::stop_source stop;
+  minfi::AsyncOptions opts;
+  opts.executor = &executor;
+  opts.stop = stop.get_token();
+  std::exception_ptr seen;
+  opts.on_complete = [&](const Frame*, std::exception_ptr err) { seen = err; };
+  auto fut = minfi::interpolate_async(Frame(1000, 0.f), Frame(1000, 1.f), 0.5f, opts);
+  stop.request_stop();
+  gate.set_value();
+  EXPECT_THROW(fut.get(), minfi::Cancelled);
+  EXPECT_TRUE(seen != nullptr);
+}
+
+TEST(Async, Awaitable) {
+  std::promise<Frame> done;
+  auto fut = done.get_future();
+  await_once(Frame{0.f, 4.f}, Frame{4.f, 0.f}, done);
+  Frame out = fut.get();
+  EXPECT_FLOAT_EQ(out[0], 2.f);
+  EXPECT_FLOAT_EQ(out[1], 2.f);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "minfi/batch.hpp"
+#include "minfi/tuning.hpp"
+
+using minfi::FrameBatch;
+using minfi::FrameShape;
+
+namespace {
+
+FrameBatch filled(FrameShape shape, std::size_t frames, float scale) {
+  FrameBatch batch(shape, frames);
+  for (std::size_t i = 0; i < batch.data().size(); ++i) {
+    batch.data()[i] = static_cast<float>((i * 13) % 97) * scale;
+  }
+  return batch;
+}
+
+}  // namespace
+
+TEST(FrameBatch, PushBackAndGather) {
+  FrameBatch batch({2, 2, 1});
+  EXPECT_TRUE(batch.empty());
+  const std::vector<float> f0{1, 2, 3, 4}, f1{5, 6, 7, 8};
+  EXPECT_EQ(batch.push_back(f0), 0u);
+  EXPECT_EQ(batch.push_back(f1), 1u);
+  EXPECT_EQ(batch.size(), 2u);
+  EXPECT_EQ(batch.data().size(), 8u);
+  EXPECT_EQ(batch.data()[4], 5.0f);  // frames are contiguous
+
+  const minfi::Frame g = batch.gather(1);
+  EXPECT_TRUE(std::equal(g.begin(), g.end(), f1.begin(), f1.end()));
+  const auto all = batch.gather_all();
+  ASSERT_EQ(all.size(), 2u);
+  EXPECT_TRUE(std::equal(all[0].begin(), all[0].end(), f0.begin(), f0.end()));
+
+  EXPECT_THROW(batch.push_back(std::vector<float>(3)), std::invalid_argument);
+  EXPECT_THROW(batch.gather(2), std::out_of_range);
+  std::vector<float> small(2);
+  EXPECT_THROW(batch.gather_into(0, small), std::invalid_argument);
+  EXPECT_THROW(FrameBatch({0, 4, 1}), std::invalid_argument);
+}
+
+TEST(FrameBatch, PerFrameTMatchesPerFrameInterpolate) {
+  const FrameShape shape{8, 8, 3};
+  const FrameBatch a = filled(shape, 37, 0.01f);
+  const FrameBatch b = filled(shape, 37, -0.03f);
+  std::vector<float> t(a.size());
+  for (std::size_t i = 0; i < t.size(); ++i) t[i] = static_cast<float>(i) / 30.0f - 0.1f;
+
+  const FrameBatch out = minfi::interpolate_batch(a, b, t);
+  ASSERT_EQ(out.size(), a.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const minfi::Frame expected = minfi::interpolate(a.gather(i), b.gather(i), t[i]);
+    const minfi::Frame got = out.gather(i);
+    ASSERT_TRUE(std::equal(got.begin(), got.end(), expected.begin(), expected.end())) << i;
+  }
+}
+
+TEST(FrameBatch, ParallelSweepMatchesSerial) {
+  const FrameShape shape{16, 16, 1};
+  const FrameBatch a = filled(shape, 101, 0.5f);
+  const FrameBatch b = filled(shape, 101, 0.25f);
+  const FrameBatch serial = minfi::interpolate_batch(a, b, 0.4f);
+
+  const auto previous = minfi::active_tuning();
+  for (const std::size_t tile : {std::size_t{0}, std::size_t{1000}}) {
+    minfi::TuningConfig config;
+    config.entries = {{0, tile, 4, minfi::KernelVariant::Streaming}};
+    minfi::set_active_tuning(config);
+    const FrameBatch parallel = minfi::interpolate_batch(a, b, 0.4f);
+    EXPECT_TRUE(std::equal(parallel.data().begin(), parallel.data().end(),
+                           serial.data().begin(), serial.data().end()))
+        << "tile=" << tile;
+  }
+  minfi::set_active_tuning(*previous);
+}
+
+TEST(FrameBatch, InPlaceAndMismatches) {
+  FrameBatch a = filled({4, 4, 1}, 5, 1.0f);
+  const FrameBatch b = filled({4, 4, 1}, 5, 2.0f);
+  const std::vector<float> ones(5, 1.0f);
+  minfi::interpolate_batch_into(a, b, ones, a);
+  EXPECT_TRUE(std::equal(a.data().begin(), a.data().end(), b.data().begin(), b.data().end()));
+
+  const FrameBatch other_shape = filled({2, 8, 1}, 5, 1.0f);
+  EXPECT_THROW(minfi::interpolate_batch(a, other_shape, 0.5f), std::invalid_argument);
+  const FrameBatch fewer = filled({4, 4, 1}, 4, 1.0f);
+  EXPECT_THROW(minfi::interpolate_batch(a, fewer, 0.5f), std::invalid_argument);
+  const std::vector<float> short_t(4, 0.5f);
+  EXPECT_THROW(minfi::interpolate_batch(a, b, short_t), std::invalid_argument);
+}
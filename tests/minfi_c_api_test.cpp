@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "minfi/cubic.hpp"
+#include "minfi/kernels.hpp"
+#include "minfi/minfi.h"
+#include "minfi/motion.hpp"
+
+namespace {
+
+minfi_image image(void* data, uint32_t w, uint32_t h, uint32_t c, minfi_element e,
+                  size_t stride = 0) {
+  return minfi_image{data, w, h, c, e, stride};
+}
+
+std::vector<float> ramp(std::size_t n, float start, float step) {
+  std::vector<float> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = start + step * static_cast<float>(i);
+  return v;
+}
+
+}  // namespace
+
+TEST(CApi, VersionAndStatusStrings) {
+  EXPECT_EQ(minfi_abi_version(), static_cast<uint32_t>(MINFI_ABI_VERSION));
+  EXPECT_STREQ(minfi_status_string(MINFI_OK), "ok");
+  EXPECT_STREQ(minfi_status_string(MINFI_ERROR_INVALID_ARGUMENT), "invalid argument");
+}
+
+TEST(CApi, InterpolatesPackedF32LikeTheKernel) {
+  auto a = ramp(4 * 3 * 3, 0.0f, 1.0f);
+  auto b = ramp(a.size(), 10.0f, -0.5f);
+  std::vector<float> out(a.size());
+  const auto ia = image(a.data(), 4, 3, 3, MINFI_ELEMENT_F32);
+  const auto ib = image(b.data(), 4, 3, 3, MINFI_ELEMENT_F32);
+  const auto io = image(out.data(), 4, 3, 3, MINFI_ELEMENT_F32);
+  ASSERT_EQ(minfi_interpolate(&ia, &ib, &io, 0.25f, nullptr), MINFI_OK);
+
+  std::vector<float> expected(a.size());
+  minfi::interpolate_into<float>(a, b, expected, 0.25f);
+  EXPECT_EQ(out, expected);
+}
+
+TEST(CApi, HonoursRowStrideAndLeavesPaddingAlone) {
+  // 3 x 2 single-channel u8 image inside rows of 8 bytes.
+  std::vector<uint8_t> a(16, 0), b(16, 0), out(16, 0xEE);
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 3; ++x) {
+      a[y * 8 + x] = 0;
+      b[y * 8 + x] = 255;
+    }
+  }
+  const auto ia = image(a.data(), 3, 2, 1, MINFI_ELEMENT_U8, 8);
+  const auto ib = image(b.data(), 3, 2, 1, MINFI_ELEMENT_U8, 8);
+  const auto io = image(out.data(), 3, 2, 1, MINFI_ELEMENT_U8, 8);
+  ASSERT_EQ(minfi_interpolate(&ia, &ib, &io, 0.5f, nullptr), MINFI_OK);
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 8; ++x) {
+      EXPECT_EQ(out[y * 8 + x], x < 3 ? 128 : 0xEE) << "y=" << y << " x=" << x;
+    }
+  }
+}
+
+TEST(CApi, InPlaceU16) {
+  std::vector<uint16_t> a{0, 1000, 60000, 65535};
+  const std::vector<uint16_t> b{65535, 3000, 0, 65535};
+  auto ia = image(a.data(), 2, 2, 1, MINFI_ELEMENT_U16);
+  const auto ib = image(const_cast<uint16_t*>(b.data()), 2, 2, 1, MINFI_ELEMENT_U16);
+  ASSERT_EQ(minfi_interpolate(&ia, &ib, &ia, 1.0f, nullptr), MINFI_OK);
+  EXPECT_EQ(a, b);
+}
+
+TEST(CApi, NanTIsAnInvalidArgument) {
+  std::vector<uint8_t> a{0, 10}, b{20, 30}, out{7, 7};
+  const auto ia = image(a.data(), 2, 1, 1, MINFI_ELEMENT_U8);
+  const auto ib = image(b.data(), 2, 1, 1, MINFI_ELEMENT_U8);
+  const auto io = image(out.data(), 2, 1, 1, MINFI_ELEMENT_U8);
+  EXPECT_EQ(minfi_interpolate(&ia, &ib, &io, std::nanf(""), nullptr),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_EQ(out, (std::vector<uint8_t>{7, 7}));
+}
+
+TEST(CApi, PoolMatchesSerialResult) {
+  minfi_pool* pool = minfi_pool_create(4);
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(minfi_pool_thread_count(pool), 4u);
+
+  const uint32_t w = 37, h = 53, c = 3;
+  auto a = ramp(std::size_t{w} * h * c, -3.0f, 0.01f);
+  auto b = ramp(a.size(), 7.0f, -0.02f);
+  std::vector<float> serial(a.size()), parallel(a.size());
+  const auto ia = image(a.data(), w, h, c, MINFI_ELEMENT_F32);
+  const auto ib = image(b.data(), w, h, c, MINFI_ELEMENT_F32);
+  const auto is = image(serial.data(), w, h, c, MINFI_ELEMENT_F32);
+  const auto ip = image(parallel.data(), w, h, c, MINFI_ELEMENT_F32);
+  ASSERT_EQ(minfi_interpolate(&ia, &ib, &is, 0.3f, nullptr), MINFI_OK);
+  ASSERT_EQ(minfi_interpolate(&ia, &ib, &ip, 0.3f, pool), MINFI_OK);
+  EXPECT_EQ(serial, parallel);
+  minfi_pool_destroy(pool);
+  minfi_pool_destroy(nullptr);
+}
+
+TEST(CApi, ReportsInvalidArgumentsWithoutThrowing) {
+  std::vector<float> a(12), b(8), out(12);
+  const auto ia = image(a.data(), 4, 3, 1, MINFI_ELEMENT_F32);
+  const auto ib = image(b.data(), 4, 2, 1, MINFI_ELEMENT_F32);
+  const auto io = image(out.data(), 4, 3, 1, MINFI_ELEMENT_F32);
+  EXPECT_EQ(minfi_interpolate(&ia, &ib, &io, 0.5f, nullptr), MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_NE(std::string(minfi_last_error()).find("size mismatch"), std::string::npos);
+
+  EXPECT_EQ(minfi_interpolate(nullptr, &ia, &io, 0.5f, nullptr), MINFI_ERROR_INVALID_ARGUMENT);
+
+  const auto short_stride = image(a.data(), 4, 3, 1, MINFI_ELEMENT_F32, 8);
+  EXPECT_EQ(minfi_interpolate(&short_stride, &ia, &io, 0.5f, nullptr),
+            MINFI_ERROR_INVALID_ARGUMENT);
+
+  std::vector<uint8_t> bytes(12);
+  const auto iu = image(bytes.data(), 4, 3, 1, MINFI_ELEMENT_U8);
+  EXPECT_EQ(minfi_interpolate(&ia, &iu, &io, 0.5f, nullptr), MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_NE(std::string(minfi_last_error()).find("element type"), std::string::npos);
+}
+
+TEST(CApi, CubicMatchesKernel) {
+  const std::size_t n = 5 * 4;
+  auto p0 = ramp(n, 0.0f, 1.0f), p1 = ramp(n, 1.0f, 2.0f), p2 = ramp(n, 3.0f, 1.5f),
+       p3 = ramp(n, 2.0f, 0.5f);
+  std::vector<float> out(n), expected(n);
+  const auto i0 = image(p0.data(), 5, 4, 1, MINFI_ELEMENT_F32);
+  const auto i1 = image(p1.data(), 5, 4, 1, MINFI_ELEMENT_F32);
+  const auto i2 = image(p2.data(), 5, 4, 1, MINFI_ELEMENT_F32);
+  const auto i3 = image(p3.data(), 5, 4, 1, MINFI_ELEMENT_F32);
+  const auto io = image(out.data(), 5, 4, 1, MINFI_ELEMENT_F32);
+  ASSERT_EQ(minfi_interpolate_cubic(&i0, &i1, &i2, &i3, &io, 0.4f, nullptr), MINFI_OK);
+  minfi::interpolate_cubic_into(p0, p1, p2, p3, expected, 0.4f);
+  EXPECT_EQ(out, expected);
+
+  std::vector<uint8_t> u(n);
+  const auto iu = image(u.data(), 5, 4, 1, MINFI_ELEMENT_U8);
+  EXPECT_EQ(minfi_interpolate_cubic(&iu, &iu, &iu, &iu, &iu, 0.4f, nullptr),
+            MINFI_ERROR_INVALID_ARGUMENT);
+}
+
+TEST(CApi, MotionInterpolationMatchesCoreAndReusesTheField) {
+  // A bright square moving 4 pixels to the right.
+  const std::size_t w = 32, h = 32;
+  std::vector<float> a(w * h, 0.0f), b(w * h, 0.0f);
+  for (std::size_t y = 8; y < 16; ++y) {
+    for (std::size_t x = 8; x < 16; ++x) {
+      a[y * w + x] = 1.0f;
+      b[y * w + x + 4] = 1.0f;
+    }
+  }
+  const minfi_motion_options options{8, 6, 0};
+  minfi_motion* motion = minfi_motion_create(&options);
+  ASSERT_NE(motion, nullptr);
+
+  std::vector<float> out(w * h), again(w * h);
+  const auto ia = image(a.data(), w, h, 1, MINFI_ELEMENT_F32);
+  const auto ib = image(b.data(), w, h, 1, MINFI_ELEMENT_F32);
+  const auto io = image(out.data(), w, h, 1, MINFI_ELEMENT_F32);
+  const auto ig = image(again.data(), w, h, 1, MINFI_ELEMENT_F32);
+  ASSERT_EQ(minfi_motion_interpolate(motion, &ia, 1, &ib, 2, &io, 0.5f, MINFI_MOTION_BLOCK),
+            MINFI_OK);
+  ASSERT_EQ(minfi_motion_interpolate(motion, &ia, 1, &ib, 2, &ig, 0.5f, MINFI_MOTION_BLOCK),
+            MINFI_OK);
+  EXPECT_EQ(out, again);
+
+  const minfi::FrameShape shape{w, h, 1};
+  minfi::MotionOptions mo;
+  mo.block = 8;
+  mo.search = 6;
+  const auto field = minfi::estimate_motion(a, b, shape, mo);
+  std::vector<float> expected(w * h);
+  minfi::interpolate_motion_into(a, b, shape, field.view(), 0.5f, expected);
+  EXPECT_EQ(out, expected);
+
+  // Strided images are rejected: motion estimation needs packed rows.
+  const auto strided = image(a.data(), w / 2, h, 1, MINFI_ELEMENT_F32, w * sizeof(float));
+  EXPECT_EQ(minfi_motion_interpolate(motion, &strided, 0, &strided, 0, &strided, 0.5f,
+                                     MINFI_MOTION_SMOOTH),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_EQ(minfi_motion_interpolate(nullptr, &ia, 1, &ib, 2, &io, 0.5f, MINFI_MOTION_BLOCK),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  minfi_motion_destroy(motion);
+}
+
+TEST(CApi, MotionRejectsInPlaceOutput) {
+  const std::size_t w = 16, h = 16;
+  auto a = ramp(w * h, 0.0f, 0.01f);
+  auto b = ramp(w * h, 1.0f, -0.01f);
+  const auto before = a;
+  minfi_motion* motion = minfi_motion_create(nullptr);
+  ASSERT_NE(motion, nullptr);
+  const auto ia = image(a.data(), w, h, 1, MINFI_ELEMENT_F32);
+  const auto ib = image(b.data(), w, h, 1, MINFI_ELEMENT_F32);
+  EXPECT_EQ(minfi_motion_interpolate(motion, &ia, 1, &ib, 2, &ia, 0.5f, MINFI_MOTION_SMOOTH),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_EQ(minfi_motion_interpolate(motion, &ia, 1, &ib, 2, &ib, 0.5f, MINFI_MOTION_BLOCK),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  EXPECT_NE(std::string(minfi_last_error()).find("alias"), std::string::npos);
+  EXPECT_EQ(a, before);
+  // Overlapping rather than identical buffers are rejected too.
+  const auto shifted = image(a.data() + w, w, h - 1, 1, MINFI_ELEMENT_F32);
+  const auto head = image(b.data(), w, h - 1, 1, MINFI_ELEMENT_F32);
+  const auto tail = image(a.data(), w, h - 1, 1, MINFI_ELEMENT_F32);
+  EXPECT_EQ(minfi_motion_interpolate(motion, &tail, 0, &head, 0, &shifted, 0.5f,
+                                     MINFI_MOTION_BLOCK),
+            MINFI_ERROR_INVALID_ARGUMENT);
+  minfi_motion_destroy(motion);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "minfi/cubic.hpp"
+
+using minfi::CubicInterpolator;
+using minfi::Frame;
+
+TEST(Cubic, WeightsReproduceEndpoints) {
+  const auto w0 = minfi::catmull_rom_weights(0.0f);
+  const auto w1 = minfi::catmull_rom_weights(1.0f);
+  EXPECT_FLOAT_EQ(w0.w1, 1.f);
+  EXPECT_FLOAT_EQ(w1.w2, 1.f);
+  const auto w = minfi::catmull_rom_weights(0.3f);
+  EXPECT_FLOAT_EQ(w.w0 + w.w1 + w.w2 + w.w3, 1.f);
+}
+
+TEST(Cubic, LinearMotionIsExact) {
+  // Samples on a straight line in time are reproduced exactly by Catmull-Rom.
+  Frame p0{0.f, 10.f}, p1{1.f, 8.f}, p2{2.f, 6.f}, p3{3.f, 4.f};
+  Frame m = minfi::interpolate_cubic(p0, p1, p2, p3, 0.25f);
+  EXPECT_FLOAT_EQ(m[0], 1.25f);
+  EXPECT_FLOAT_EQ(m[1], 7.5f);
+}
+
+TEST(Cubic, SlidingWindowRecyclesBuffers) {
+  CubicInterpolator ci;
+  for (float v : {0.f, 1.f, 2.f}) ci.push(Frame{v});
+  EXPECT_FALSE(ci.ready());
+  EXPECT_THROW(ci.interpolate(0.5f), std::logic_error);
+  ci.push(Frame{3.f});
+  ASSERT_TRUE(ci.ready());
+  EXPECT_FLOAT_EQ(ci.interpolate(0.5f)[0], 1.5f);
+
+  Frame next{4.f};
+  const float* evicted = ci.frame(-1).data();
+  ci.push(std::move(next));
+  EXPECT_EQ(next.data(), evicted);  // caller gets the old n-1 buffer back
+  EXPECT_FLOAT_EQ(ci.frame(-1)[0], 1.f);
+  EXPECT_FLOAT_EQ(ci.frame(2)[0], 4.f);
+  EXPECT_FLOAT_EQ(ci.interpolate(0.5f)[0], 2.5f);
+
+  Frame& slot = ci.next_slot(1);
+  slot[0] = 5.f;
+  ci.commit();
+  EXPECT_FLOAT_EQ(ci.frame(0)[0], 3.f);
+}
+
+TEST(Cubic, MismatchThrows) {
+  Frame a{0.f}, b{0.f, 1.f};
+  EXPECT_THROW(minfi::interpolate_cubic(a, a, b, a, 0.5f), std::invalid_argument);
+}
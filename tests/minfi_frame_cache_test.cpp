@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "minfi/frame_cache.hpp"
+
+using minfi::FrameCache;
+using minfi::FramePairKey;
+using minfi::OutputMethod;
+
+namespace {
+
+// Smooth gradient: compresses well once split into byte planes.
+std::vector<float> gradient(std::size_t n, float base) {
+  std::vector<float> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = base + static_cast<float>(i / 64) * 0.25f;
+  return v;
+}
+
+FrameCache::Options options(std::size_t budget, bool compress = false) {
+  FrameCache::Options o;
+  o.byte_budget = budget;
+  o.compress_cold = compress;
+  return o;
+}
+
+}  // namespace
+
+TEST(FrameCache, KeysQuantizeTAndSeparateMethods) {
+  FrameCache::Options o;
+  o.t_steps = 100;
+  FrameCache cache(o);
+  const FramePairKey pair{1, 2};
+  EXPECT_EQ(cache.key(pair, 0.5f, OutputMethod::Linear),
+            cache.key(pair, 0.501f, OutputMethod::Linear));
+  EXPECT_NE(cache.key(pair, 0.5f, OutputMethod::Linear),
+            cache.key(pair, 0.52f, OutputMethod::Linear));
+  EXPECT_NE(cache.key(pair, 0.5f, OutputMethod::Linear),
+            cache.key(pair, 0.5f, OutputMethod::Motion));
+  EXPECT_EQ(cache.key(pair, 2.0f, OutputMethod::Linear).t, 100u);
+  EXPECT_THROW(cache.key(pair, std::nanf(""), OutputMethod::Linear), std::invalid_argument);
+  EXPECT_THROW(FrameCache(FrameCache::Options{1024, 0, false}), std::invalid_argument);
+}
+
+TEST(FrameCache, HitSkipsComputeAndCopiesTheFrame) {
+  FrameCache cache;
+  const auto key = cache.key({7, 8}, 0.25f, OutputMethod::Cubic);
+  std::vector<float> out(256);
+  int computed = 0;
+  const auto compute = [&](std::span<float> dst) {
+    ++computed;
+    for (std::size_t i = 0; i < dst.size(); ++i) dst[i] = static_cast<float>(i) * 0.5f;
+  };
+  EXPECT_FALSE(cache.get_or_compute(key, out, compute));
+  std::vector<float> again(256, -1.0f);
+  EXPECT_TRUE(cache.get_or_compute(key, again, compute));
+  EXPECT_EQ(computed, 1);
+  EXPECT_EQ(again, out);
+
+  const auto st = cache.stats();
+  EXPECT_EQ(st.hits, 1u);
+  EXPECT_EQ(st.misses, 1u);
+  EXPECT_DOUBLE_EQ(st.hit_rate(), 0.5);
+  EXPECT_EQ(st.entries, 1u);
+  EXPECT_EQ(st.bytes, 256 * sizeof(float));
+
+  std::vector<float> wrong(128);
+  EXPECT_THROW(cache.lookup(key, wrong), std::invalid_argument);
+}
+
+TEST(FrameCache, ClockKeepsReferencedEntries) {
+  const std::size_t n = 64;
+  FrameCache cache(options(3 * n * sizeof(float)));
+  const auto frame = gradient(n, 1.0f);
+  std::vector<float> out(n);
+  const auto k = [&](std::uint64_t id) {
+    return cache.key({id, id + 1}, 0.5f, OutputMethod::Linear);
+  };
+
+  cache.insert(k(0), frame);
+  cache.insert(k(1), frame);
+  cache.insert(k(2), frame);
+  ASSERT_TRUE(cache.lookup(k(0), out));  // second chance for entry 0
+  cache.insert(k(3), frame);             // evicts 1, the first unreferenced entry
+
+  EXPECT_TRUE(cache.lookup(k(0), out));
+  EXPECT_FALSE(cache.lookup(k(1), out));
+  EXPECT_TRUE(cache.lookup(k(2), out));
+  EXPECT_TRUE(cache.lookup(k(3), out));
+  const auto st = cache.stats();
+  EXPECT_EQ(st.evictions, 1u);
+  EXPECT_EQ(st.entries, 3u);
+  EXPECT_LE(st.bytes, cache.budget());
+}
+
+TEST(FrameCache, OversizedFrameIsNotRetained) {
+  FrameCache cache(options(16));
+  const auto key = cache.key({1, 2}, 0.0f, OutputMethod::Linear);
+  cache.insert(key, gradient(64, 0.0f));
+  std::vector<float> out(64);
+  EXPECT_FALSE(cache.lookup(key, out));
+  EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST(FrameCache, ColdEntriesAreCompressedLosslesslyBeforeEviction) {
+  const std::size_t n = 4096;
+  const std::size_t raw = n * sizeof(float);
+  FrameCache cache(options(2 * raw + raw / 2, /*compress=*/true));
+  std::vector<std::vector<float>> frames;
+  for (int i = 0; i < 4; ++i) frames.push_back(gradient(n, static_cast<float>(i) + 0.125f));
+  const auto k = [&](std::uint64_t id) {
+    return cache.key({id, id + 1}, 0.5f, OutputMethod::Motion);
+  };
+
+  for (std::uint64_t i = 0; i < frames.size(); ++i) cache.insert(k(i), frames[i]);
+  auto st = cache.stats();
+  EXPECT_EQ(st.entries, 4u);  // four raw frames would not fit: some were compressed instead
+  EXPECT_GT(st.compressions, 0u);
+  EXPECT_GT(st.compressed_entries, 0u);
+  EXPECT_EQ(st.evictions, 0u);
+  EXPECT_LE(st.bytes, cache.budget());
+
+  // The hand compressed the two oldest entries; a hit decodes them bit-exactly and keeps them
+  // uncompressed again, so other cold entries are compressed in turn.
+  for (std::uint64_t i = 0; i < 2; ++i) {
+    std::vector<float> out(n);
+    ASSERT_TRUE(cache.lookup(k(i), out)) << i;
+    EXPECT_EQ(out, frames[i]) << i;
+  }
+  st = cache.stats();
+  EXPECT_EQ(st.hits, 2u);
+  EXPECT_EQ(st.entries, 4u);
+  EXPECT_LE(st.bytes, cache.budget());
+}
+
+TEST(FrameCache, IncompressibleColdEntriesAreEvicted) {
+  const std::size_t n = 1024;
+  FrameCache cache(options(2 * n * sizeof(float), /*compress=*/true));
+  std::vector<float> noise(n);
+  std::uint32_t x = 12345;
+  for (float& v : noise) {
+    x = x * 1664525u + 1013904223u;
+    v = static_cast<float>(x) / 4294967296.0f;
+  }
+  for (std::uint64_t i = 0; i < 3; ++i) {
+    cache.insert(cache.key({i, i + 1}, 0.5f, OutputMethod::Linear), noise);
+  }
+  const auto st = cache.stats();
+  EXPECT_EQ(st.entries, 2u);
+  EXPECT_EQ(st.evictions, 1u);
+  EXPECT_LE(st.bytes, cache.budget());
+}
+
+// Compression runs outside the lock, so lookups, inserts and evictions interleave with it.
+TEST(FrameCache, ConcurrentCompressionStaysLosslessAndInBudget) {
+  const std::size_t n = 2048;
+  FrameCache cache(options(6 * n * sizeof(float), /*compress=*/true));
+  std::vector<std::vector<float>> frames;
+  for (int i = 0; i < 16; ++i) frames.push_back(gradient(n, static_cast<float>(i)));
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> threads;
+  for (int w = 0; w < 4; ++w) {
+    threads.emplace_back([&, w] {
+      std::vector<float> out(n);
+      for (int round = 0; round < 200; ++round) {
+        const std::uint64_t id = static_cast<std::uint64_t>((round * 7 + w * 3) % 16);
+        const auto key = cache.key({id, id + 1}, 0.5f, OutputMethod::Linear);
+        if (cache.lookup(key, out)) {
+          if (out != frames[id]) ++mismatches;
+        } else {
+          cache.insert(key, frames[id]);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(mismatches, 0);
+  const auto st = cache.stats();
+  EXPECT_GT(st.compressions, 0u);
+  EXPECT_LE(st.bytes, cache.budget());
+}
+
+TEST(FrameCache, SetBudgetAndClear) {
+  const std::size_t n = 32;
+  FrameCache cache(options(1 << 20));
+  for (std::uint64_t i = 0; i < 8; ++i) {
+    cache.insert(cache.key({i, i + 1}, 0.5f, OutputMethod::Linear), gradient(n, 0.0f));
+  }
+  cache.set_budget(4 * n * sizeof(float));
+  EXPECT_EQ(cache.stats().entries, 4u);
+  cache.clear();
+  const auto st = cache.stats();
+  EXPECT_EQ(st.entries, 0u);
+  EXPECT_EQ(st.bytes, 0u);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "minfi/frame_reader.hpp"
+#include "minfi/kernels.hpp"
+
+using minfi::FrameReaderOptions;
+using minfi::RawFrameReader;
+using minfi::ReadBackend;
+
+namespace {
+
+std::string temp_path(const std::string& tag) {
+  return ::testing::TempDir() + "minfi-reader-" + tag + "-" + std::to_string(::getpid());
+}
+
+// Frame f holds the float value f + i / elems at element i.
+std::vector<float> frame_values(std::size_t f, std::size_t elems) {
+  std::vector<float> v(elems);
+  for (std::size_t i = 0; i < elems; ++i) {
+    v[i] = static_cast<float>(f) + static_cast<float>(i) / static_cast<float>(elems);
+  }
+  return v;
+}
+
+void write_frames(std::ofstream& out, std::size_t first, std::size_t frames, std::size_t elems) {
+  for (std::size_t f = first; f < first + frames; ++f) {
+    const auto v = frame_values(f, elems);
+    out.write(reinterpret_cast<const char*>(v.data()),
+              static_cast<std::streamsize>(v.size() * sizeof(float)));
+  }
+}
+
+std::string write_sequence(const std::string& tag, std::size_t frames, std::size_t elems,
+                           std::size_t header = 0) {
+  const std::string path = temp_path(tag);
+  std::ofstream out(path, std::ios::binary);
+  const std::string pad(header, 'h');
+  out.write(pad.data(), static_cast<std::streamsize>(pad.size()));
+  write_frames(out, 0, frames, elems);
+  return path;
+}
+
+bool uring_available() {
+  const std::string path = write_sequence("probe", 1, 1024);
+  FrameReaderOptions o;
+  o.backend = ReadBackend::IoUring;
+  bool ok = true;
+  try {
+    RawFrameReader::open(path, 4096, o);
+  } catch (const std::runtime_error&) {
+    ok = false;
+  }
+  std::remove(path.c_str());
+  return ok;
+}
+
+void expect_sequence(RawFrameReader& reader, std::size_t frames, std::size_t elems) {
+  ASSERT_EQ(reader.frame_count(), frames);
+  for (std::size_t f = 0; f < frames; ++f) {
+    auto buf = reader.next();
+    ASSERT_TRUE(buf.has_value());
+    EXPECT_EQ(buf->index(), f);
+    ASSERT_EQ(buf->floats().size(), elems);
+    const auto want = frame_values(f, elems);
+    EXPECT_TRUE(std::equal(want.begin(), want.end(), buf->floats().begin())) << "frame " << f;
+  }
+  EXPECT_FALSE(reader.next().has_value());
+  EXPECT_EQ(reader.stats().frames, frames);
+  EXPECT_EQ(reader.stats().bytes, frames * elems * sizeof(float));
+}
+
+class FrameReaderBackend : public ::testing::TestWithParam<ReadBackend> {
+ protected:
+  FrameReaderOptions options() const {
+    FrameReaderOptions o;
+    o.backend = GetParam();
+    o.readahead = 3;
+    return o;
+  }
+  void SetUp() override {
+    if (GetParam() == ReadBackend::IoUring && !uring_available()) {
+      GTEST_SKIP() << "io_uring not available";
+    }
+  }
+};
+
+}  // namespace
+
+TEST_P(FrameReaderBackend, SingleFileAlignedFramesUseDirectIo) {
+  const std::size_t elems = 2048;  // 8 KiB frames
+  const std::string path = write_sequence("aligned", 9, elems);
+  auto reader = RawFrameReader::open(path, elems * sizeof(float), options());
+  EXPECT_EQ(reader.backend(), GetParam());
+  expect_sequence(reader, 9, elems);
+  std::remove(path.c_str());
+}
+
+TEST_P(FrameReaderBackend, UnalignedFramesAndHeaderFallBackToBufferedReads) {
+  const std::size_t elems = 300;
+  const std::string path = write_sequence("header", 7, elems, 12);
+  auto o = options();
+  o.header_bytes = 12;
+  auto reader = RawFrameReader::open(path, elems * sizeof(float), o);
+  EXPECT_FALSE(reader.direct_io());
+  expect_sequence(reader, 7, elems);
+  std::remove(path.c_str());
+}
+
+TEST_P(FrameReaderBackend, FilePerFrame) {
+  const std::size_t elems = 500;  // not a multiple of the O_DIRECT block
+  std::vector<std::string> paths;
+  for (std::size_t f = 0; f < 6; ++f) {
+    paths.push_back(temp_path("seq" + std::to_string(f)));
+    std::ofstream out(paths.back(), std::ios::binary);
+    write_frames(out, f, 1, elems);
+  }
+  auto reader = RawFrameReader::open(paths, elems * sizeof(float), options());
+  expect_sequence(reader, 6, elems);
+  for (const auto& p : paths) std::remove(p.c_str());
+}
+
+TEST_P(FrameReaderBackend, TruncatedFrameThrows) {
+  const std::size_t elems = 256;
+  std::vector<std::string> paths = {temp_path("full"), temp_path("short"), temp_path("after")};
+  {
+    std::ofstream out(paths[0], std::ios::binary);
+    write_frames(out, 0, 1, elems);
+    std::ofstream out2(paths[1], std::ios::binary);
+    write_frames(out2, 1, 1, elems / 2);
+    std::ofstream out3(paths[2], std::ios::binary);
+    write_frames(out3, 2, 1, elems);
+  }
+  auto reader = RawFrameReader::open(paths, elems * sizeof(float), options());
+  EXPECT_TRUE(reader.next().has_value());
+  EXPECT_THROW(reader.next(), std::runtime_error);
+  EXPECT_THROW(reader.next(), std::runtime_error);  // sticky: the bad frame is never skipped
+  for (const auto& p : paths) std::remove(p.c_str());
+}
+
+TEST_P(FrameReaderBackend, BuffersOutliveReaderAndFeedInterpolation) {
+  const std::size_t elems = 1024;
+  const std::string path = write_sequence("pairs", 5, elems);
+  std::optional<RawFrameReader::Buffer> a;
+  std::optional<RawFrameReader::Buffer> b;
+  {
+    auto reader = RawFrameReader::open(path, elems * sizeof(float), options());
+    a = reader.next();
+    b = reader.next();
+  }
+  ASSERT_TRUE(a && b);
+  std::vector<float> out(elems);
+  minfi::interpolate_into<float>(a->floats(), b->floats(), out, 0.5f);
+  EXPECT_FLOAT_EQ(out[0], 0.5f);
+  std::remove(path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, FrameReaderBackend,
+                         ::testing::Values(ReadBackend::Threads, ReadBackend::IoUring),
+                         [](const auto& info) {
+                           return info.param == ReadBackend::IoUring ? "IoUring" : "Threads";
+                         });
+
+TEST(FrameReader, MissingFileAndZeroFrameSizeThrow) {
+  EXPECT_THROW(RawFrameReader::open(temp_path("missing"), 16), std::runtime_error);
+  EXPECT_THROW(RawFrameReader::open(temp_path("missing"), 0), std::invalid_argument);
+  EXPECT_THROW(RawFrameReader::open(temp_path("missing"), std::size_t{1} << 32),
+               std::invalid_argument);
+}
+
+TEST(FrameReader, HoldingEveryBufferIsALogicError) {
+  const std::size_t elems = 64;
+  const std::string path = write_sequence("held", 8, elems);
+  FrameReaderOptions o;
+  o.readahead = 1;
+  o.backend = ReadBackend::Threads;
+  auto reader = RawFrameReader::open(path, elems * sizeof(float), o);
+  std::vector<RawFrameReader::Buffer> held;
+  for (int i = 0; i < 3; ++i) held.push_back(*reader.next());  // readahead + 2 slots
+  EXPECT_THROW(reader.next(), std::logic_error);
+  held.clear();
+  auto buf = reader.next();
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->index(), 3u);
+  std::remove(path.c_str());
+}
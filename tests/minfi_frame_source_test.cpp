@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "minfi/frame_source.hpp"
+
+using minfi::DecodeTarget;
+using minfi::FrameSourceOptions;
+using minfi::ParallelFrameSource;
+using minfi::PixelFormat;
+
+namespace {
+
+// 4x2 RGB frame whose every byte is the frame index; odd frames take longer so that later
+// frames routinely finish first.
+bool decode_slow_odd(std::size_t index, DecodeTarget& out) {
+  if (index % 2) std::this_thread::sleep_for(std::chrono::milliseconds(3));
+  auto view = out.reshape(4, 2, PixelFormat::Rgb8);
+  std::fill(view.data, view.data + 4 * 2 * 3, static_cast<std::uint8_t>(index));
+  return true;
+}
+
+}  // namespace
+
+TEST(FrameSource, DeliversInOrderDespiteOutOfOrderDecode) {
+  FrameSourceOptions o;
+  o.threads = 4;
+  o.window = 6;
+  ParallelFrameSource src(40, decode_slow_odd, o);
+  EXPECT_EQ(src.thread_count(), 4u);
+  std::size_t expected = 0;
+  while (auto f = src.next()) {
+    EXPECT_EQ(f->index(), expected);
+    const auto view = f->view();
+    EXPECT_EQ(view.width, 4u);
+    EXPECT_EQ(view.format, PixelFormat::Rgb8);
+    EXPECT_EQ(view.data[5], static_cast<std::uint8_t>(expected));
+    ++expected;
+  }
+  EXPECT_EQ(expected, 40u);
+  EXPECT_FALSE(src.next().has_value());
+  EXPECT_EQ(src.stats().decoded, 40u);
+  EXPECT_LE(src.stats().max_reorder, o.window);
+}
+
+TEST(FrameSource, WindowBoundsDecodeAhead) {
+  std::atomic<std::size_t> highest{0};
+  FrameSourceOptions o;
+  o.threads = 3;
+  o.window = 4;
+  ParallelFrameSource src(
+      100,
+      [&](std::size_t index, DecodeTarget& out) {
+        std::size_t h = highest.load();
+        while (index > h && !highest.compare_exchange_weak(h, index)) {
+        }
+        out.reshape(1, 1, PixelFormat::Rgb8);
+        return true;
+      },
+      o);
+  auto first = src.next();
+  ASSERT_TRUE(first.has_value());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  // Frame 0 delivered: decode may reach index delivered + window - 1 = 4 at most.
+  EXPECT_LE(highest.load(), 4u);
+}
+
+TEST(FrameSource, OpenEndedStreamStopsAtFirstFalse) {
+  FrameSourceOptions o;
+  o.threads = 2;
+  o.window = 5;
+  ParallelFrameSource src(
+      ParallelFrameSource::kUnknownCount,
+      [](std::size_t index, DecodeTarget& out) {
+        if (index >= 7) return false;
+        out.reshape(2, 2, PixelFormat::Rgba8);
+        return true;
+      },
+      o);
+  std::size_t n = 0;
+  while (auto f = src.next()) {
+    EXPECT_EQ(f->index(), n++);
+  }
+  EXPECT_EQ(n, 7u);
+  EXPECT_EQ(src.frame_count(), 7u);
+}
+
+TEST(FrameSource, DecodeErrorSurfacesForItsFrameAndDeliveryContinues) {
+  ParallelFrameSource src(5, [](std::size_t index, DecodeTarget& out) {
+    if (index == 2) throw std::runtime_error("bad frame");
+    out.reshape(1, 1, PixelFormat::Rgb8);
+    return true;
+  });
+  EXPECT_EQ(src.next()->index(), 0u);
+  EXPECT_EQ(src.next()->index(), 1u);
+  EXPECT_THROW(src.next(), std::runtime_error);
+  EXPECT_EQ(src.next()->index(), 3u);
+  EXPECT_EQ(src.next()->index(), 4u);
+  EXPECT_FALSE(src.next().has_value());
+}
+
+TEST(FrameSource, PooledBuffersAreReusedAndReleasedAcrossThreads) {
+  FrameSourceOptions o;
+  o.threads = 2;
+  o.window = 1;
+  ParallelFrameSource src(20, decode_slow_odd, o);
+  std::vector<ParallelFrameSource::Frame> held;
+  for (int i = 0; i < 3; ++i) held.push_back(*src.next());  // window + 2 buffers
+  EXPECT_THROW(src.next(), std::logic_error);
+  std::thread releaser([&] { held.clear(); });
+  releaser.join();
+  std::size_t last = 0;
+  while (auto f = src.next()) last = f->index();
+  EXPECT_EQ(last, 19u);
+}
+
+TEST(FrameSource, FramesOutliveTheSource) {
+  std::optional<ParallelFrameSource::Frame> kept;
+  {
+    ParallelFrameSource src(3, decode_slow_odd);
+    kept = src.next();
+  }
+  ASSERT_TRUE(kept.has_value());
+  EXPECT_EQ(kept->view().data[0], 0);
+}
+
+TEST(FrameSource, InvalidArguments) {
+  FrameSourceOptions o;
+  o.window = 0;
+  EXPECT_THROW(ParallelFrameSource(1, decode_slow_odd, o), std::invalid_argument);
+  EXPECT_THROW(ParallelFrameSource(1, minfi::DecodeFn{}), std::invalid_argument);
+}
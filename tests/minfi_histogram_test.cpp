@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+
+#include "minfi/histogram.hpp"
+
+using minfi::LatencyHistogram;
+
+TEST(Histogram, SmallValuesAreExact) {
+  LatencyHistogram h;
+  for (std::uint64_t v = 1; v <= 100; ++v) h.record(v);
+  EXPECT_EQ(h.count(), 100u);
+  EXPECT_EQ(h.min(), 1u);
+  EXPECT_EQ(h.max(), 100u);
+  EXPECT_DOUBLE_EQ(h.mean(), 50.5);
+  EXPECT_EQ(h.value_at_percentile(50), 50u);
+  EXPECT_EQ(h.value_at_percentile(99), 99u);
+  EXPECT_EQ(h.value_at_percentile(100), 100u);
+  EXPECT_EQ(h.value_at_percentile(0), 1u);
+  EXPECT_EQ(h.count_above(90), 10u);
+}
+
+TEST(Histogram, LargeValuesWithinRelativeError) {
+  LatencyHistogram h(8);
+  std::mt19937_64 rng(7);
+  std::uniform_int_distribution<std::uint64_t> dist(1'000, 50'000'000'000ull);
+  for (int i = 0; i < 20000; ++i) {
+    const std::uint64_t v = dist(rng);
+    LatencyHistogram one(8);
+    one.record(v);
+    const std::uint64_t q = one.value_at_percentile(50);
+    EXPECT_GE(q, v);
+    EXPECT_LE(static_cast<double>(q - v), static_cast<double>(v) / 128.0);
+    h.record(v);
+  }
+  EXPECT_EQ(h.count(), 20000u);
+  const double p50 = static_cast<double>(h.value_at_percentile(50));
+  EXPECT_NEAR(p50, 25e9, 25e9 * 0.05);
+  EXPECT_EQ(h.value_at_percentile(100), h.max());
+  h.record(UINT64_MAX);  // the top bucket is addressable
+  EXPECT_EQ(h.max(), UINT64_MAX);
+}
+
+TEST(Histogram, MergeAndReset) {
+  LatencyHistogram a, b;
+  a.record(10, 3);
+  b.record(1'000'000);
+  b.record(5);
+  a.merge(b);
+  EXPECT_EQ(a.count(), 5u);
+  EXPECT_EQ(a.min(), 5u);
+  EXPECT_EQ(a.max(), 1'000'000u);
+  EXPECT_EQ(a.count_above(10), 1u);
+  a.reset();
+  EXPECT_EQ(a.count(), 0u);
+  EXPECT_EQ(a.value_at_percentile(99), 0u);
+  EXPECT_THROW(a.merge(LatencyHistogram(4)), std::invalid_argument);
+  EXPECT_THROW(LatencyHistogram(1), std::invalid_argument);
+}
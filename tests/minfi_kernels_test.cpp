@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+
+TEST(Kernels, FixedChannelsMatchesFlat) {
+  std::vector<float> a{0.f, 0.2f, 0.4f, 1.f, 0.6f, 0.8f};
+  std::vector<float> b{1.f, 0.8f, 0.6f, 0.f, 0.4f, 0.2f};
+  auto flat = minfi::interpolate<float>(a, b, 0.25f);
+  auto rgb = minfi::interpolate<float, 3>(a, b, 0.25f);
+  for (size_t i = 0; i < a.size(); ++i) EXPECT_FLOAT_EQ(rgb[i], flat[i]);
+}
+
+TEST(Kernels, ChannelMultipleChecked) {
+  std::vector<float> a(5, 0.f), b(5, 1.f);
+  EXPECT_THROW((minfi::interpolate<float, 4>(a, b, 0.5f)), std::invalid_argument);
+  EXPECT_THROW((minfi::interpolate<float, 3>(a, std::vector<float>(6), 0.5f)),
+               std::invalid_argument);
+}
+
+TEST(Kernels, HalfAverageRoundsHalfUp) {
+  std::vector<std::uint8_t> a{0, 1, 254, 255, 10};
+  std::vector<std::uint8_t> b{1, 2, 255, 255, 20};
+  auto m = minfi::interpolate_half<std::uint8_t>(a, b);
+  EXPECT_EQ(m, (std::vector<std::uint8_t>{1, 2, 255, 255, 15}));
+}
+
+TEST(Kernels, FixedRatioMatchesRuntime) {
+  std::vector<std::uint16_t> a{0, 1000, 65535, 300};
+  std::vector<std::uint16_t> b{65535, 0, 65535, 900};
+  auto fixed = minfi::interpolate_fixed<std::uint16_t, 4, 1, 4>(a, b);
+  auto runtime = minfi::interpolate<std::uint16_t, 4>(a, b, 0.25f);
+  for (size_t i = 0; i < a.size(); ++i) EXPECT_NEAR(fixed[i], runtime[i], 1);
+
+  std::vector<float> fa{0.f, 2.f}, fb{2.f, 0.f};
+  auto ff = minfi::interpolate_fixed<float, 0, 1, 2>(fa, fb);
+  EXPECT_FLOAT_EQ(ff[0], 1.f);
+  EXPECT_FLOAT_EQ(ff[1], 1.f);
+}
+
+TEST(Kernels, WideAndSignedIntegersBlendExactly) {
+  static_assert(!minfi::detail::kSupportedElement<bool>);
+  static_assert(!minfi::detail::kSupportedElement<std::uint64_t>);
+  static_assert(minfi::detail::kSupportedElement<std::int16_t>);
+
+  // 32-bit samples lose their low bits in float and overflowed the 64-bit fixed-point sum.
+  std::vector<std::uint32_t> a{4294967295u, 16777217u, 0u};
+  std::vector<std::uint32_t> b{4294967295u, 16777219u, 4294967295u};
+  EXPECT_EQ((minfi::interpolate_fixed<std::uint32_t, 0, 1, 3>(a, b)),
+            (std::vector<std::uint32_t>{4294967295u, 16777218u, 1431655765u}));
+  EXPECT_EQ(minfi::interpolate<std::uint32_t>(a, b, 0.5f),
+            (std::vector<std::uint32_t>{4294967295u, 16777218u, 2147483648u}));
+
+  // Denominators too large for 32-bit fixed point take the double path.
+  const std::vector<std::uint16_t> ua{65535, 0}, ub{0, 65535};
+  EXPECT_EQ((minfi::interpolate_fixed<std::uint16_t, 0, 1, 100000>(ua, ub)),
+            (std::vector<std::uint16_t>{65534, 1}));
+
+  // Signed samples round half up on both sides of zero.
+  std::vector<std::int16_t> sa{-32768, -3, -1, 100};
+  std::vector<std::int16_t> sb{32767, -2, 0, -100};
+  EXPECT_EQ(minfi::interpolate<std::int16_t>(sa, sb, 0.5f),
+            (std::vector<std::int16_t>{0, -2, 0, 0}));
+  EXPECT_EQ((minfi::interpolate_fixed<std::int16_t, 0, 1, 2>(sa, sb)),
+            (std::vector<std::int16_t>{0, -2, 0, 0}));
+  EXPECT_EQ((minfi::interpolate_fixed<std::int16_t, 0, 1, 4>(sa, sb)),
+            (std::vector<std::int16_t>{-16384, -3, -1, 50}));
+}
+
+TEST(Kernels, EasingPolicies) {
+  static_assert(minfi::ease::Smoothstep::apply(0.5f) == 0.5f);
+  static_assert(minfi::ease::Cubic::apply(0.0f) == 0.0f);
+  static_assert(minfi::ease::Cubic::apply(1.0f) == 1.0f);
+  std::vector<float> a{0.f}, b{1.f};
+  EXPECT_FLOAT_EQ((minfi::interpolate<float, 1, minfi::ease::Smoothstep>(a, b, 0.25f)[0]),
+                  0.15625f);
+  EXPECT_FLOAT_EQ((minfi::interpolate<float, 1, minfi::ease::Cubic>(a, b, 0.25f)[0]), 0.0625f);
+  EXPECT_FLOAT_EQ((minfi::interpolate<float, 1, minfi::ease::Cubic>(a, b, 2.0f)[0]), 1.f);
+}
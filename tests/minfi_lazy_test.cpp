@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "minfi/lazy.hpp"
+
+using minfi::Frame;
+using minfi::FrameShape;
+using minfi::LazyInterpolation;
+
+namespace {
+Frame ramp(size_t n, float scale) {
+  Frame f(n);
+  for (size_t i = 0; i < n; ++i) f[i] = static_cast<float>(i) * scale;
+  return f;
+}
+}  // namespace
+
+TEST(Lazy, RowsMatchEagerInterpolation) {
+  const FrameShape shape{4, 3, 3};
+  Frame a = ramp(shape.elems(), 1.f), b = ramp(shape.elems(), -1.f);
+  Frame eager = minfi::interpolate(a, b, 0.25f);
+  LazyInterpolation lazy(a, b, shape, 0.25f, 2);
+  EXPECT_EQ(lazy.rows_computed(), 0u);
+
+  auto r1 = lazy.row(1);
+  ASSERT_EQ(r1.size(), shape.row_elems());
+  for (size_t i = 0; i < r1.size(); ++i) EXPECT_FLOAT_EQ(r1[i], eager[shape.row_elems() + i]);
+  (void) lazy.row(1);  // cached
+  EXPECT_EQ(lazy.rows_computed(), 1u);
+  EXPECT_EQ(lazy.materialize(), eager);
+}
+
+TEST(Lazy, TileWithStride) {
+  const FrameShape shape{5, 4, 1};
+  Frame a = ramp(shape.elems(), 1.f), b = ramp(shape.elems(), 3.f);
+  Frame eager = minfi::interpolate(a, b, 0.5f);
+  LazyInterpolation lazy(a, b, shape, 0.5f);
+  std::vector<float> tile(2 * 8, -1.f);
+  lazy.read_tile(1, 2, 3, 2, tile, 8);
+  for (size_t r = 0; r < 2; ++r) {
+    for (size_t x = 0; x < 3; ++x) EXPECT_FLOAT_EQ(tile[r * 8 + x], eager[(2 + r) * 5 + 1 + x]);
+    EXPECT_FLOAT_EQ(tile[r * 8 + 3], -1.f);  // untouched padding
+  }
+  EXPECT_THROW(lazy.read_tile(3, 0, 3, 1, tile), std::out_of_range);
+}
+
+TEST(Lazy, ShapeMismatchThrows) {
+  Frame a(6), b(6);
+  EXPECT_THROW(LazyInterpolation(a, b, FrameShape{2, 2, 1}, 0.5f), std::invalid_argument);
+}
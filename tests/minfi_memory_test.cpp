@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/memory.hpp"
+#include "minfi/motion.hpp"
+
+using minfi::Subsystem;
+
+TEST(Memory, FramesAreAccounted) {
+  const auto before = minfi::memory_stats(Subsystem::Frames);
+  {
+    minfi::Frame a(1000, 0.f), b(1000, 1.f);
+    minfi::Frame out = minfi::interpolate(a, b, 0.5f);
+    const auto during = minfi::memory_stats(Subsystem::Frames);
+    EXPECT_EQ(during.current_bytes - before.current_bytes, 3 * 1000 * sizeof(float));
+    EXPECT_GE(during.peak_bytes, during.current_bytes);
+    EXPECT_EQ(during.allocations - before.allocations, 3u);
+  }
+  const auto after = minfi::memory_stats(Subsystem::Frames);
+  EXPECT_EQ(after.current_bytes, before.current_bytes);
+  EXPECT_EQ(after.deallocations - before.deallocations, 3u);
+
+  minfi::reset_memory_peaks();
+  EXPECT_EQ(minfi::memory_stats(Subsystem::Frames).peak_bytes, after.current_bytes);
+}
+
+TEST(Memory, MotionFieldsHaveTheirOwnBucket) {
+  const auto frames = minfi::memory_stats(Subsystem::Frames);
+  const auto motion = minfi::memory_stats(Subsystem::Motion);
+  minfi::MotionField field;
+  field.vectors.resize(64);
+  EXPECT_EQ(minfi::memory_stats(Subsystem::Motion).current_bytes - motion.current_bytes,
+            64 * sizeof(minfi::MotionVector));
+  EXPECT_EQ(minfi::memory_stats(Subsystem::Frames).current_bytes, frames.current_bytes);
+  EXPECT_EQ(minfi::memory_stats().size(), minfi::kSubsystems);
+  EXPECT_STREQ(minfi::to_string(Subsystem::Upload), "upload");
+}
+
+TEST(Memory, PluggableResource) {
+  char arena[1 << 14];
+  std::pmr::monotonic_buffer_resource mono(arena, sizeof(arena),
+                                           std::pmr::null_memory_resource());
+  auto* prev = minfi::set_memory_resource(Subsystem::Scratch, &mono);
+  EXPECT_EQ(prev, std::pmr::new_delete_resource());
+  {
+    minfi::Vector<float, Subsystem::Scratch> v(256);
+    const auto* p = reinterpret_cast<const char*>(v.data());
+    EXPECT_TRUE(p >= arena && p < arena + sizeof(arena));
+    // Switching back while v is alive is fine: v's block returns to the arena it came from.
+    minfi::set_memory_resource(Subsystem::Scratch, nullptr);
+  }
+  // Callers' own pmr containers can share the accounting.
+  const auto before = minfi::memory_stats(Subsystem::Scratch).current_bytes;
+  std::pmr::vector<int> mine(100, minfi::tracked_resource(Subsystem::Scratch));
+  EXPECT_EQ(minfi::memory_stats(Subsystem::Scratch).current_bytes - before, 100 * sizeof(int));
+}
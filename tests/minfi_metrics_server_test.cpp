@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "minfi/metrics_server.hpp"
+
+using minfi::MetricsRegistry;
+using minfi::MetricsServer;
+
+namespace {
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kNoSignal = MSG_NOSIGNAL;
+#else
+constexpr int kNoSignal = 0;  // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+std::string send_request(int fd, const std::string& request) {
+  EXPECT_EQ(::write(fd, request.data(), request.size()), static_cast<ssize_t>(request.size()));
+  std::string reply;
+  char buf[4096];
+  for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0;) {
+    reply.append(buf, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  return reply;
+}
+
+std::string http_tcp(std::uint16_t port, const std::string& path) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    return {};
+  }
+  return send_request(fd, "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+
+std::string http_unix(const std::string& path) {
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    return {};
+  }
+  return send_request(fd, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+
+}  // namespace
+
+TEST(MetricsServer, ServesPrometheusTextOnLoopback) {
+  MetricsRegistry registry;
+  registry.counter("minfi_frames_total", "Frames produced.").inc(7);
+  MetricsServer::Options options;
+  options.port = 0;
+  const MetricsServer server(registry, options);
+  ASSERT_NE(server.port(), 0);
+
+  const std::string reply = http_tcp(server.port(), "/metrics");
+  EXPECT_EQ(reply.rfind("HTTP/1.1 200 OK\r\n", 0), 0u) << reply;
+  EXPECT_NE(reply.find("Content-Type: text/plain; version=0.0.4"), std::string::npos);
+  EXPECT_NE(reply.find("\r\n\r\n# HELP minfi_frames_total"), std::string::npos);
+  EXPECT_NE(reply.find("minfi_frames_total 7\n"), std::string::npos);
+
+  // Later updates show up on the next scrape.
+  registry.counter("minfi_frames_total", "Frames produced.").inc();
+  EXPECT_NE(http_tcp(server.port(), "/").find("minfi_frames_total 8\n"), std::string::npos);
+  EXPECT_EQ(http_tcp(server.port(), "/nope").rfind("HTTP/1.1 404", 0), 0u);
+}
+
+TEST(MetricsServer, FailingCallbackAnswers500AndKeepsServing) {
+  MetricsRegistry registry;
+  registry.gauge_fn("minfi_broken", "Throws.", {}, []() -> double {
+    throw std::runtime_error("probe failed");
+  });
+  MetricsServer::Options options;
+  options.port = 0;
+  const MetricsServer server(registry, options);
+  EXPECT_EQ(http_tcp(server.port(), "/metrics").rfind("HTTP/1.1 500", 0), 0u);
+  EXPECT_EQ(http_tcp(server.port(), "/nope").rfind("HTTP/1.1 404", 0), 0u);
+}
+
+TEST(MetricsServer, TricklingClientIsDroppedAtTheRequestDeadline) {
+  MetricsRegistry registry;
+  MetricsServer::Options options;
+  options.port = 0;
+  const MetricsServer server(registry, options);
+
+  // The server hangs up mid-trickle; the next send must fail rather than raise SIGPIPE.
+  const int slow = ::socket(AF_INET, SOCK_STREAM, 0);
+#if defined(SO_NOSIGPIPE)
+  const int one = 1;
+  ::setsockopt(slow, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(server.port());
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  ASSERT_EQ(::connect(slow, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+  std::atomic<bool> stop{false};
+  std::thread trickle([&] {
+    // One byte well inside the per-recv timeout, never finishing the headers.
+    while (!stop) {
+      if (::send(slow, "G", 1, kNoSignal) != 1) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const auto t0 = std::chrono::steady_clock::now();
+  EXPECT_EQ(http_tcp(server.port(), "/metrics").rfind("HTTP/1.1 200", 0), 0u);
+  EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(4));
+  stop = true;
+  trickle.join();
+  ::close(slow);
+}
+
+TEST(MetricsServer, ServesOnUnixSocket) {
+  MetricsRegistry registry;
+  registry.gauge("minfi_queue_depth", "Queued frames.").set(4);
+  MetricsServer::Options options;
+  options.unix_path = ::testing::TempDir() + "minfi-metrics-" + std::to_string(::getpid());
+  {
+    const MetricsServer server(registry, options);
+    EXPECT_EQ(server.port(), 0);
+    EXPECT_NE(http_unix(options.unix_path).find("minfi_queue_depth 4\n"), std::string::npos);
+  }
+  EXPECT_NE(::access(options.unix_path.c_str(), F_OK), 0);  // removed on shutdown
+}
+
+TEST(MetricsServer, LeavesNonSocketFilesAtTheUnixPath) {
+  MetricsRegistry registry;
+  MetricsServer::Options options;
+  options.unix_path = ::testing::TempDir() + "minfi-metrics-file-" + std::to_string(::getpid());
+  { std::ofstream(options.unix_path) << "keep"; }
+  EXPECT_THROW(MetricsServer(registry, options), std::runtime_error);
+  std::string kept;
+  std::ifstream(options.unix_path) >> kept;
+  EXPECT_EQ(kept, "keep");
+  std::remove(options.unix_path.c_str());
+}
+
+TEST(MetricsServer, RejectsBadAddress) {
+  MetricsRegistry registry;
+  MetricsServer::Options options;
+  options.address = "localhost";
+  EXPECT_THROW(MetricsServer(registry, options), std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minfi/executor.hpp"
+#include "minfi/frame_cache.hpp"
+#include "minfi/metrics.hpp"
+
+using minfi::Histogram;
+using minfi::MetricsRegistry;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& line) {
+  return text.find(line) != std::string::npos;
+}
+
+}  // namespace
+
+TEST(Metrics, CountersAreSharedByNameAndLabels) {
+  MetricsRegistry registry;
+  auto& frames = registry.counter("minfi_frames_total", "Frames produced.");
+  auto& decode = registry.counter("minfi_stage_total", "Stage runs.", {{"stage", "decode"}});
+  auto& blend = registry.counter("minfi_stage_total", "Stage runs.", {{"stage", "blend"}});
+  EXPECT_EQ(&frames, &registry.counter("minfi_frames_total", "Frames produced."));
+  EXPECT_NE(&decode, &blend);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 10000; ++j) frames.inc();
+    });
+  }
+  for (auto& t : threads) t.join();
+  decode.inc(3);
+  EXPECT_EQ(frames.value(), 40000u);
+
+  const std::string text = registry.render();
+  EXPECT_TRUE(contains(text, "# HELP minfi_frames_total Frames produced.\n"));
+  EXPECT_TRUE(contains(text, "# TYPE minfi_frames_total counter\n"));
+  EXPECT_TRUE(contains(text, "minfi_frames_total 40000\n"));
+  EXPECT_TRUE(contains(text, "minfi_stage_total{stage=\"decode\"} 3\n"));
+  EXPECT_TRUE(contains(text, "minfi_stage_total{stage=\"blend\"} 0\n"));
+  // One HELP/TYPE header per family.
+  EXPECT_EQ(text.find("# TYPE minfi_stage_total"), text.rfind("# TYPE minfi_stage_total"));
+}
+
+TEST(Metrics, HistogramRendersCumulativeBuckets) {
+  MetricsRegistry registry;
+  auto& h = registry.histogram("minfi_blend_seconds", "Blend latency.", {}, {1000, 2000, 4000});
+  h.record(500);
+  h.record(1000);  // bounds are inclusive
+  h.record(3000);
+  h.record(9000);
+  EXPECT_EQ(h.counts(), (std::vector<std::uint64_t>{2, 0, 1, 1}));
+  EXPECT_EQ(h.sum(), 13500u);
+
+  const std::string text = registry.render();
+  EXPECT_TRUE(contains(text, "# TYPE minfi_blend_seconds histogram\n"));
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_bucket{le=\"1e-06\"} 2\n")) << text;
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_bucket{le=\"2e-06\"} 2\n"));
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_bucket{le=\"4e-06\"} 3\n"));
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_bucket{le=\"+Inf\"} 4\n"));
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_sum 1.35e-05\n"));
+  EXPECT_TRUE(contains(text, "minfi_blend_seconds_count 4\n"));
+
+  {
+    minfi::ScopedTimer timer(h);
+  }
+  EXPECT_EQ(h.counts()[0] + h.counts()[1] + h.counts()[2] + h.counts()[3], 5u);
+
+  const auto bounds = Histogram::latency_bounds_ns();
+  EXPECT_EQ(bounds.front(), 1000u);
+  EXPECT_EQ(bounds[1], 2000u);
+  EXPECT_THROW(Histogram({}), std::invalid_argument);
+  EXPECT_THROW(Histogram({2, 2}), std::invalid_argument);
+}
+
+TEST(Metrics, GaugesAndScrapeTimeSeries) {
+  MetricsRegistry registry;
+  auto& depth = registry.gauge("minfi_queue_depth", "Queued frames.");
+  depth.add(5);
+  depth.add(-2);
+  double fps = 59.5;
+  registry.gauge_fn("minfi_fps", "Frames per second.", {{"output", "main \"A\""}},
+                    [&] { return fps; });
+  minfi::FrameCache cache;
+  minfi::register_frame_cache_metrics(registry, cache, "out");
+  minfi::Executor executor(1);
+  minfi::register_executor_metrics(registry, executor, "bg");
+  minfi::register_memory_metrics(registry);
+
+  const std::string text = registry.render();
+  EXPECT_TRUE(contains(text, "minfi_queue_depth 3\n"));
+  EXPECT_TRUE(contains(text, "minfi_fps{output=\"main \\\"A\\\"\"} 59.5\n")) << text;
+  EXPECT_TRUE(contains(text, "# TYPE minfi_frame_cache_hits_total counter\n"));
+  EXPECT_TRUE(contains(text, "minfi_frame_cache_misses_total{cache=\"out\"} 0\n"));
+  EXPECT_TRUE(contains(text, "minfi_executor_threads{executor=\"bg\"} 1\n"));
+  EXPECT_TRUE(contains(text, "minfi_memory_bytes{subsystem=\"frames\"}"));
+}
+
+TEST(Metrics, RejectsInvalidRegistrations) {
+  MetricsRegistry registry;
+  registry.counter("minfi_x_total", "x");
+  EXPECT_THROW(registry.gauge("minfi_x_total", "x"), std::invalid_argument);
+  EXPECT_THROW(registry.counter("9lives", "x"), std::invalid_argument);
+  EXPECT_THROW(registry.counter("minfi_y", "y", {{"le", "1"}}), std::invalid_argument);
+  EXPECT_THROW(registry.counter("minfi_y", "y", {{"bad-label", "1"}}), std::invalid_argument);
+  EXPECT_THROW(registry.histogram("minfi_h", "h", {}, {3, 1}), std::invalid_argument);
+  // The rejected histogram left nothing behind.
+  EXPECT_FALSE(contains(registry.render(), "minfi_h"));
+  registry.gauge_fn("minfi_g", "g", {}, [] { return 1.0; });
+  EXPECT_THROW(registry.gauge("minfi_g", "g"), std::invalid_argument);
+}
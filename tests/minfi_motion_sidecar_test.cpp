@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "minfi/motion_sidecar.hpp"
+
+using minfi::FramePairKey;
+using minfi::MotionField;
+using minfi::MotionOptions;
+using minfi::MotionSidecar;
+using minfi::MotionSidecarWriter;
+using minfi::SidecarCodec;
+
+namespace {
+MotionField make_field(size_t cols, size_t rows, int seed) {
+  MotionField f;
+  f.cols = cols;
+  f.rows = rows;
+  f.block = 16;
+  f.vectors.resize(cols * rows);
+  for (size_t i = 0; i < f.vectors.size(); ++i) {
+    f.vectors[i] = {static_cast<std::int16_t>(seed + static_cast<int>(i % 7)),
+                    static_cast<std::int16_t>(-seed)};
+  }
+  return f;
+}
+
+std::string temp_path(const char* tag) {
+  return ::testing::TempDir() + "minfi_sidecar_" + tag + ".mvsc";
+}
+}  // namespace
+
+TEST(MotionSidecar, RoundTripIsZeroCopy) {
+  const std::string path = temp_path("roundtrip");
+  const MotionField f1 = make_field(5, 3, 1), f2 = make_field(4, 4, 2), f3 = make_field(5, 3, 3);
+  {
+    MotionSidecarWriter w(path);
+    w.add({20, 21}, f2.view());
+    w.add({10, 11}, f1.view());
+    w.add({10, 11}, f3.view(), MotionOptions{8, 4});
+    w.finish();
+  }
+  MotionSidecar sc = MotionSidecar::open(path);
+  EXPECT_EQ(sc.size(), 3u);
+  EXPECT_FALSE(sc.contains({11, 10}));
+
+  auto v = sc.view({10, 11});
+  ASSERT_TRUE(v.has_value());
+  EXPECT_EQ(v->cols, 5u);
+  EXPECT_EQ(v->rows, 3u);
+  EXPECT_EQ(v->block, 16u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v->vectors) % 64, 0u);
+  for (size_t i = 0; i < f1.vectors.size(); ++i) EXPECT_EQ(v->vectors[i], f1.vectors[i]);
+
+  auto other = sc.load({10, 11}, MotionOptions{8, 4});
+  ASSERT_NE(other, nullptr);
+  EXPECT_EQ(other->vectors, f3.vectors);
+  EXPECT_EQ(sc.load({20, 21})->vectors, f2.vectors);
+  EXPECT_EQ(sc.load({20, 21}, MotionOptions{8, 4}), nullptr);
+
+  MotionSidecar moved = std::move(sc);
+  EXPECT_TRUE(moved.contains({20, 21}));
+  std::remove(path.c_str());
+}
+
+TEST(MotionSidecar, RejectsDuplicatesAndCorruptFiles) {
+  const std::string path = temp_path("corrupt");
+  const MotionField f = make_field(2, 2, 0);
+  {
+    MotionSidecarWriter w(path);
+    w.add({1, 2}, f.view());
+    w.add({1, 2}, f.view());
+    EXPECT_THROW(w.finish(), std::invalid_argument);
+  }
+  {
+    std::ofstream junk(path, std::ios::binary | std::ios::trunc);
+    junk << std::string(128, 'x');
+  }
+  EXPECT_THROW(MotionSidecar::open(path), std::runtime_error);
+  {
+    MotionSidecarWriter w(path);
+    w.add({1, 2}, f.view());
+  }  // destructor finishes the file
+  std::filesystem::resize_file(path, 100);  // cut into the index
+  EXPECT_THROW(MotionSidecar::open(path), std::runtime_error);
+  EXPECT_THROW(MotionSidecar::open(path + ".missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(MotionSidecar, Lz4Codec) {
+  const std::string path = temp_path("lz4");
+  if (!MotionSidecarWriter::supports(SidecarCodec::Lz4)) {
+    EXPECT_THROW(MotionSidecarWriter(path, SidecarCodec::Lz4), std::invalid_argument);
+    GTEST_SKIP() << "built without MINFI_WITH_LZ4";
+  }
+  MotionField flat = make_field(64, 64, 0);
+  for (auto& v : flat.vectors) v = {4, 0};
+  {
+    MotionSidecarWriter w(path, SidecarCodec::Lz4);
+    w.add({1, 2}, flat.view());
+  }
+  MotionSidecar sc = MotionSidecar::open(path);
+  EXPECT_FALSE(sc.view({1, 2}).has_value());  // compressed: no zero-copy view
+  EXPECT_EQ(sc.load({1, 2})->vectors, flat.vectors);
+
+  // An entry claiming more vectors than its stored bytes could decode to is rejected at open.
+  {
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    std::uint64_t index_offset = 0;
+    f.seekg(24);  // FileHeader::index_offset
+    f.read(reinterpret_cast<char*>(&index_offset), sizeof(index_offset));
+    const std::uint32_t huge = 1u << 12;  // 4096 x 4096 vectors from a few hundred bytes
+    f.seekp(static_cast<std::streamoff>(index_offset + 24));  // cols, then rows
+    f.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    f.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+  }
+  EXPECT_THROW(MotionSidecar::open(path), std::runtime_error);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "minfi/motion.hpp"
+#include "minfi/motion_cache.hpp"
+
+using minfi::FramePairKey;
+using minfi::FrameShape;
+using minfi::MotionCache;
+using minfi::MotionField;
+using minfi::MotionOptions;
+
+namespace {
+// Smooth 2-D pattern shifted by (sx, sy) pixels.
+minfi::Frame pattern(const FrameShape& s, float sx, float sy) {
+  minfi::Frame f(s.elems());
+  for (size_t y = 0; y < s.height; ++y) {
+    for (size_t x = 0; x < s.width; ++x) {
+      const float u = static_cast<float>(x) - sx;
+      const float v = static_cast<float>(y) - sy;
+      const float value = std::sin(u * 0.35f) * std::cos(v * 0.27f) + 0.01f * u;
+      for (size_t c = 0; c < s.channels; ++c) f[(y * s.width + x) * s.channels + c] = value;
+    }
+  }
+  return f;
+}
+
+double mean_abs_error(const minfi::Frame& a, const minfi::Frame& b, const FrameShape& s,
+                      size_t margin) {
+  double sum = 0.0;
+  size_t n = 0;
+  for (size_t y = margin; y + margin < s.height; ++y) {
+    for (size_t i = margin * s.channels; i + margin * s.channels < s.row_elems(); ++i) {
+      sum += std::fabs(a[y * s.row_elems() + i] - b[y * s.row_elems() + i]);
+      ++n;
+    }
+  }
+  return sum / static_cast<double>(n);
+}
+}  // namespace
+
+TEST(Motion, DetectsGlobalShift) {
+  const FrameShape shape{64, 48, 1};
+  auto a = pattern(shape, 0.f, 0.f), b = pattern(shape, 3.f, -2.f);
+  MotionField field = minfi::estimate_motion(a, b, shape, MotionOptions{16, 4});
+  ASSERT_EQ(field.cols, 4u);
+  ASSERT_EQ(field.rows, 3u);
+  // Interior blocks see the full shift; border blocks may be clipped by the search window.
+  const auto& v = field.view().at(1, 1);
+  EXPECT_EQ(v.dx, 3 * minfi::kMotionScale);
+  EXPECT_EQ(v.dy, -2 * minfi::kMotionScale);
+}
+
+TEST(Motion, StaticFrameHasZeroField) {
+  const FrameShape shape{20, 20, 3};
+  auto a = pattern(shape, 0.f, 0.f);
+  MotionField field = minfi::estimate_motion(a, a, shape, MotionOptions{8, 3});
+  for (const auto& v : field.vectors) EXPECT_EQ(v, minfi::MotionVector{});
+  auto out = minfi::interpolate_motion(a, a, shape, field.view(), 0.3f);
+  for (size_t i = 0; i < a.size(); ++i) EXPECT_NEAR(out[i], a[i], 1e-6f);
+}
+
+TEST(Motion, CompensatedMidpointBeatsLinearBlend) {
+  const FrameShape shape{64, 64, 3};
+  auto a = pattern(shape, 0.f, 0.f), b = pattern(shape, 4.f, 2.f);
+  auto truth = pattern(shape, 2.f, 1.f);
+  MotionField field = minfi::estimate_motion(a, b, shape, MotionOptions{16, 6});
+  auto mc = minfi::interpolate_motion(a, b, shape, field.view(), 0.5f,
+                                      minfi::MotionSampling::Smooth);
+  auto linear = minfi::interpolate(a, b, 0.5f);
+  // Blocks along the right / bottom edges cannot find their match inside the frame; compare
+  // the interior only.
+  EXPECT_LT(mean_abs_error(mc, truth, shape, 16),
+            0.25 * mean_abs_error(linear, truth, shape, 16));
+  auto blocky = minfi::interpolate_motion(a, b, shape, field.view(), 0.5f);
+  EXPECT_LT(mean_abs_error(blocky, truth, shape, 16), 1e-4);
+}
+
+TEST(Motion, RejectsMismatchedInput) {
+  const FrameShape shape{8, 8, 1};
+  minfi::Frame a(64), b(63);
+  EXPECT_THROW(minfi::estimate_motion(a, b, shape), std::invalid_argument);
+  EXPECT_THROW(minfi::estimate_motion(a, a, shape, MotionOptions{0, 2}), std::invalid_argument);
+  MotionField small = minfi::estimate_motion(a, a, FrameShape{4, 4, 4}, MotionOptions{4, 1});
+  minfi::Frame out(64);
+  EXPECT_THROW(minfi::interpolate_motion_into(a, a, shape, small.view(), 0.5f, out),
+               std::invalid_argument);
+}
+
+TEST(MotionCache, ReusesFieldAcrossT) {
+  const FrameShape shape{32, 32, 1};
+  auto a = pattern(shape, 0.f, 0.f), b = pattern(shape, 1.f, 0.f);
+  MotionCache cache;
+  const FramePairKey key{minfi::frame_id(a), minfi::frame_id(b)};
+  auto first = cache.get_or_estimate(key, a, b, shape);
+  for (float t : {0.25f, 0.5f, 0.75f}) {
+    auto field = cache.get_or_estimate(key, a, b, shape);
+    EXPECT_EQ(field, first);
+    (void) minfi::interpolate_motion(a, b, shape, field->view(), t);
+  }
+  auto s = cache.stats();
+  EXPECT_EQ(s.misses, 1u);
+  EXPECT_EQ(s.hits, 3u);
+  EXPECT_EQ(s.entries, 1u);
+  EXPECT_EQ(s.bytes, first->bytes());
+
+  // Different estimation options are a different result.
+  EXPECT_EQ(cache.find(key, MotionOptions{8, 8}), nullptr);
+  EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+TEST(MotionCache, EvictsLeastRecentlyUsedUnderBudget) {
+  MotionField f;
+  f.cols = f.rows = 4;
+  f.block = 16;
+  f.vectors.resize(16);  // 64 bytes
+  MotionCache cache(3 * f.bytes());
+  cache.insert({1, 2}, f);
+  cache.insert({2, 3}, f);
+  cache.insert({3, 4}, f);
+  ASSERT_NE(cache.find({1, 2}), nullptr);  // {2, 3} is now least recent
+  auto held = cache.find({2, 3});
+  cache.insert({4, 5}, f);
+  EXPECT_EQ(cache.find({3, 4}), nullptr);
+  EXPECT_NE(cache.find({1, 2}), nullptr);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+  EXPECT_EQ(cache.stats().bytes, 3 * f.bytes());
+
+  cache.set_budget(f.bytes());
+  EXPECT_EQ(cache.stats().entries, 1u);
+  EXPECT_EQ(held->vectors.size(), 16u);  // evicted fields stay valid for holders
+
+  MotionField big = f;
+  big.vectors.resize(64);
+  auto kept = cache.insert({9, 9}, big);
+  EXPECT_EQ(kept->bytes(), big.bytes());
+  EXPECT_EQ(cache.find({9, 9}), nullptr);  // larger than the whole budget: not retained
+  cache.clear();
+  EXPECT_EQ(cache.stats().bytes, 0u);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+#include "minfi/out_of_core.hpp"
+
+using minfi::OutOfCoreInput;
+using minfi::OutOfCoreOptions;
+
+namespace {
+
+std::string temp_path(const std::string& tag) {
+  return ::testing::TempDir() + "minfi-ooc-" + tag + "-" + std::to_string(::getpid());
+}
+
+std::vector<float> values(std::size_t n, float scale) {
+  std::vector<float> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<float>((i * 7) % 251) * scale;
+  return v;
+}
+
+std::string write_floats(const std::string& tag, const std::vector<float>& v,
+                         std::size_t header = 0) {
+  const std::string path = temp_path(tag);
+  std::ofstream out(path, std::ios::binary);
+  const std::string pad(header, 'h');
+  out.write(pad.data(), static_cast<std::streamsize>(pad.size()));
+  out.write(reinterpret_cast<const char*>(v.data()),
+            static_cast<std::streamsize>(v.size() * sizeof(float)));
+  return path;
+}
+
+std::vector<float> read_floats(const std::string& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  std::vector<float> v(static_cast<std::size_t>(in.tellg()) / sizeof(float));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(v.size() * 4));
+  return v;
+}
+
+}  // namespace
+
+// 100003 floats is not a whole number of chunks at any 4 KiB-aligned chunk size.
+TEST(OutOfCore, MatchesInMemoryInterpolateInBothInputModes) {
+  const std::vector<float> a = values(100003, 0.01f), b = values(100003, -0.02f);
+  const std::string pa = write_floats("a", a), pb = write_floats("b", b);
+  const std::string po = temp_path("out");
+  std::vector<float> expected(a.size());
+  minfi::interpolate_into<float>(a, b, expected, 0.3f);
+
+  for (const OutOfCoreInput input : {OutOfCoreInput::Reader, OutOfCoreInput::Mmap}) {
+    OutOfCoreOptions o;
+    o.memory_limit = 64 << 10;
+    o.input = input;
+    const auto stats = minfi::interpolate_files(pa, pb, po, 0.3f, o);
+    EXPECT_EQ(read_floats(po), expected) << static_cast<int>(input);
+    EXPECT_LE(stats.buffer_bytes, o.memory_limit);
+    EXPECT_EQ(stats.bytes, a.size() * sizeof(float));
+    EXPECT_EQ(stats.chunks, (stats.bytes + stats.chunk_bytes - 1) / stats.chunk_bytes);
+    EXPECT_GT(stats.chunks, 1u);
+  }
+  std::remove(pa.c_str());
+  std::remove(pb.c_str());
+  std::remove(po.c_str());
+}
+
+TEST(OutOfCore, SkipsInputHeaderAndTruncatesOutput) {
+  const std::vector<float> a = values(5000, 1.0f), b = values(5000, 2.0f);
+  const std::string pa = write_floats("ha", a, 64), pb = write_floats("hb", b, 64);
+  const std::string po = write_floats("hout", values(20000, 1.0f));
+  std::vector<float> expected(a.size());
+  minfi::interpolate_into<float>(a, b, expected, 0.75f);
+
+  OutOfCoreOptions o;
+  o.input_offset = 64;
+  o.chunk_bytes = 4096;
+  minfi::interpolate_files(pa, pb, po, 0.75f, o);
+  EXPECT_EQ(read_floats(po), expected);
+  std::remove(pa.c_str());
+  std::remove(pb.c_str());
+  std::remove(po.c_str());
+}
+
+TEST(OutOfCore, RejectsMismatchesAndTinyLimits) {
+  const std::string pa = write_floats("ra", values(1000, 1.0f));
+  const std::string pb = write_floats("rb", values(999, 1.0f));
+  const std::string po = temp_path("rout");
+  EXPECT_THROW(minfi::interpolate_files(pa, pb, po, 0.5f), std::invalid_argument);
+
+  OutOfCoreOptions o;
+  o.memory_limit = 4096;
+  EXPECT_THROW(minfi::interpolate_files(pa, pa, po, 0.5f, o), std::invalid_argument);
+  o = {};
+  o.chunk_bytes = 1000;
+  EXPECT_THROW(minfi::interpolate_files(pa, pa, po, 0.5f, o), std::invalid_argument);
+  o = {};
+  o.input_offset = 2;
+  o.input = OutOfCoreInput::Mmap;
+  EXPECT_THROW(minfi::interpolate_files(pa, pa, po, 0.5f, o), std::invalid_argument);
+  EXPECT_THROW(minfi::interpolate_files(pa, temp_path("missing"), po, 0.5f), std::runtime_error);
+  std::remove(pa.c_str());
+  std::remove(pb.c_str());
+  std::remove(po.c_str());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+#include "minfi/packed.hpp"
+
+using minfi::MutablePackedImageView;
+using minfi::PackedImageView;
+using minfi::PixelFormat;
+
+namespace {
+std::vector<std::uint8_t> pattern(size_t n, int seed) {
+  std::vector<std::uint8_t> v(n);
+  for (size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint8_t>((i * 37 + seed * 101) & 0xff);
+  return v;
+}
+}  // namespace
+
+TEST(Packed, Rgb8MatchesU8Kernel) {
+  const size_t w = 7, h = 5;
+  auto a = pattern(w * h * 3, 1), b = pattern(w * h * 3, 2);
+  auto fused = minfi::interpolate_packed({a.data(), w, h, PixelFormat::Rgb8},
+                                         {b.data(), w, h, PixelFormat::Rgb8}, PixelFormat::Rgb8,
+                                         0.3f);
+  EXPECT_EQ(fused, (minfi::interpolate<std::uint8_t, 3>(a, b, 0.3f)));
+}
+
+TEST(Packed, Rgb8ToRgba8PadsOpaqueAlpha) {
+  const size_t w = 4, h = 3;
+  auto a = pattern(w * h * 3, 3), b = pattern(w * h * 3, 4);
+  auto ref = minfi::interpolate<std::uint8_t, 3>(a, b, 0.75f);
+  auto out = minfi::interpolate_packed({a.data(), w, h, PixelFormat::Rgb8},
+                                       {b.data(), w, h, PixelFormat::Rgb8}, PixelFormat::Rgba8,
+                                       0.75f);
+  ASSERT_EQ(out.size(), w * h * 4);
+  for (size_t p = 0; p < w * h; ++p) {
+    for (size_t c = 0; c < 3; ++c) EXPECT_EQ(out[p * 4 + c], ref[p * 3 + c]);
+    EXPECT_EQ(out[p * 4 + 3], 255);
+  }
+}
+
+TEST(Packed, Rgba8ToRgb8WithStridesAndBands) {
+  const size_t w = 3, h = 4, in_stride = 16, out_stride = 12;
+  auto a = pattern(h * in_stride, 5), b = pattern(h * in_stride, 6);
+  const PackedImageView va{a.data(), w, h, PixelFormat::Rgba8, in_stride};
+  const PackedImageView vb{b.data(), w, h, PixelFormat::Rgba8, in_stride};
+
+  // Two rows starting at y = 1 into a band buffer with padded rows.
+  std::vector<std::uint8_t> band(2 * out_stride, 0xee);
+  minfi::interpolate_packed_rows(va, vb, {band.data(), w, 2, PixelFormat::Rgb8, out_stride}, 0.5f,
+                                 1, 2);
+  for (size_t r = 0; r < 2; ++r) {
+    for (size_t x = 0; x < w; ++x) {
+      for (size_t c = 0; c < 3; ++c) {
+        const size_t src = (1 + r) * in_stride + x * 4 + c;
+        EXPECT_EQ(band[r * out_stride + x * 3 + c],
+                  minfi::detail::blend<std::uint8_t>(a[src], b[src], 0.5f));
+      }
+    }
+    for (size_t pad = w * 3; pad < out_stride; ++pad) EXPECT_EQ(band[r * out_stride + pad], 0xee);
+  }
+  EXPECT_THROW(minfi::interpolate_packed_rows(va, vb, {band.data(), w, 2, PixelFormat::Rgb8}, 0.5f,
+                                              3, 2),
+               std::out_of_range);
+}
+
+TEST(Packed, RejectsMismatchedInputs) {
+  std::vector<std::uint8_t> a(48), b(48), out(64);
+  const PackedImageView rgb{a.data(), 4, 4, PixelFormat::Rgb8};
+  const PackedImageView rgba{b.data(), 3, 4, PixelFormat::Rgba8};
+  const MutablePackedImageView dst{out.data(), 4, 4, PixelFormat::Rgba8};
+  EXPECT_THROW(minfi::interpolate_packed_into(rgb, rgba, dst, 0.5f), std::invalid_argument);
+  const PackedImageView narrow{a.data(), 4, 4, PixelFormat::Rgb8, 8};
+  EXPECT_THROW(minfi::interpolate_packed_into(narrow, narrow, dst, 0.5f), std::invalid_argument);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "minfi/perf_counters.hpp"
+
+using minfi::PerfEvent;
+using minfi::PerfSample;
+using minfi::PerfStats;
+
+namespace {
+
+PerfSample sample(std::uint64_t base, std::uint64_t time_ns, bool llc_valid = true) {
+  PerfSample s;
+  for (std::size_t i = 0; i < minfi::kPerfEventCount; ++i) {
+    s.values[i] = base * (i + 1);
+    s.valid[i] = true;
+  }
+  s.valid[static_cast<std::size_t>(PerfEvent::LlcMisses)] = llc_valid;
+  s.time_ns = time_ns;
+  return s;
+}
+
+}  // namespace
+
+TEST(PerfStats, AccumulatesDeltasAndRatios) {
+  PerfStats stats;
+  stats.add(sample(100, 1000), sample(300, 1500));  // cycles +200, instructions +400
+  stats.add(sample(300, 2000), sample(400, 2600));  // cycles +100, instructions +200
+  EXPECT_EQ(stats.calls(), 2u);
+  EXPECT_EQ(stats.total(PerfEvent::Cycles), 300u);
+  EXPECT_EQ(stats.total(PerfEvent::Instructions), 600u);
+  EXPECT_EQ(stats.time_ns(), 1100u);
+  EXPECT_DOUBLE_EQ(stats.per_call(PerfEvent::Cycles), 150.0);
+  EXPECT_DOUBLE_EQ(stats.per_unit(PerfEvent::Cycles, 50.0), 3.0);
+  EXPECT_DOUBLE_EQ(stats.ipc(), 2.0);
+
+  // An event missing from any call is reported as unavailable for the whole zone.
+  stats.add(sample(0, 0, false), sample(10, 10, false));
+  EXPECT_FALSE(stats.has(PerfEvent::LlcMisses));
+  EXPECT_DOUBLE_EQ(stats.per_call(PerfEvent::LlcMisses), 0.0);
+  EXPECT_TRUE(stats.has(PerfEvent::PageFaults));
+
+  std::ostringstream os;
+  stats.report(os, 1000, 12000);
+  EXPECT_NE(os.str().find("unavailable: llc-misses"), std::string::npos) << os.str();
+  EXPECT_NE(os.str().find("cycles"), std::string::npos);
+
+  stats.reset();
+  EXPECT_EQ(stats.calls(), 0u);
+  EXPECT_FALSE(stats.has(PerfEvent::Cycles));
+}
+
+// Counters may be missing entirely (containers, VMs without a PMU); everything must still
+// work and report only what was opened.
+TEST(PerfCounters, ZonesDegradeGracefully) {
+  const minfi::PerfCounters counters;
+  PerfStats stats;
+  std::vector<float> touched;
+  {
+    minfi::PerfZone zone(counters, stats);
+    touched.assign(1 << 20, 1.0f);  // fresh pages fault in
+  }
+  EXPECT_EQ(stats.calls(), 1u);
+  for (std::size_t i = 0; i < minfi::kPerfEventCount; ++i) {
+    const auto e = static_cast<PerfEvent>(i);
+    EXPECT_EQ(stats.has(e), counters.available(e)) << minfi::to_string(e);
+  }
+  if (counters.available(PerfEvent::Instructions)) {
+    EXPECT_GT(stats.total(PerfEvent::Instructions), touched.size() / 8);
+  }
+  if (counters.available(PerfEvent::PageFaults)) {
+    EXPECT_GT(stats.total(PerfEvent::PageFaults), 0u);
+  }
+  std::ostringstream os;
+  stats.report(os, static_cast<double>(touched.size()), 4.0 * touched.size());
+  SUCCEED() << os.str();
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "minfi/present.hpp"
+
+using namespace std::chrono_literals;
+using minfi::FrameMailbox;
+using minfi::Presenter;
+using minfi::PresentSink;
+
+namespace {
+
+// Records the first byte of every frame it is given; optionally slow, like a vsync wait.
+class RecordingSink : public PresentSink {
+ public:
+  explicit RecordingSink(std::chrono::milliseconds delay = 0ms) : delay_(delay) {}
+
+  void present(std::span<const std::uint8_t> frame) override {
+    std::this_thread::sleep_for(delay_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    seen_.push_back(frame[0]);
+  }
+
+  std::vector<std::uint8_t> seen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seen_;
+  }
+
+ private:
+  std::chrono::milliseconds delay_;
+  std::mutex mutex_;
+  std::vector<std::uint8_t> seen_;
+};
+
+}  // namespace
+
+TEST(FrameMailbox, TakeReturnsNewestAndCountsDrops) {
+  FrameMailbox box(16);
+  EXPECT_FALSE(box.take(0ns).has_value());
+  for (std::uint8_t v : {1, 2, 3}) {
+    box.back()[0] = v;
+    box.publish();
+  }
+  auto f = box.take(0ns);
+  ASSERT_TRUE(f.has_value());
+  EXPECT_EQ((*f)[0], 3);
+  EXPECT_EQ(f->size(), 16u);
+  box.done();
+  EXPECT_FALSE(box.take(0ns).has_value());  // nothing newer
+  const auto st = box.stats();
+  EXPECT_EQ(st.published, 3u);
+  EXPECT_EQ(st.presented, 1u);
+  EXPECT_EQ(st.dropped, 2u);
+  EXPECT_TRUE(box.wait_presented(0ns));
+}
+
+TEST(FrameMailbox, ProducerBufferNeverAliasesTheTakenFrame) {
+  FrameMailbox box(4);
+  box.back()[0] = 7;
+  box.publish();
+  auto f = box.take(0ns);
+  ASSERT_TRUE(f.has_value());
+  // The consumer holds `f` while the producer keeps publishing.
+  for (std::uint8_t v = 10; v < 20; ++v) {
+    EXPECT_NE(box.back().data(), f->data());
+    box.back()[0] = v;
+    box.publish();
+  }
+  EXPECT_EQ((*f)[0], 7);
+  EXPECT_EQ((*box.take(0ns))[0], 19);
+}
+
+TEST(FrameMailbox, CloseWakesWaitingConsumer) {
+  FrameMailbox box(4);
+  std::thread t([&] {
+    std::this_thread::sleep_for(5ms);
+    box.close();
+  });
+  EXPECT_FALSE(box.take(10s).has_value());
+  EXPECT_TRUE(box.closed());
+  t.join();
+  EXPECT_THROW(FrameMailbox(0), std::invalid_argument);
+}
+
+TEST(Presenter, PresentsInOrderAndFlushes) {
+  RecordingSink sink;
+  Presenter presenter(sink, 8);
+  for (std::uint8_t v = 1; v <= 5; ++v) {
+    presenter.back()[0] = v;
+    presenter.publish();
+    ASSERT_TRUE(presenter.flush(1s));
+  }
+  EXPECT_EQ(sink.seen(), (std::vector<std::uint8_t>{1, 2, 3, 4, 5}));
+  const auto st = presenter.stats();
+  EXPECT_EQ(st.presented, 5u);
+  EXPECT_EQ(st.dropped, 0u);
+}
+
+TEST(Presenter, SlowSinkDoesNotThrottleProducerAndDropsStaleFrames) {
+  RecordingSink sink(10ms);
+  Presenter presenter(sink, 1 << 16);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 1; i <= 200; ++i) {
+    presenter.back()[0] = static_cast<std::uint8_t>(i);
+    presenter.publish();
+  }
+  // 200 publishes against a 10 ms sink: a synchronous present would take two seconds.
+  EXPECT_LT(std::chrono::steady_clock::now() - t0, 500ms);
+  ASSERT_TRUE(presenter.flush(2s));
+  const auto st = presenter.stats();
+  EXPECT_EQ(st.published, 200u);
+  EXPECT_EQ(st.presented + st.dropped, 200u);
+  EXPECT_GT(st.dropped, 150u);
+  // Presented frames are strictly increasing and the last one is the newest.
+  const auto seen = sink.seen();
+  ASSERT_FALSE(seen.empty());
+  EXPECT_EQ(seen.back(), 200);
+  for (std::size_t i = 1; i < seen.size(); ++i) EXPECT_LT(seen[i - 1], seen[i]);
+}
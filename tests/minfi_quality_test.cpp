@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "minfi/quality.hpp"
+
+using minfi::FrameShape;
+
+namespace {
+
+std::vector<float> pattern(const FrameShape& shape, float phase) {
+  std::vector<float> v(shape.elems());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v[i] = 0.5f + 0.4f * std::sin(static_cast<float>(i) * 0.37f + phase);
+  }
+  return v;
+}
+
+// Plain double-precision SSIM on one disjoint window covering the whole frame.
+double reference_global_ssim(const std::vector<float>& a, const std::vector<float>& b) {
+  const double n = static_cast<double>(a.size());
+  double ma = 0, mb = 0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ma += a[i];
+    mb += b[i];
+  }
+  ma /= n;
+  mb /= n;
+  double va = 0, vb = 0, cov = 0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    va += (a[i] - ma) * (a[i] - ma);
+    vb += (b[i] - mb) * (b[i] - mb);
+    cov += (a[i] - ma) * (b[i] - mb);
+  }
+  va /= n;
+  vb /= n;
+  cov /= n;
+  const double c1 = 0.01 * 0.01, c2 = 0.03 * 0.03;
+  return ((2 * ma * mb + c1) * (2 * cov + c2)) / ((ma * ma + mb * mb + c1) * (va + vb + c2));
+}
+
+}  // namespace
+
+TEST(Quality, PsnrMatchesClosedForm) {
+  // Odd length exercises the scalar tail after the SIMD lanes.
+  const std::vector<float> a(10007, 0.25f);
+  std::vector<float> b = a;
+  EXPECT_EQ(minfi::psnr(a, b), std::numeric_limits<double>::infinity());
+  for (float& v : b) v += 0.1f;
+  EXPECT_NEAR(minfi::mse(a, b), 0.01, 1e-6);
+  EXPECT_NEAR(minfi::psnr(a, b), 20.0, 1e-3);
+  EXPECT_NEAR(minfi::psnr(a, b, 255.0f), 20.0 + 20.0 * std::log10(255.0), 1e-3);
+  EXPECT_THROW(minfi::psnr(a, std::vector<float>(3)), std::invalid_argument);
+  EXPECT_THROW(minfi::psnr(a, b, 0.0f), std::invalid_argument);
+}
+
+TEST(Quality, SsimIdentityAndOrdering) {
+  const FrameShape shape{37, 23, 3};
+  const std::vector<float> a = pattern(shape, 0.0f);
+  EXPECT_NEAR(minfi::ssim(a, a, shape), 1.0, 1e-6);
+
+  const std::vector<float> near = pattern(shape, 0.1f);
+  const std::vector<float> far = pattern(shape, 1.5f);
+  const double s_near = minfi::ssim(a, near, shape);
+  const double s_far = minfi::ssim(a, far, shape);
+  EXPECT_LT(s_near, 1.0);
+  EXPECT_GT(s_near, s_far);
+  EXPECT_NEAR(minfi::ssim(near, a, shape), s_near, 1e-9);  // symmetric
+}
+
+TEST(Quality, SsimMatchesReferenceOnSingleWindow) {
+  const FrameShape shape{13, 6, 1};
+  const std::vector<float> a = pattern(shape, 0.0f), b = pattern(shape, 0.7f);
+  minfi::SsimOptions o;
+  o.window = 64;  // clamps to the whole frame
+  EXPECT_NEAR(minfi::ssim(a, b, shape, o), reference_global_ssim(a, b), 1e-5);
+}
+
+TEST(Quality, SsimRejectsBadInput) {
+  const FrameShape shape{8, 8, 1};
+  const std::vector<float> a(64, 0.5f);
+  EXPECT_THROW(minfi::ssim(a, std::vector<float>(63), shape), std::invalid_argument);
+  EXPECT_THROW(minfi::ssim(a, a, FrameShape{8, 4, 1}), std::invalid_argument);
+  minfi::SsimOptions o;
+  o.stride = 0;
+  EXPECT_THROW(minfi::ssim(a, a, shape, o), std::invalid_argument);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+#include "minfi/shm_ring.hpp"
+
+using minfi::ShmFrameRing;
+
+namespace {
+std::string unique_name(const char* tag) {
+  return std::string("minfi-test-") + tag + "-" + std::to_string(::getpid());
+}
+}  // namespace
+
+TEST(ShmRing, CapacityAndOrdering) {
+  auto ring = ShmFrameRing::create(unique_name("order"), 3, 4);
+  EXPECT_EQ(ring.slots(), 4u);  // rounded up to a power of two
+  for (int f = 0; f < 4; ++f) {
+    auto slot = ring.try_acquire_write();
+    ASSERT_EQ(slot.size(), 4u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(slot.data()) % 64, 0u);
+    slot[0] = static_cast<float>(f);
+    ring.publish(100 + f);
+  }
+  EXPECT_TRUE(ring.try_acquire_write().empty());
+  EXPECT_TRUE(ring.acquire_write(std::chrono::milliseconds(1)).empty());
+  ASSERT_EQ(ring.readable(), 4u);
+  EXPECT_FLOAT_EQ(ring.read(2)[0], 2.f);
+  EXPECT_EQ(ring.meta(3).timestamp_ns, 103);
+  ring.release(2);
+  EXPECT_FLOAT_EQ(ring.read(0)[0], 2.f);
+  EXPECT_FALSE(ring.try_acquire_write().empty());
+}
+
+TEST(ShmRing, SecondMappingSeesFramesAndInterpolatesInPlace) {
+  const std::string name = unique_name("pair");
+  auto producer = ShmFrameRing::create(name, 4, 3);
+  auto consumer = ShmFrameRing::open(name);
+  EXPECT_EQ(consumer.frame_elems(), 3u);
+  EXPECT_FALSE(consumer.wait_readable(2, std::chrono::milliseconds(1)));
+
+  std::thread t([&] {
+    for (float v : {0.f, 2.f, 4.f}) {
+      auto slot = producer.acquire_write();
+      std::fill(slot.begin(), slot.end(), v);
+      producer.publish();
+    }
+  });
+  std::vector<float> out(3);
+  std::vector<float> mids;
+  for (int pair = 0; pair < 2; ++pair) {
+    ASSERT_TRUE(consumer.wait_readable(2, std::chrono::milliseconds(2000)));
+    minfi::interpolate_into<float>(consumer.read(0), consumer.read(1), out, 0.5f);
+    mids.push_back(out[0]);
+    consumer.release(1);
+  }
+  t.join();
+  EXPECT_EQ(mids, (std::vector<float>{1.f, 3.f}));
+}
+
+TEST(ShmRing, ConsumerCannotPassTheProducer) {
+  auto ring = ShmFrameRing::create(unique_name("overrelease"), 4, 8);
+  ring.try_acquire_write()[0] = 1.f;
+  ring.publish(0);
+  EXPECT_THROW(ring.read(1), std::out_of_range);
+  EXPECT_THROW(ring.meta(1), std::out_of_range);
+  EXPECT_THROW(ring.release(2), std::invalid_argument);
+  EXPECT_EQ(ring.readable(), 1u);
+  ring.release(1);
+  EXPECT_EQ(ring.readable(), 0u);
+  EXPECT_FALSE(ring.try_acquire_write().empty());
+}
+
+TEST(ShmRing, OpenMissingThrows) {
+  EXPECT_THROW(ShmFrameRing::open(unique_name("missing")), std::runtime_error);
+}
+
+TEST(ShmRing, OpenRejectsNonPowerOfTwoSlotCount) {
+  const std::string name = unique_name("slots");
+  const auto owner = ShmFrameRing::create(name, 4, 16);
+  // Overwrite the header's slot count (after the 8-byte magic and 4-byte version).
+  const int fd = ::shm_open(("/" + name).c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  std::uint32_t slots = 3;
+  ASSERT_EQ(::pwrite(fd, &slots, sizeof(slots), 12), static_cast<ssize_t>(sizeof(slots)));
+  EXPECT_THROW(ShmFrameRing::open(name), std::runtime_error);
+  slots = 0;
+  ASSERT_EQ(::pwrite(fd, &slots, sizeof(slots), 12), static_cast<ssize_t>(sizeof(slots)));
+  EXPECT_THROW(ShmFrameRing::open(name), std::runtime_error);
+  ::close(fd);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "minfi/interpolate.hpp"
+#include "minfi/kernels.hpp"
+#include "minfi/tuning.hpp"
+
+using minfi::KernelVariant;
+using minfi::TuningConfig;
+using minfi::TuningEntry;
+
+namespace {
+
+std::vector<float> pattern(std::size_t n, float scale) {
+  std::vector<float> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<float>((i * 37) % 101) * scale;
+  return v;
+}
+
+std::filesystem::path temp_path(const char* name) {
+  return std::filesystem::temp_directory_path() / name;
+}
+
+// Restores an environment variable (or its absence) when the test ends.
+class ScopedEnv {
+ public:
+  explicit ScopedEnv(const char* name) : name_(name) {
+    if (const char* value = std::getenv(name)) saved_ = value;
+  }
+  ~ScopedEnv() {
+    if (saved_) {
+      ::setenv(name_, saved_->c_str(), 1);
+    } else {
+      ::unsetenv(name_);
+    }
+  }
+  ScopedEnv(const ScopedEnv&) = delete;
+  ScopedEnv& operator=(const ScopedEnv&) = delete;
+
+ private:
+  const char* name_;
+  std::optional<std::string> saved_;
+};
+
+}  // namespace
+
+TEST(Tuning, SelectPicksLargestMatchingEntry) {
+  TuningConfig config;
+  config.entries = {{0, 0, 1, KernelVariant::Flat},
+                    {1000, 256, 2, KernelVariant::Flat},
+                    {100000, 4096, 4, KernelVariant::Streaming}};
+  EXPECT_EQ(config.select(10).threads, 1u);
+  EXPECT_EQ(config.select(1000).threads, 2u);
+  EXPECT_EQ(config.select(99999).tile_elems, 256u);
+  EXPECT_EQ(config.select(1u << 30).kernel, KernelVariant::Streaming);
+
+  const TuningEntry fallback = TuningConfig{}.select(123);
+  EXPECT_EQ(fallback.threads, 1u);
+  EXPECT_EQ(fallback.kernel, KernelVariant::Flat);
+}
+
+TEST(Tuning, EveryConfigurationMatchesTheReferenceKernel) {
+  // Odd sizes and an offset output exercise tile tails and the unaligned streaming prologue.
+  for (const std::size_t n : std::vector<std::size_t>{1, 7, 1000, 65537}) {
+    const auto a = pattern(n, 0.01f);
+    const auto b = pattern(n, -0.02f);
+    std::vector<float> expected(n);
+    minfi::interpolate_into<float>(a, b, expected, 0.3f);
+    for (const KernelVariant kernel : {KernelVariant::Flat, KernelVariant::Streaming}) {
+      for (const std::size_t threads : {1u, 3u, 8u}) {
+        for (const std::size_t tile : {0u, 5u, 4096u}) {
+          std::vector<float> storage(n + 1, -1.0f);
+          std::span<float> out(storage.data() + 1, n);
+          minfi::interpolate_tuned_into(a, b, out, 0.3f, {0, tile, threads, kernel});
+          ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()))
+              << "n=" << n << " kernel=" << minfi::to_string(kernel) << " threads=" << threads
+              << " tile=" << tile;
+        }
+      }
+    }
+  }
+}
+
+TEST(Tuning, InPlaceAndSizeMismatch) {
+  auto a = pattern(5000, 1.0f);
+  const auto b = pattern(5000, 2.0f);
+  minfi::interpolate_tuned_into(a, b, a, 1.0f, {0, 100, 4, KernelVariant::Streaming});
+  EXPECT_EQ(a, b);
+
+  std::vector<float> small(10);
+  EXPECT_THROW(minfi::interpolate_tuned_into(a, b, small, 0.5f, {}), std::invalid_argument);
+}
+
+TEST(Tuning, SaveLoadRoundTrip) {
+  TuningConfig config;
+  config.entries = {{4096, 1024, 2, KernelVariant::Streaming}, {0, 0, 1, KernelVariant::Flat}};
+  const auto path = temp_path("minfi_tuning_roundtrip.conf");
+  minfi::save_tuning(config, path);
+  const TuningConfig loaded = minfi::load_tuning(path);
+  ASSERT_EQ(loaded.entries.size(), 2u);
+  EXPECT_EQ(loaded.entries[0], config.entries[1]);  // sorted by min_elems
+  EXPECT_EQ(loaded.entries[1], config.entries[0]);
+  std::filesystem::remove(path);
+}
+
+TEST(Tuning, LoadRejectsMalformedFiles) {
+  const auto path = temp_path("minfi_tuning_bad.conf");
+  const auto write = [&](const char* text) { std::ofstream(path) << text; };
+
+  write("minfi-tuning 2\n");
+  EXPECT_THROW(minfi::load_tuning(path), std::runtime_error);
+  write("minfi-tuning 1\n0 0 1 simd\n");
+  EXPECT_THROW(minfi::load_tuning(path), std::runtime_error);
+  write("minfi-tuning 1\n0 0 0 flat\n");
+  EXPECT_THROW(minfi::load_tuning(path), std::runtime_error);
+  write("minfi-tuning 1\n0 0 1 flat extra\n");
+  EXPECT_THROW(minfi::load_tuning(path), std::runtime_error);
+  write("# comment only\n\nminfi-tuning 1  # header\n  10 20 2 flat # entry\n");
+  EXPECT_EQ(minfi::load_tuning(path).entries.size(), 1u);
+  std::filesystem::remove(path);
+  EXPECT_THROW(minfi::load_tuning(path), std::runtime_error);
+}
+
+TEST(Tuning, DefaultPathHonoursEnvironment) {
+  const ScopedEnv file("MINFI_TUNING_FILE");
+  const ScopedEnv xdg("XDG_CONFIG_HOME");
+  ::setenv("MINFI_TUNING_FILE", "/tmp/explicit.conf", 1);
+  EXPECT_EQ(minfi::default_tuning_path(), std::filesystem::path("/tmp/explicit.conf"));
+  ::unsetenv("MINFI_TUNING_FILE");
+  ::setenv("XDG_CONFIG_HOME", "/tmp/xdg", 1);
+  EXPECT_EQ(minfi::default_tuning_path(), std::filesystem::path("/tmp/xdg/minfi/tuning.conf"));
+}
+
+TEST(Tuning, ActiveConfigDrivesInterpolate) {
+  const auto previous = minfi::active_tuning();
+  TuningConfig config;
+  config.entries = {{0, 0, 1, KernelVariant::Flat}, {64, 16, 4, KernelVariant::Streaming}};
+  minfi::set_active_tuning(config);
+  EXPECT_EQ(*minfi::active_tuning(), config);
+
+  const auto va = pattern(1000, 0.5f);
+  const auto vb = pattern(1000, 0.25f);
+  const minfi::Frame a(va.begin(), va.end()), b(vb.begin(), vb.end());
+  std::vector<float> expected(1000);
+  minfi::interpolate_into<float>(va, vb, expected, 0.6f);
+  const minfi::Frame out = minfi::interpolate(a, b, 0.6f);
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+  minfi::set_active_tuning(*previous);
+}
+
+TEST(Tuning, CalibrateProducesOneEntryPerSize) {
+  minfi::CalibrationOptions options;
+  options.frame_elems = {1u << 12, 1u << 8};
+  options.tile_elems = {0, 1024};
+  options.threads = {1, 2};
+  options.repeats = 1;
+  const TuningConfig config = minfi::calibrate(options);
+  ASSERT_EQ(config.entries.size(), 2u);
+  EXPECT_EQ(config.entries[0].min_elems, 0u);
+  EXPECT_EQ(config.entries[1].min_elems, 1024u);  // geometric mean of 256 and 4096
+  for (const TuningEntry& e : config.entries) {
+    EXPECT_GE(e.threads, 1u);
+    EXPECT_LE(e.threads, 2u);
+  }
+
+  options.repeats = 0;
+  EXPECT_THROW(minfi::calibrate(options), std::invalid_argument);
+}
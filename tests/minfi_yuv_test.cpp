@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "minfi/kernels.hpp"
+#include "minfi/yuv.hpp"
+
+using minfi::YuvLayout;
+
+namespace {
+std::vector<std::uint8_t> noise(size_t n, int seed) {
+  std::vector<std::uint8_t> v(n);
+  for (size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint8_t>((i * 73 + seed * 29) & 0xff);
+  return v;
+}
+
+// Packed frame whose planes hold a smooth pattern shifted by (sx, sy) luma pixels; chroma is
+// the same pattern at half resolution, so it moves by (sx / 2, sy / 2).
+std::vector<std::uint8_t> shifted(YuvLayout layout, size_t w, size_t h, float sx, float sy) {
+  std::vector<std::uint8_t> data(minfi::yuv420_frame_bytes(w, h));
+  auto f = minfi::yuv420_view(layout, data.data(), w, h);
+  const auto value = [](float x, float y, float phase) {
+    return static_cast<std::uint8_t>(
+        std::lround(128.f + 100.f * std::sin(x * 0.3f + phase) * std::cos(y * 0.25f)));
+  };
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) f.y[y * w + x] = value(x - sx, y - sy, 0.f);
+  }
+  for (size_t y = 0; y < f.chroma_height(); ++y) {
+    for (size_t x = 0; x < f.chroma_width(); ++x) {
+      const float cx = 2.f * x - sx, cy = 2.f * y - sy;
+      if (layout == YuvLayout::NV12) {
+        f.u[y * f.chroma_row_bytes() + 2 * x] = value(cx, cy, 1.f);
+        f.u[y * f.chroma_row_bytes() + 2 * x + 1] = value(cx, cy, 2.f);
+      } else {
+        f.u[y * f.chroma_width() + x] = value(cx, cy, 1.f);
+        f.v[y * f.chroma_width() + x] = value(cx, cy, 2.f);
+      }
+    }
+  }
+  return data;
+}
+}  // namespace
+
+TEST(Yuv, FrameSizeRoundsChromaUp) {
+  EXPECT_EQ(minfi::yuv420_frame_bytes(4, 2), 8u + 2u * 2u);
+  EXPECT_EQ(minfi::yuv420_frame_bytes(5, 3), 15u + 2u * 3u * 2u);
+  std::vector<std::uint8_t> buf(minfi::yuv420_frame_bytes(5, 3));
+  auto i420 = minfi::yuv420_view(YuvLayout::I420, buf.data(), 5, 3);
+  EXPECT_EQ(i420.u - buf.data(), 15);
+  EXPECT_EQ(i420.v - buf.data(), 21);
+  EXPECT_EQ(minfi::yuv420_view(YuvLayout::NV12, buf.data(), 5, 3).chroma_row_bytes(), 6u);
+}
+
+TEST(Yuv, LinearMatchesFlatU8Kernel) {
+  // Every plane is blended sample by sample, so for a packed frame the result equals the u8
+  // kernel over the whole buffer, in either layout.
+  for (auto layout : {YuvLayout::I420, YuvLayout::NV12}) {
+    const size_t bytes = minfi::yuv420_frame_bytes(7, 5);
+    auto a = noise(bytes, 1), b = noise(bytes, 2);
+    EXPECT_EQ(minfi::interpolate_yuv(layout, a, b, 7, 5, 0.4f),
+              minfi::interpolate<std::uint8_t>(a, b, 0.4f));
+  }
+}
+
+TEST(Yuv, StridedPlanes) {
+  const size_t w = 6, h = 4, ys = 8, uvs = 5;
+  std::vector<std::uint8_t> ya = noise(h * ys, 1), yb = noise(h * ys, 2), yo(h * ys, 0xee);
+  std::vector<std::uint8_t> ca = noise(2 * uvs * 2, 3), cb = noise(2 * uvs * 2, 4);
+  std::vector<std::uint8_t> co(2 * uvs * 2, 0xee);
+  const minfi::YuvImageView a{YuvLayout::I420, w, h, ya.data(), ca.data(), ca.data() + 2 * uvs,
+                              ys, uvs};
+  const minfi::YuvImageView b{YuvLayout::I420, w, h, yb.data(), cb.data(), cb.data() + 2 * uvs,
+                              ys, uvs};
+  const minfi::MutableYuvImageView out{YuvLayout::I420, w, h, yo.data(), co.data(),
+                                       co.data() + 2 * uvs, ys, uvs};
+  minfi::interpolate_yuv_into(a, b, out, 0.5f);
+  EXPECT_EQ(yo[ys + 5], minfi::detail::blend<std::uint8_t>(ya[ys + 5], yb[ys + 5], 0.5f));
+  EXPECT_EQ(yo[ys + 6], 0xee);  // stride padding untouched
+  EXPECT_EQ(co[uvs + 2], minfi::detail::blend<std::uint8_t>(ca[uvs + 2], cb[uvs + 2], 0.5f));
+  EXPECT_EQ(co[uvs + 3], 0xee);
+
+  const minfi::YuvImageView nv12{YuvLayout::NV12, w, h, ya.data(), ca.data(), nullptr, ys, uvs};
+  const minfi::MutableYuvImageView bad{YuvLayout::NV12, w, h, yo.data(), co.data(), nullptr, ys,
+                                       uvs};
+  EXPECT_THROW(minfi::interpolate_yuv_into(nv12, nv12, bad, 0.5f), std::invalid_argument);
+  EXPECT_THROW(minfi::interpolate_yuv_into(a, nv12, out, 0.5f), std::invalid_argument);
+}
+
+TEST(Yuv, MotionCompensatesLumaAndChroma) {
+  const size_t w = 64, h = 48;
+  for (auto layout : {YuvLayout::I420, YuvLayout::NV12}) {
+    auto a = shifted(layout, w, h, 0.f, 0.f), b = shifted(layout, w, h, 4.f, 2.f);
+    auto truth = shifted(layout, w, h, 2.f, 1.f);
+    const auto va = minfi::yuv420_view(layout, a.data(), w, h);
+    const auto vb = minfi::yuv420_view(layout, b.data(), w, h);
+    minfi::MotionField field = minfi::estimate_motion_yuv(va, vb, minfi::MotionOptions{16, 6});
+    EXPECT_EQ(field.view().at(1, 1).dx, 4 * minfi::kMotionScale);
+    EXPECT_EQ(field.view().at(1, 1).dy, 2 * minfi::kMotionScale);
+
+    std::vector<std::uint8_t> out(a.size());
+    minfi::interpolate_yuv_motion_into(va, vb, minfi::yuv420_view(layout, out.data(), w, h),
+                                       field.view(), 0.5f);
+    auto linear = minfi::interpolate_yuv(layout, a, b, w, h, 0.5f);
+    // Compare an interior region of every plane (edge blocks cannot find their match).
+    const auto vo = minfi::yuv420_view(layout, out.data(), w, h);
+    const auto vt = minfi::yuv420_view(layout, truth.data(), w, h);
+    const auto vl = minfi::yuv420_view(layout, linear.data(), w, h);
+    int mc_err = 0, lin_err = 0;
+    for (size_t y = 16; y < 32; ++y) {
+      for (size_t x = 16; x < 48; ++x) {
+        mc_err = std::max(mc_err, std::abs(vo.y[y * w + x] - vt.y[y * w + x]));
+        lin_err = std::max(lin_err, std::abs(vl.y[y * w + x] - vt.y[y * w + x]));
+      }
+    }
+    const size_t cr = vo.chroma_row_bytes();
+    for (size_t y = 8; y < 16; ++y) {
+      for (size_t x = 8 * (cr / 32); x < 24 * (cr / 32); ++x) {
+        mc_err = std::max(mc_err, std::abs(vo.u[y * cr + x] - vt.u[y * cr + x]));
+        lin_err = std::max(lin_err, std::abs(vl.u[y * cr + x] - vt.u[y * cr + x]));
+      }
+    }
+    EXPECT_LE(mc_err, 3);  // half-sample chroma positions are bilinearly resampled
+    EXPECT_GT(lin_err, 20);
+  }
+}